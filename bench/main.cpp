@@ -0,0 +1,47 @@
+#define TDE2_DEFINE_ENTRY_POINT
+#include <TDEngine2.h>
+#include "../include/bench/CBenchmarkEngineListener.h"
+
+
+extern std::string GetProjectSettingsFilePath() { return "ArkanoidBench.project"; }
+
+extern std::unique_ptr<TDEngine2::IEngineListener> GetEngineListener() { return std::make_unique<CBenchmarkEngineListener>(Game::GetBenchmarkSettingsFromProgramOptions()); }
+
+extern TDEngine2::E_RESULT_CODE ParseOptions(int argc, const char** argv)
+{
+	using namespace TDEngine2;
+
+	auto pProgramOptions = CProgramOptions::Get();
+
+	const Game::TBenchmarkSettings defaultSettings;
+
+	auto addArgument = [&pProgramOptions](C8 shortName, const std::string& name, const std::string& info, TProgramOptionsArgument::E_VALUE_TYPE type, auto&& defaultValue)
+	{
+		TProgramOptionsArgument argument;
+		argument.mSingleCharCommand = shortName;
+		argument.mCommand = name;
+		argument.mCommandInfo = info;
+		argument.mValueType = type;
+		argument.mValue = defaultValue;
+
+		return pProgramOptions->AddArgument(argument);
+	};
+
+	E_RESULT_CODE result = RC_OK;
+
+	result = result | addArgument('l', "level", "An index of a level within GameLevelsCollection.asset", TProgramOptionsArgument::E_VALUE_TYPE::INTEGER, static_cast<I32>(defaultSettings.mLevelIndex));
+	result = result | addArgument('n', "frames", "A number of measured frames", TProgramOptionsArgument::E_VALUE_TYPE::INTEGER, static_cast<I32>(defaultSettings.mFramesCount));
+	result = result | addArgument('w', "warmup", "A number of frames which are skipped before measurements", TProgramOptionsArgument::E_VALUE_TYPE::INTEGER, static_cast<I32>(defaultSettings.mWarmupFramesCount));
+	result = result | addArgument('t', "dt", "A fixed delta time which is passed into the game systems", TProgramOptionsArgument::E_VALUE_TYPE::FLOAT, defaultSettings.mFixedDeltaTime);
+	result = result | addArgument('o', "output", "A path to JSON report, stdout is used if it's not specified", TProgramOptionsArgument::E_VALUE_TYPE::STRING, defaultSettings.mOutputFilePath);
+	result = result | addArgument('s', "sequential", "If it's 1 game systems are updated one by one instead of concurrently", TProgramOptionsArgument::E_VALUE_TYPE::INTEGER, static_cast<I32>(defaultSettings.mIsSequentialUpdate));
+	result = result | addArgument('a', "alloc-trace", "A path to an allocation trace of components, it's replayed if the file exists, otherwise the recorded one is saved there", TProgramOptionsArgument::E_VALUE_TYPE::STRING, defaultSettings.mAllocationTraceFilePath);
+	result = result | addArgument('i', "alloc-iterations", "A number of the trace's replays per allocator, 0 disables the allocators benchmark", TProgramOptionsArgument::E_VALUE_TYPE::INTEGER, static_cast<I32>(defaultSettings.mAllocatorsIterations));
+
+	if (RC_OK != result)
+	{
+		return result;
+	}
+
+	return pProgramOptions->ParseArgs({ argc, argv, "Headless benchmark of Arkanoid's gameplay loop", "ArkanoidBench --level 1 --frames 1000 --dt 0.016 --output report.json" });
+}
\ No newline at end of file
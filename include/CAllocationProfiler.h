@@ -0,0 +1,241 @@
+/*!
+	\file CAllocationProfiler.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <array>
+
+
+namespace Game
+{
+	/*!
+		struct TAllocationCallsiteStatistics
+
+		\brief The structure contains estimated values for a single callstack and allocator. All of them are extrapolated
+		from samples, each sample stands for all bytes which were allocated by the thread since the previous one
+	*/
+
+	typedef struct TAllocationCallsiteStatistics
+	{
+		TDEngine2::U64           mCallstackHash;
+		TDEngine2::U32           mAllocatorId;
+		std::vector<const void*> mCallstack; ///< The innermost frame goes first
+		TDEngine2::U64           mAllocatedSize;
+		TDEngine2::U64           mLiveSize;
+		TDEngine2::U64           mAllocationsCount;
+		TDEngine2::U32           mSamplesCount;
+	} TAllocationCallsiteStatistics;
+
+
+	/*!
+		struct TAllocatorProfileStatistics
+
+		\brief The structure contains estimated values of a single allocator
+	*/
+
+	typedef struct TAllocatorProfileStatistics
+	{
+		std::string    mName;
+		TDEngine2::U64 mAllocatedSize;
+		TDEngine2::U64 mLiveSize;
+		TDEngine2::U64 mAllocationsCount;
+		TDEngine2::F64 mAllocationRate; ///< Bytes per second since Init
+	} TAllocatorProfileStatistics;
+
+
+	/*!
+		class CAllocationProfiler
+
+		\brief The class is a sampling profiler of allocators. Each thread counts bytes it allocates with every allocator,
+		a callstack is captured once the counter exceeds a random threshold, which is the sampling interval on average,
+		so periodic allocation patterns don't alias with sampling. A sample is attributed to its callstack's
+		hash with the weight of the counted bytes, so totals stay unbiased while only a small fraction of allocations
+		pays for a stack walk. Sampled blocks are remembered to subtract them from live bytes on deallocation,
+		other deallocations are filtered out by a table of counters without taking any lock.
+
+		Allocators register themselves by name and report their traffic with OnAllocate and OnDeallocate, which
+		do nothing but a single atomic load until Init is called
+	*/
+
+	class CAllocationProfiler
+	{
+		public:
+			static constexpr TDEngine2::USIZE DefaultSamplingInterval = 256 * 1024;
+			static constexpr TDEngine2::U32   MaxAllocatorsCount = 32;
+			static constexpr TDEngine2::U32   MaxCallstackDepth = 32;
+			static constexpr TDEngine2::U32   InvalidAllocatorId = MaxAllocatorsCount;
+		public:
+			TDE2_API static CAllocationProfiler& Get();
+
+			/*!
+				\brief The method starts sampling, statistics of the previous session are discarded
+
+				\param[in] samplingInterval A number of bytes which are allocated by a thread with an allocator between two samples
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::USIZE samplingInterval = DefaultSamplingInterval);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method returns an identifier of an allocator with the given name, the same name gives the same one.
+				It could be called before Init
+
+				\return An identifier of the allocator, InvalidAllocatorId if there are too many of them
+			*/
+
+			TDE2_API TDEngine2::U32 RegisterAllocator(const std::string& name);
+
+			/*!
+				\brief The method should be invoked after each successful allocation
+
+				\param[in] pPtr A pointer to the block, could be nullptr for allocators that don't free separate blocks.
+				Such allocations count towards the allocation rate, but not towards live bytes
+			*/
+
+			TDE2_API void OnAllocate(TDEngine2::U32 allocatorId, const void* pPtr, TDEngine2::USIZE size)
+			{
+				if (!mIsEnabled.load(std::memory_order_acquire) || allocatorId >= MaxAllocatorsCount)
+				{
+					return;
+				}
+
+				TThreadCounter& counter = _getThreadCounters()[allocatorId];
+
+				/// \note The first threshold of a thread is random too, otherwise the first allocation of every thread would be sampled
+				if (!counter.mNextSampleSize)
+				{
+					counter.mNextSampleSize = _getNextSampleSize();
+				}
+
+				counter.mAllocatedSize += size;
+				if (counter.mAllocatedSize < counter.mNextSampleSize)
+				{
+					return;
+				}
+
+				_recordSample(allocatorId, pPtr, size, counter.mAllocatedSize);
+
+				counter.mAllocatedSize = 0;
+				counter.mNextSampleSize = _getNextSampleSize();
+			}
+
+			/*!
+				\brief The method should be invoked before a block is deallocated
+			*/
+
+			TDE2_API void OnDeallocate(TDEngine2::U32 allocatorId, const void* pPtr)
+			{
+				if (!pPtr || !mLiveSamplesCount.load(std::memory_order_acquire))
+				{
+					return;
+				}
+
+				if (!mSampledBuckets[_getBucketIndex(pPtr)].load(std::memory_order_relaxed))
+				{
+					return;
+				}
+
+				_releaseSample(allocatorId, pPtr);
+			}
+
+			/*!
+				\brief The method returns callsites sorted by live bytes in descending order
+			*/
+
+			TDE2_API std::vector<TAllocationCallsiteStatistics> GetCallsitesStatistics() const;
+
+			TDE2_API std::vector<TAllocatorProfileStatistics> GetAllocatorsStatistics() const;
+
+			/*!
+				\brief The method writes callsites in folded stacks format, a line per callsite: "allocator;outermost;...;innermost weight".
+				The file could be passed into flamegraph.pl or speedscope as is
+
+				\param[in] filePath A path to the output file
+				\param[in] useLiveSize If it's true the weight is a number of live bytes, otherwise a number of allocated ones
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE DumpFlameGraph(const std::string& filePath, bool useLiveSize = true) const;
+
+			TDE2_API bool IsEnabled() const;
+		private:
+			struct TCallsite
+			{
+				TDEngine2::U32           mAllocatorId;
+				std::vector<const void*> mCallstack;
+				TDEngine2::U64           mAllocatedSize = 0;
+				TDEngine2::U64           mLiveSize = 0;
+				TDEngine2::U64           mAllocationsCount = 0;
+				TDEngine2::U32           mSamplesCount = 0;
+			};
+
+			struct TThreadCounter
+			{
+				TDEngine2::U64 mAllocatedSize = 0;
+				TDEngine2::U64 mNextSampleSize = 0; ///< 0 until the thread allocates with the allocator for the first time
+			};
+
+			struct TLiveSample
+			{
+				TDEngine2::U64 mCallsiteKey;
+				TDEngine2::U64 mWeight;
+				TDEngine2::U32 mAllocatorId;
+			};
+
+			static constexpr TDEngine2::U32 SampledBucketsCount = 4096;
+			static constexpr TDEngine2::U32 SamplesShardsCount = 16;
+
+			struct TSamplesShard
+			{
+				std::mutex                                       mMutex;
+				std::unordered_map<const void*, TLiveSample>     mSamples;
+			};
+		private:
+			CAllocationProfiler() = default;
+			CAllocationProfiler(const CAllocationProfiler&) = delete;
+			CAllocationProfiler& operator= (const CAllocationProfiler&) = delete;
+
+			TDE2_API static std::array<TThreadCounter, MaxAllocatorsCount>& _getThreadCounters();
+
+			/*!
+				\brief The method returns a number of bytes till the next sample, which is exponentially distributed. It's never 0
+			*/
+
+			TDE2_API TDEngine2::U64 _getNextSampleSize() const;
+
+			TDE2_API void _recordSample(TDEngine2::U32 allocatorId, const void* pPtr, TDEngine2::USIZE size, TDEngine2::U64 weight);
+			TDE2_API void _releaseSample(TDEngine2::U32 allocatorId, const void* pPtr);
+
+			TDE2_API static TDEngine2::U32 _getBucketIndex(const void* pPtr);
+
+			TDE2_API static std::string _resolveSymbol(const void* pFrame);
+		private:
+			std::atomic<bool>                                  mIsEnabled { false };
+			TDEngine2::U64                                     mSamplingInterval = DefaultSamplingInterval;
+
+			std::atomic<TDEngine2::U32>                        mLiveSamplesCount { 0 };
+			std::array<std::atomic<TDEngine2::U32>, SampledBucketsCount> mSampledBuckets {};
+			std::array<TSamplesShard, SamplesShardsCount>      mSamplesShards;
+
+			mutable std::mutex                                 mMutex;
+
+			std::vector<std::string>                           mAllocatorsNames;
+			std::unordered_map<TDEngine2::U64, TCallsite>      mCallsites; ///< Keys are hashes of callstacks mixed with allocators' identifiers
+
+			TDEngine2::F64                                     mStartTime = 0.0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,388 @@
+/*!
+	\file CChunkedSoAStore.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CComponentsQueries.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <new>
+
+
+namespace Game
+{
+	/*!
+		\brief The function returns a summary size of the given types
+	*/
+
+	template <typename... TArgs>
+	constexpr TDEngine2::USIZE GetTypesSize()
+	{
+		const TDEngine2::USIZE sizes[] { sizeof(TArgs)... };
+
+		TDEngine2::USIZE summarySize = 0;
+
+		for (TDEngine2::USIZE currSize : sizes)
+		{
+			summarySize += currSize;
+		}
+
+		return summarySize;
+	}
+
+
+	/*!
+		class TChunkedSoAStore
+
+		\brief The class keeps elements as a structure of arrays which is split into chunks of 16 KiB. A chunk contains
+		a contiguous array per column, so a loop over a column reads memory linearly, and growth of the store never moves
+		elements that are already stored. An element is removed by moving the last one into its place.
+
+		Chunks are kept when the store is cleared, elements of a new chunk are default constructed once
+	*/
+
+	template <typename... TColumns>
+	class TChunkedSoAStore
+	{
+		public:
+			template <TDEngine2::USIZE ColumnIndex>
+			using TColumnType = typename std::tuple_element<ColumnIndex, std::tuple<TColumns...>>::type;
+
+			static constexpr TDEngine2::USIZE mChunkSize = 16384;
+			static constexpr TDEngine2::USIZE mColumnAlignment = 16;
+			static constexpr TDEngine2::USIZE mElementsPerChunk = (mChunkSize - mColumnAlignment * sizeof...(TColumns)) / GetTypesSize<TColumns...>();
+
+			static_assert(sizeof...(TColumns) > 0 && mElementsPerChunk > 0, "[TChunkedSoAStore] An element doesn't fit into a chunk");
+		public:
+			/*!
+				\brief The method appends a default constructed element
+
+				\return An index of the new element
+			*/
+
+			TDEngine2::USIZE Append()
+			{
+				if (mSize == mChunks.size() * mElementsPerChunk)
+				{
+					mChunks.emplace_back(new TChunk());
+					_constructColumns(*mChunks.back(), std::index_sequence_for<TColumns...>());
+				}
+
+				return mSize++;
+			}
+
+			/*!
+				\brief The method moves the last element into the place of the removed one
+			*/
+
+			void SwapRemove(TDEngine2::USIZE index)
+			{
+				TDE2_ASSERT(index < mSize);
+
+				const TDEngine2::USIZE lastIndex = mSize - 1;
+
+				if (index != lastIndex)
+				{
+					_moveElement(lastIndex, index, std::index_sequence_for<TColumns...>());
+				}
+
+				--mSize;
+			}
+
+			void Clear()
+			{
+				mSize = 0;
+			}
+
+			template <TDEngine2::USIZE ColumnIndex>
+			TColumnType<ColumnIndex>& Get(TDEngine2::USIZE index)
+			{
+				TDE2_ASSERT(index < mSize);
+				return GetColumn<ColumnIndex>(index / mElementsPerChunk)[index % mElementsPerChunk];
+			}
+
+			template <TDEngine2::USIZE ColumnIndex>
+			const TColumnType<ColumnIndex>& Get(TDEngine2::USIZE index) const
+			{
+				TDE2_ASSERT(index < mSize);
+				return GetColumn<ColumnIndex>(index / mElementsPerChunk)[index % mElementsPerChunk];
+			}
+
+			/*!
+				\return The method returns an array of the column within the chunk, it contains GetChunkElementsCount(chunkIndex) elements
+			*/
+
+			template <TDEngine2::USIZE ColumnIndex>
+			TColumnType<ColumnIndex>* GetColumn(TDEngine2::USIZE chunkIndex) const
+			{
+				return reinterpret_cast<TColumnType<ColumnIndex>*>(mChunks[chunkIndex]->mData + _getColumnOffset(ColumnIndex));
+			}
+
+			TDEngine2::USIZE GetChunksCount() const
+			{
+				return (mSize + mElementsPerChunk - 1) / mElementsPerChunk;
+			}
+
+			TDEngine2::USIZE GetChunkElementsCount(TDEngine2::USIZE chunkIndex) const
+			{
+				return std::min(mElementsPerChunk, mSize - chunkIndex * mElementsPerChunk);
+			}
+
+			TDEngine2::USIZE GetSize() const
+			{
+				return mSize;
+			}
+		private:
+			typedef struct TChunk
+			{
+				alignas(mColumnAlignment) TDEngine2::U8 mData[mChunkSize];
+			} TChunk, *TChunkPtr;
+		private:
+			static constexpr TDEngine2::USIZE _alignColumnSize(TDEngine2::USIZE size)
+			{
+				return (size + mColumnAlignment - 1) / mColumnAlignment * mColumnAlignment;
+			}
+
+			static constexpr TDEngine2::USIZE _getColumnOffset(TDEngine2::USIZE columnIndex)
+			{
+				const TDEngine2::USIZE sizes[] { sizeof(TColumns)... };
+
+				TDEngine2::USIZE offset = 0;
+
+				for (TDEngine2::USIZE i = 0; i < columnIndex; i++)
+				{
+					offset += _alignColumnSize(sizes[i] * mElementsPerChunk);
+				}
+
+				return offset;
+			}
+
+			template <std::size_t... Indices>
+			static void _constructColumns(TChunk& chunk, std::index_sequence<Indices...>)
+			{
+				const int expander[] { (_constructColumn<Indices>(chunk), 0)... };
+				(void)expander;
+			}
+
+			template <std::size_t ColumnIndex>
+			static void _constructColumn(TChunk& chunk)
+			{
+				typedef TColumnType<ColumnIndex> TValue;
+
+				static_assert(std::is_trivially_destructible<TValue>::value, "[TChunkedSoAStore] Chunks are released without destruction of elements");
+
+				for (TDEngine2::USIZE i = 0; i < mElementsPerChunk; i++)
+				{
+					new (chunk.mData + _getColumnOffset(ColumnIndex) + i * sizeof(TValue)) TValue();
+				}
+			}
+
+			template <std::size_t... Indices>
+			void _moveElement(TDEngine2::USIZE from, TDEngine2::USIZE to, std::index_sequence<Indices...>)
+			{
+				const int expander[] { (Get<Indices>(to) = Get<Indices>(from), 0)... };
+				(void)expander;
+			}
+		private:
+			std::vector<std::unique_ptr<TChunk>> mChunks;
+			TDEngine2::USIZE                     mSize = 0;
+	};
+
+
+	template <typename... TColumns> constexpr TDEngine2::USIZE TChunkedSoAStore<TColumns...>::mChunkSize;
+	template <typename... TColumns> constexpr TDEngine2::USIZE TChunkedSoAStore<TColumns...>::mColumnAlignment;
+	template <typename... TColumns> constexpr TDEngine2::USIZE TChunkedSoAStore<TColumns...>::mElementsPerChunk;
+
+
+	/*!
+		class TChunkedQueryMirror
+
+		\brief The class keeps a copy of hot data of a TCachedComponentsQuery's elements within TChunkedSoAStore, so a system
+		iterates the copy instead of dereferencing components. Joining and leaving elements are received as the query's events
+		and replayed in the same order, so the i-th element of the store always corresponds to the i-th element of the query.
+		Values are copied only for the elements that have changed since the previous Sync
+	*/
+
+	template <typename TQuery, typename... TColumns>
+	class TChunkedQueryMirror : public IComponentsQueryListener
+	{
+		public:
+			typedef TChunkedSoAStore<TColumns...> TStore;
+		public:
+			TChunkedQueryMirror() = default;
+			TChunkedQueryMirror(const TChunkedQueryMirror&) = delete;
+			TChunkedQueryMirror& operator= (const TChunkedQueryMirror&) = delete;
+
+			~TChunkedQueryMirror() override
+			{
+				Bind(nullptr);
+			}
+
+			/*!
+				\brief The method starts mirroring of the query, the previous one is forgotten. The query reports its current elements
+				as appended ones, they're copied on the next Sync. It should be called from the main thread
+			*/
+
+			void Bind(TQuery* pQuery)
+			{
+				if (pQuery == mpQuery)
+				{
+					return;
+				}
+
+				/// \note The query invokes listeners under its own lock, so the mirror's one isn't held while the query is called
+				if (mpQuery)
+				{
+					mpQuery->RemoveListener(this);
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+
+					mpQuery = pQuery;
+
+					mStore.Clear();
+					mPendingChanges.clear();
+					mVersion = 0;
+				}
+
+				if (pQuery)
+				{
+					pQuery->AddListener(this);
+				}
+			}
+
+			/*!
+				\brief The method applies elements which joined or left the query and copies values of the changed ones
+				with copyElement(index, TColumns&... values)
+
+				\return The method returns true if some element has joined or left the query since the previous call,
+				so indices of elements aren't the same anymore
+			*/
+
+			template <typename TCopyAction>
+			bool Sync(TCopyAction&& copyElement)
+			{
+				if (!mpQuery)
+				{
+					return false;
+				}
+
+				mpQuery->GetSlice();
+
+				const TDEngine2::U32 lastSeenVersion = mVersion;
+				mVersion = AdvanceWorldVersion();
+
+				bool hasStructureChanged = false;
+
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+
+					for (const TStructuralChange& currChange : mPendingChanges)
+					{
+						switch (currChange.mType)
+						{
+							case E_STRUCTURAL_CHANGE_TYPE::APPEND:
+								mStore.Append();
+								break;
+							case E_STRUCTURAL_CHANGE_TYPE::REMOVE:
+								mStore.SwapRemove(currChange.mIndex);
+								break;
+							case E_STRUCTURAL_CHANGE_TYPE::CLEAR:
+								mStore.Clear();
+								break;
+						}
+					}
+
+					hasStructureChanged = !mPendingChanges.empty();
+					mPendingChanges.clear();
+				}
+
+				mpQuery->ForEachChangedSince(lastSeenVersion, [this, &copyElement](TDEngine2::USIZE index)
+				{
+					_copyElement(copyElement, index, std::index_sequence_for<TColumns...>());
+				});
+
+				return hasStructureChanged;
+			}
+
+			const TStore& GetStore() const
+			{
+				return mStore;
+			}
+
+			void OnElementAppended(TDEngine2::USIZE index) override
+			{
+				_pushChange({ E_STRUCTURAL_CHANGE_TYPE::APPEND, index });
+			}
+
+			void OnElementRemoved(TDEngine2::USIZE index) override
+			{
+				_pushChange({ E_STRUCTURAL_CHANGE_TYPE::REMOVE, index });
+			}
+
+			void OnElementsCleared() override
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				/// \note Earlier changes don't matter anymore
+				mPendingChanges.clear();
+				mPendingChanges.push_back({ E_STRUCTURAL_CHANGE_TYPE::CLEAR, 0 });
+			}
+
+			void OnQueryDestroyed() override
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				mpQuery = nullptr;
+
+				mStore.Clear();
+				mPendingChanges.clear();
+			}
+		private:
+			enum class E_STRUCTURAL_CHANGE_TYPE : TDEngine2::U8
+			{
+				APPEND,
+				REMOVE,
+				CLEAR,
+			};
+
+			typedef struct TStructuralChange
+			{
+				E_STRUCTURAL_CHANGE_TYPE mType;
+				TDEngine2::USIZE         mIndex;
+			} TStructuralChange, *TStructuralChangePtr;
+		private:
+			void _pushChange(const TStructuralChange& change)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mPendingChanges.push_back(change);
+			}
+
+			template <typename TCopyAction, std::size_t... Indices>
+			void _copyElement(TCopyAction& copyElement, TDEngine2::USIZE index, std::index_sequence<Indices...>)
+			{
+				copyElement(index, mStore.template Get<Indices>(index)...);
+			}
+		private:
+			TQuery*                        mpQuery = nullptr;
+
+			TStore                         mStore;
+
+			/// \note The query's events come from a thread that reads the query, so they're applied only within Sync
+			std::vector<TStructuralChange> mPendingChanges;
+			mutable std::mutex             mMutex;
+
+			TDEngine2::U32                 mVersion = 0; ///< The world's version of the previous Sync, 0 makes every element a changed one
+	};
+}
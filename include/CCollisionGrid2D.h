@@ -0,0 +1,140 @@
+/*!
+	\file CCollisionGrid2D.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CEntityHandles.h"
+#include <vector>
+
+
+namespace Game
+{
+	/*!
+		struct TGridObstacle
+
+		\brief The structure describes an axis-aligned box on the playfield. All the coordinates lie in XZ plane,
+		so TVector2::y corresponds to world's Z axis
+	*/
+
+	typedef struct TGridObstacle
+	{
+		TDEngine2::TEntityId mEntityId = TDEngine2::TEntityId::Invalid;
+		TEntityHandle        mEntityHandle = TEntityHandle::Invalid; ///< Resolved by the owner once, so contacts are dispatched without lookups
+		TDEngine2::TVector2  mMin;
+		TDEngine2::TVector2  mMax;
+	} TGridObstacle, *TGridObstaclePtr;
+
+
+	/*!
+		struct TSweptCircleHit
+
+		\brief The structure contains information about the earliest contact that was found with SweepCircle
+	*/
+
+	typedef struct TSweptCircleHit
+	{
+		TDEngine2::TEntityId mEntityId = TDEngine2::TEntityId::Invalid;
+		TEntityHandle        mEntityHandle = TEntityHandle::Invalid;
+		TDEngine2::U32       mObstacleIndex = 0;
+		TDEngine2::F32       mTime = 1.0f;  ///< A fraction of the displacement in range [0; 1] before the contact
+		TDEngine2::TVector2  mNormal;       ///< An axis-aligned normal which points outside of the obstacle
+	} TSweptCircleHit, *TSweptCircleHitPtr;
+
+
+	/*!
+		class CCollisionGrid2D
+
+		\brief The class is a uniform grid over static boxes of the playfield. It's rebuilt from scratch by its owner
+		and used to find the first contact of a moving circle without tunnelling through thin obstacles.
+		A few obstacles which move between rebuilds (e.g. the paddle) are tested apart from cells.
+
+		Components themselves are stored by the engine's CComponentManager, the grid keeps its own copy of the data
+		the ball's sweep reads, laid out as a structure of arrays
+	*/
+
+	class CCollisionGrid2D
+	{
+		public:
+			/*!
+				\brief The method removes all obstacles and sets up a new size of a cell
+			*/
+
+			TDE2_API void Reset(TDEngine2::F32 cellSize);
+
+			/*!
+				\brief The method appends a new obstacle, Build should be invoked after all obstacles are added
+
+				\return An index of the obstacle which is also returned within TSweptCircleHit::mObstacleIndex
+			*/
+
+			TDE2_API TDEngine2::U32 AddObstacle(const TGridObstacle& obstacle);
+
+			/*!
+				\brief The method distributes the obstacles between cells
+			*/
+
+			TDE2_API void Build();
+
+			/*!
+				\brief The method excludes the obstacle from next queries without rebuilding of the grid
+			*/
+
+			TDE2_API void DisableObstacle(TDEngine2::U32 obstacleIndex);
+
+			/*!
+				\brief The method changes bounds of the obstacle without rebuilding of the grid. Until the next Build
+				the obstacle is tested against every query instead of being looked up within cells
+			*/
+
+			TDE2_API void UpdateObstacle(TDEngine2::U32 obstacleIndex, const TDEngine2::TVector2& min, const TDEngine2::TVector2& max);
+
+			/*!
+				\brief The method finds the earliest contact of a circle which moves from origin by the given displacement.
+				An obstacle which already overlaps the circle gives a contact at the start if the circle moves into it,
+				the obstacles it moves away from are ignored
+
+				\return The method returns true if there is a contact, the details are written into hit
+			*/
+
+			TDE2_API bool SweepCircle(const TDEngine2::TVector2& origin, const TDEngine2::TVector2& displacement, TDEngine2::F32 radius, TSweptCircleHit& hit) const;
+		private:
+			/*!
+				\brief Only the bounds are touched by the narrow phase, so they're stored apart from the rest of obstacle's data
+			*/
+
+			typedef struct TObstacleBounds
+			{
+				TDEngine2::TVector2 mMin;
+				TDEngine2::TVector2 mMax;
+			} TObstacleBounds, *TObstacleBoundsPtr;
+		private:
+			TDE2_API TDEngine2::U32 _getCellIndex(TDEngine2::U32 column, TDEngine2::U32 row) const;
+			TDE2_API TDEngine2::U32 _getColumn(TDEngine2::F32 x) const;
+			TDE2_API TDEngine2::U32 _getRow(TDEngine2::F32 y) const;
+		private:
+			static constexpr TDEngine2::U32 mMaxCellsPerAxis = 128;
+
+			std::vector<TObstacleBounds>      mObstaclesBounds;
+			std::vector<TDEngine2::TEntityId> mObstaclesEntities; ///< Read only when a contact is found
+			std::vector<TEntityHandle>        mObstaclesHandles;
+			std::vector<TDEngine2::U8>        mObstaclesEnabledFlags;
+			std::vector<TDEngine2::U8>        mObstaclesMovedFlags;
+			std::vector<TDEngine2::U32>       mMovedObstacles; ///< Obstacles which bounds don't match their cells anymore
+
+			std::vector<TDEngine2::U32>  mCellsOffsets; ///< The cell i contains mCellsItems[mCellsOffsets[i] .. mCellsOffsets[i + 1])
+			std::vector<TDEngine2::U32>  mCellsItems;
+
+			mutable std::vector<TDEngine2::U32> mVisitMarks; ///< Prevents repeated tests of obstacles which span several cells
+			mutable TDEngine2::U32       mCurrVisitMark = 0;
+
+			TDEngine2::TVector2          mOrigin;
+			TDEngine2::F32               mCellSize = 1.0f;
+			TDEngine2::U32               mColumnsCount = 0;
+			TDEngine2::U32               mRowsCount = 0;
+	};
+}
\ No newline at end of file
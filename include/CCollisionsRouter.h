@@ -0,0 +1,167 @@
+/*!
+	\file CCollisionsRouter.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CEntityHandles.h"
+#include "CEventChannels.h"
+#include "CFrameArena.h"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Game
+{
+	class CCollisionsRouter;
+
+
+	/*!
+		struct TCollisionContactInfo
+
+		\brief The structure is passed into every collision handler along with resolved components
+	*/
+
+	typedef struct TCollisionContactInfo
+	{
+		TDEngine2::TEntityId mFirstEntityId = TDEngine2::TEntityId::Invalid;
+		TDEngine2::TEntityId mSecondEntityId = TDEngine2::TEntityId::Invalid;
+		TEntityHandle        mFirstEntityHandle = TEntityHandle::Invalid;  ///< Use with Game::GetComponent<T> instead of IWorld::FindEntity
+		TEntityHandle        mSecondEntityHandle = TEntityHandle::Invalid;
+		TDEngine2::TVector3  mContactNormal; ///< The normal points towards the first entity
+	} TCollisionContactInfo, *TCollisionContactInfoPtr;
+
+
+	/*!
+		\brief A factory function for creation objects of CCollisionsRouter's type
+
+		\param[in, out] pWorld A pointer to IWorld implementation
+		\param[in, out] pEventManager A pointer to IEventManager implementation
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CCollisionsRouter's implementation
+	*/
+
+	TDE2_API CCollisionsRouter* CreateCollisionsRouter(TDEngine2::TPtr<TDEngine2::IWorld> pWorld, TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CCollisionsRouter
+
+		\brief The class is the only listener of collision events (TOn3DCollisionRegisteredEvent and TBallCollisionEvent which
+		goes through CEventChannels).
+		Systems register handlers for pairs of components' types, e.g. (CBall, CDamageable), and receive only contacts
+		between entities that have these components. Only ON_ENTER contacts are routed
+	*/
+
+	class CCollisionsRouter : public TDEngine2::CBaseObject, public TDEngine2::IEventHandler
+	{
+		public:
+			friend TDE2_API CCollisionsRouter* CreateCollisionsRouter(TDEngine2::TPtr<TDEngine2::IWorld>, TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+		public:
+			template <typename TFirst, typename TSecond>
+			using TCollisionHandler = std::function<void(TFirst*, TSecond*, const TCollisionContactInfo&)>;
+		public:
+			TDE2_REGISTER_TYPE(CCollisionsRouter)
+
+			/*!
+				\brief The method initializes an inner state of a router
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IWorld> pWorld, TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			/*!
+				\brief The method registers a handler which is invoked when an entity with TFirst component touches
+				an entity with TSecond one. The order of entities within the original event doesn't matter
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			template <typename TFirst, typename TSecond>
+			TDE2_API TDEngine2::E_RESULT_CODE RegisterHandler(const TCollisionHandler<TFirst, TSecond>& handler)
+			{
+				if (!handler)
+				{
+					return TDEngine2::RC_INVALID_ARGS;
+				}
+
+				return _registerHandlerInternal(TFirst::GetTypeId(), TSecond::GetTypeId(),
+					[handler](TDEngine2::IComponent* pFirst, TDEngine2::IComponent* pSecond, const TCollisionContactInfo& contactInfo)
+					{
+						/// \note Types' identifiers of both components are already matched by the router. Components derive from IComponent
+						/// virtually, so static_cast can't be used here, but a handler never receives nullptr
+						TFirst* pFirstComponent = dynamic_cast<TFirst*>(pFirst);
+						TSecond* pSecondComponent = dynamic_cast<TSecond*>(pSecond);
+
+						TDE2_ASSERT(pFirstComponent && pSecondComponent);
+						if (!pFirstComponent || !pSecondComponent)
+						{
+							return;
+						}
+
+						handler(pFirstComponent, pSecondComponent, contactInfo);
+					});
+			}
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CCollisionsRouter)
+
+			TDE2_API TDEngine2::E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API TDEngine2::E_RESULT_CODE _registerHandlerInternal(TDEngine2::TypeId firstTypeId, TDEngine2::TypeId secondTypeId,
+				const std::function<void(TDEngine2::IComponent*, TDEngine2::IComponent*, const TCollisionContactInfo&)>& handler);
+
+			TDE2_API void _dispatch(TDEngine2::TEntityId firstEntityId, TDEngine2::TEntityId secondEntityId, const TDEngine2::TVector3& contactNormal);
+
+			/*!
+				\brief The method is used by senders that have already resolved handles of entities, so a contact costs no hashed lookups
+			*/
+
+			TDE2_API void _dispatch(TDEngine2::TEntityId firstEntityId, TEntityHandle firstEntityHandle, TDEngine2::TEntityId secondEntityId,
+				TEntityHandle secondEntityHandle, const TDEngine2::TVector3& contactNormal);
+
+			TDE2_API void _dispatchOrdered(const TFrameVector<TDEngine2::IComponent*>& firstComponents, const TFrameVector<TDEngine2::IComponent*>& secondComponents,
+				const TCollisionContactInfo& contactInfo);
+		private:
+			typedef std::function<void(TDEngine2::IComponent*, TDEngine2::IComponent*, const TCollisionContactInfo&)> THandlerFunctor;
+
+			typedef struct THandlerEntry
+			{
+				TDEngine2::TypeId mSecondTypeId;
+				THandlerFunctor   mHandler;
+			} THandlerEntry;
+
+			typedef std::unordered_map<TDEngine2::TypeId, std::vector<THandlerEntry>> THandlersTable;
+		private:
+			TDEngine2::TPtr<TDEngine2::IWorld>        mpWorld = nullptr;
+			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
+
+			THandlersTable                            mHandlers; ///< The handlers are grouped by the first type of a pair
+
+			TEventSubscriptionId                      mBallCollisionSubscriptionId = TEventSubscriptionId::Invalid;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*!
+	\file CComponentPoolAllocPolicy.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CAllocationProfiler.h"
+#include <type_traits>
+
+
+namespace Game
+{
+	constexpr TDEngine2::USIZE ComponentPoolMinPageSize = 4096;
+	constexpr TDEngine2::USIZE ComponentPoolDefaultObjectsPerPage = 64;
+	constexpr TDEngine2::USIZE ComponentPoolMaxObjectSize = 16 * 1024; ///< Larger components are too expensive to be pooled page by page
+	constexpr TDEngine2::USIZE ComponentPoolMaxAlignment = 16;
+
+
+	/*!
+		\brief The function returns a size of a pool's page that fits objectsPerPage objects. The size is a multiple of
+		ComponentPoolMinPageSize, so pools of small components don't reserve more than a single memory page at start
+	*/
+
+	constexpr TDEngine2::USIZE GetComponentPoolPageSize(TDEngine2::USIZE objectSize, TDEngine2::USIZE objectsPerPage = ComponentPoolDefaultObjectsPerPage)
+	{
+		return ((objectSize * objectsPerPage + ComponentPoolMinPageSize - 1) / ComponentPoolMinPageSize) * ComponentPoolMinPageSize;
+	}
+
+
+	/*!
+		class CComponentPoolAllocPolicy
+
+		\brief The policy works the same way as CPoolMemoryAllocPolicy does, but a page size is derived from the type's size,
+		so a pool grows with pages of objectsPerPage objects instead of reserving a fixed size at first allocation.
+
+		Don't derive from it directly, use GAME_POOLED_COMPONENT_BASES which passes the component's type itself
+	*/
+
+	template <typename T, TDEngine2::USIZE objectsPerPage = ComponentPoolDefaultObjectsPerPage>
+	class CComponentPoolAllocPolicy
+	{
+		public:
+			TDE2_API static void* operator new(std::size_t size, const std::nothrow_t&) { return _allocateImpl(size); }
+
+			TDE2_API static void operator delete(void* pPtr, const std::nothrow_t&) { _deallocateImpl(pPtr); }
+			TDE2_API static void operator delete(void* pPtr) { _deallocateImpl(pPtr); }
+		private:
+			TDE2_API static void* _allocateImpl(std::size_t size)
+			{
+				/// \note The policy's type differs from the allocated one, objects would overlap within the pool
+				TDE2_ASSERT(sizeof(T) == size);
+
+				if (auto pAllocator = _getAllocator())
+				{
+					void* pPtr = pAllocator->Allocate(size, alignof(T));
+
+					if (pPtr)
+					{
+						CAllocationProfiler::Get().OnAllocate(mProfilerAllocatorId, pPtr, size);
+					}
+
+					return pPtr;
+				}
+
+				return nullptr;
+			}
+
+			TDE2_API static void _deallocateImpl(void* pPtr) noexcept
+			{
+				CAllocationProfiler::Get().OnDeallocate(mProfilerAllocatorId, pPtr);
+
+				if (auto pAllocator = _getAllocator())
+				{
+					pAllocator->Deallocate(pPtr);
+				}
+			}
+
+			TDE2_API static TDEngine2::IAllocator* _getAllocator() noexcept
+			{
+				static_assert(std::is_base_of<CComponentPoolAllocPolicy<T, objectsPerPage>, T>::value, "[CComponentPoolAllocPolicy] The policy should be parametrized with the component's own type");
+				static_assert(sizeof(T) <= ComponentPoolMaxObjectSize, "[CComponentPoolAllocPolicy] The component is too large to be pooled");
+				static_assert(alignof(T) <= ComponentPoolMaxAlignment, "[CComponentPoolAllocPolicy] The component's alignment is greater than the pool's one");
+				static_assert(objectsPerPage > 0, "[CComponentPoolAllocPolicy] A page should contain at least a single object");
+
+				if (!mpTypeAllocator)
+				{
+					mpTypeAllocator = TDEngine2::CPoolAllocatorsRegistry::GetAllocator(sizeof(T), alignof(T), GetComponentPoolPageSize(sizeof(T), objectsPerPage));
+					mProfilerAllocatorId = CAllocationProfiler::Get().RegisterAllocator("component-pools");
+				}
+
+				return mpTypeAllocator;
+			}
+		private:
+			static TDEngine2::IAllocator* mpTypeAllocator;
+			static TDEngine2::U32         mProfilerAllocatorId;
+	};
+
+	template <typename T, TDEngine2::USIZE objectsPerPage> TDEngine2::IAllocator* CComponentPoolAllocPolicy<T, objectsPerPage>::mpTypeAllocator = nullptr;
+	template <typename T, TDEngine2::USIZE objectsPerPage> TDEngine2::U32 CComponentPoolAllocPolicy<T, objectsPerPage>::mProfilerAllocatorId = CAllocationProfiler::InvalidAllocatorId;
+}
+
+
+/*!
+	\brief The macro expands into a list of base classes of a pooled component, the allocation policy is derived from
+	the component's name. Use it as class CMyComponent : GAME_POOLED_COMPONENT_BASES(CMyComponent) { ... }
+*/
+
+#define GAME_POOLED_COMPONENT_BASES(ComponentName) public ::TDEngine2::CBaseComponent, public ::Game::CComponentPoolAllocPolicy<ComponentName>
\ No newline at end of file
@@ -0,0 +1,518 @@
+/*!
+	\file CComponentsQueries.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+
+
+namespace Game
+{
+	/*!
+		\brief The function returns the current version of the world. A component which is accessed for writing
+		through the queries is stamped with it, see TCachedComponentsQuery::GetMutable
+	*/
+
+	TDE2_API TDEngine2::U32 GetWorldVersion();
+
+	/*!
+		\brief The function increments the version of the world. A system calls it at the beginning of its update and keeps
+		the previous value, everything that's changed since then has a version that's not less than the kept one
+
+		\return The method returns the new version of the world
+	*/
+
+	TDE2_API TDEngine2::U32 AdvanceWorldVersion();
+
+	/*!
+		\brief The function stamps the component of the entity within all the queries that contain it. It should be called
+		when a component is changed bypassing GetMutable, e.g. through CEntity::GetComponent
+	*/
+
+	TDE2_API void MarkComponentChanged(TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId);
+
+
+	template <typename T>
+	void MarkComponentChanged(TDEngine2::TEntityId entityId)
+	{
+		MarkComponentChanged(entityId, T::GetTypeId());
+	}
+
+
+	/*!
+		\brief The function enables or disables the entity for all components queries. A disabled entity leaves
+		queries as if it was deactivated, but no components are added or removed, so it's neither a structural change
+		nor an ECS event. Engine's systems, e.g. rendering and physics, don't see the flag
+	*/
+
+	TDE2_API void SetEntityEnabled(TDEngine2::TEntityId entityId, bool isEnabled);
+
+	TDE2_API bool IsEntityEnabled(TDEngine2::TEntityId entityId);
+
+
+	/*!
+		interface IComponentsQueryListener
+
+		\brief The interface receives structural changes of CBaseComponentsQuery. The methods are invoked by a thread that
+		reads the query while the query's lock is held, so a listener should only remember the changes
+	*/
+
+	class IComponentsQueryListener
+	{
+		public:
+			TDE2_API virtual ~IComponentsQueryListener() = default;
+
+			/*!
+				\brief The method is invoked when an element is appended to the end of the query
+			*/
+
+			TDE2_API virtual void OnElementAppended(TDEngine2::USIZE index) = 0;
+
+			/*!
+				\brief The method is invoked when the index-th element leaves the query, the last element is moved into its place
+			*/
+
+			TDE2_API virtual void OnElementRemoved(TDEngine2::USIZE index) = 0;
+
+			/*!
+				\brief The method is invoked when the query is going to be collected from scratch, all elements are appended again
+			*/
+
+			TDE2_API virtual void OnElementsCleared() = 0;
+
+			/*!
+				\brief The method is invoked when the query is destroyed, e.g. when it's recreated for another world
+			*/
+
+			TDE2_API virtual void OnQueryDestroyed() = 0;
+	};
+
+
+	/*!
+		class CBaseComponentsQuery
+
+		\brief The class is a type-erased part of TCachedComponentsQuery which CComponentsQueriesCache works with.
+		Entities that are touched by ECS events are only marked here, the query checks them when it's read next time.
+		A query could be shared by systems of CSystemsGroup which are updated concurrently, so the state is guarded.
+
+		Every component of every entity keeps a version of its latest change. Joining of an entity counts as a change of
+		all its components, joining or leaving of an entity or a full rebuild changes the version of the whole query's structure
+	*/
+
+	class CBaseComponentsQuery
+	{
+		public:
+			TDE2_API CBaseComponentsQuery(TDEngine2::IWorld* pWorld, std::vector<TDEngine2::TypeId>&& componentsTypes);
+			TDE2_API virtual ~CBaseComponentsQuery();
+
+			/*!
+				\brief The method subscribes the listener to structural changes. The current elements are reported as appended ones
+			*/
+
+			TDE2_API void AddListener(IComponentsQueryListener* pListener);
+
+			TDE2_API void RemoveListener(IComponentsQueryListener* pListener);
+
+			TDE2_API void MarkEntityDirty(TDEngine2::TEntityId entityId);
+
+			/*!
+				\brief The method forces the query to be collected from scratch on the next read. An untracked query does it on every read
+			*/
+
+			TDE2_API void Invalidate(bool isTracked);
+
+			TDE2_API bool DependsOn(TDEngine2::TypeId componentTypeId) const;
+			TDE2_API bool Contains(TDEngine2::TEntityId entityId) const;
+
+			TDE2_API TDEngine2::IWorld* GetWorld() const;
+
+			/*!
+				\brief The method stamps the component of the entity with the given version if the entity belongs to the query
+			*/
+
+			TDE2_API void MarkComponentChanged(TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId, TDEngine2::U32 version);
+
+			/*!
+				\return The method returns the version when an entity joined or left the query or its elements were collected from scratch.
+				Indices of elements which were read before that version aren't valid anymore
+			*/
+
+			TDE2_API TDEngine2::U32 GetStructureVersion() const;
+
+			/*!
+				\return The method returns true if the structure or any component of any element has changed since the version
+			*/
+
+			TDE2_API bool HasChangedSince(TDEngine2::U32 version) const;
+
+			/*!
+				\return The method returns true if any component of the index-th element has changed since the version
+			*/
+
+			TDE2_API bool HasChangedSince(TDEngine2::USIZE index, TDEngine2::U32 version) const;
+
+			/*!
+				\brief The method invokes the action with an index of every element that has changed since the version.
+				GetSlice should be called before to apply pending ECS events
+			*/
+
+			template <typename TAction>
+			void ForEachChangedSince(TDEngine2::U32 version, TAction&& action) const
+			{
+				if (!HasChangedSince(version))
+				{
+					return;
+				}
+
+				for (TDEngine2::USIZE i = 0; i < mEntities.size(); i++)
+				{
+					if (HasChangedSince(i, version))
+					{
+						action(i);
+					}
+				}
+			}
+		protected:
+			/*!
+				\brief The method copies the flags of disabled entities under a single lock, _isEntityActive reads the copy.
+				It should be called before entities are checked
+			*/
+
+			TDE2_API void _takeDisabledEntitiesSnapshot();
+
+			TDE2_API bool _isEntityActive(TDEngine2::CEntity* pEntity) const;
+
+			TDE2_API void _resetVersions(TDEngine2::U32 version);
+			TDE2_API void _appendVersions(TDEngine2::U32 version);
+			TDE2_API void _stampVersions(TDEngine2::USIZE index, TDEngine2::U32 version);
+			TDE2_API void _removeVersions(TDEngine2::USIZE index, TDEngine2::U32 version);
+		protected:
+			static constexpr TDEngine2::USIZE                          mMaxDirtyEntitiesSlack = 256;
+
+			TDEngine2::IWorld*                                         mpWorld;
+
+			std::vector<TDEngine2::TypeId>                             mComponentsTypes;
+
+			std::vector<TDEngine2::TEntityId>                          mEntities;
+			std::unordered_map<TDEngine2::TEntityId, TDEngine2::USIZE> mEntitiesIndices;
+
+			std::vector<TDEngine2::TEntityId>                          mDirtyEntities; ///< Could contain duplicates, every check is idempotent
+
+			std::vector<TDEngine2::U64>                                mDisabledEntitiesMask; ///< A copy of CComponentsQueriesCache's one, it's taken once per read
+
+			std::vector<std::vector<TDEngine2::U32>>                   mComponentsVersions; ///< Versions of i-th component type are in mComponentsVersions[i]
+			TDEngine2::U32                                             mStructureVersion = 0;
+			TDEngine2::U32                                             mLatestVersion = 0;
+
+			bool                                                       mIsTracked = false;
+			bool                                                       mNeedsRebuild = true;
+
+			std::vector<IComponentsQueryListener*>                     mListeners;
+
+			mutable std::mutex                                         mMutex;
+	};
+
+
+	/*!
+		class TCachedComponentsQuery
+
+		\brief The class is a persistent counterpart of IWorld::CreateLocalComponentsSlice. It's created once
+		per set of types and updated in place: a new matching entity is appended, a lost one is swap-removed,
+		so the cost of a spawn doesn't depend on a number of entities in the world. Deactivated and disabled
+		entities are skipped.
+
+		Appending and swap-removing don't keep parents before their children, so unlike the engine's slice the order
+		of elements doesn't follow the hierarchy and mParentsToChildMapping stays empty, none of game systems relies on them
+	*/
+
+	template <typename... TArgs>
+	class TCachedComponentsQuery : public CBaseComponentsQuery
+	{
+		public:
+			explicit TCachedComponentsQuery(TDEngine2::IWorld* pWorld) :
+				CBaseComponentsQuery(pWorld, { TArgs::GetTypeId()... })
+			{
+			}
+
+			/*!
+				\brief The method applies all pending changes and returns the components. The arrays stay valid
+				until the next call of the method
+			*/
+
+			const TDEngine2::TComponentsQueryLocalSlice<TArgs...>& GetSlice()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				const bool needsRebuild = mNeedsRebuild || !mIsTracked;
+
+				if (!needsRebuild && mDirtyEntities.empty())
+				{
+					return mSlice;
+				}
+
+				_takeDisabledEntitiesSnapshot();
+
+				if (needsRebuild)
+				{
+					_rebuild();
+					return mSlice;
+				}
+
+				for (TDEngine2::TEntityId currEntityId : mDirtyEntities)
+				{
+					_updateEntity(currEntityId);
+				}
+
+				mDirtyEntities.clear();
+
+				return mSlice;
+			}
+
+			/*!
+				\brief The method returns a component of the index-th element for writing. The component is stamped
+				with the current version of the world within all the queries
+			*/
+
+			template <typename T>
+			T* GetMutable(TDEngine2::USIZE index)
+			{
+				T* pComponent = std::get<std::vector<T*>>(mSlice.mComponentsSlice)[index];
+				Game::MarkComponentChanged<T>(mEntities[index]);
+
+				return pComponent;
+			}
+		private:
+			void _rebuild()
+			{
+				mEntities.clear();
+				mEntitiesIndices.clear();
+				mDirtyEntities.clear();
+
+				mSlice = TDEngine2::TComponentsQueryLocalSlice<TArgs...>();
+
+				_resetVersions(GetWorldVersion());
+
+				for (TDEngine2::TEntityId currEntityId : mpWorld->FindEntitiesWithComponents<TArgs...>())
+				{
+					TDEngine2::CEntity* pEntity = mpWorld->FindEntity(currEntityId);
+
+					if (_isMatched(pEntity))
+					{
+						_append(pEntity);
+					}
+				}
+
+				mNeedsRebuild = false;
+			}
+
+			bool _isMatched(TDEngine2::CEntity* pEntity) const
+			{
+				const bool hasComponents[] { (pEntity && pEntity->HasComponent<TArgs>())... };
+				return pEntity && _isEntityActive(pEntity) && std::all_of(std::begin(hasComponents), std::end(hasComponents), [](bool value) { return value; });
+			}
+
+			void _updateEntity(TDEngine2::TEntityId entityId)
+			{
+				TDEngine2::CEntity* pEntity = mpWorld->FindEntity(entityId);
+
+				auto it = mEntitiesIndices.find(entityId);
+
+				if (!_isMatched(pEntity))
+				{
+					if (mEntitiesIndices.cend() != it)
+					{
+						_removeAt(it->second);
+					}
+
+					return;
+				}
+
+				if (mEntitiesIndices.cend() != it)
+				{
+					/// \note A component could be re-added, so pointers are refreshed and treated as changed ones
+					const TDEngine2::USIZE index = it->second;
+					const int expander[] { (std::get<std::vector<TArgs*>>(mSlice.mComponentsSlice)[index] = pEntity->GetComponent<TArgs>(), 0)... };
+					(void)expander;
+
+					_stampVersions(index, GetWorldVersion());
+
+					return;
+				}
+
+				_append(pEntity);
+			}
+
+			void _append(TDEngine2::CEntity* pEntity)
+			{
+				const TDEngine2::TEntityId entityId = pEntity->GetId();
+
+				mEntitiesIndices.emplace(entityId, mEntities.size());
+				mEntities.push_back(entityId);
+
+				_appendVersions(GetWorldVersion());
+
+				const int expander[] { (std::get<std::vector<TArgs*>>(mSlice.mComponentsSlice).push_back(pEntity->GetComponent<TArgs>()), 0)... };
+				(void)expander;
+
+				++mSlice.mComponentsCount;
+			}
+
+			void _removeAt(TDEngine2::USIZE index)
+			{
+				const TDEngine2::USIZE lastIndex = mEntities.size() - 1;
+
+				mEntitiesIndices.erase(mEntities[index]);
+
+				if (index != lastIndex)
+				{
+					mEntities[index] = mEntities[lastIndex];
+					mEntitiesIndices[mEntities[index]] = index;
+				}
+
+				mEntities.pop_back();
+
+				_removeVersions(index, GetWorldVersion());
+
+				const int expander[] { (_swapRemove(std::get<std::vector<TArgs*>>(mSlice.mComponentsSlice), index), 0)... };
+				(void)expander;
+
+				--mSlice.mComponentsCount;
+			}
+
+			template <typename T>
+			static void _swapRemove(std::vector<T*>& components, TDEngine2::USIZE index)
+			{
+				components[index] = components.back();
+				components.pop_back();
+			}
+		private:
+			TDEngine2::TComponentsQueryLocalSlice<TArgs...> mSlice;
+	};
+
+
+	/*!
+		class CComponentsQueriesCache
+
+		\brief The class owns persistent components queries and routes ECS events into them. Every set of types
+		gets its own slot which index is assigned once per process, like CWorldSingletonsCache does.
+
+		Until Init is called the queries are collected from scratch on every read
+	*/
+
+	class CComponentsQueriesCache : public TDEngine2::IEventHandler
+	{
+		public:
+			TDE2_API static CComponentsQueriesCache& Get();
+
+			/*!
+				\brief The method subscribes the cache to ECS events
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method stamps the component of the entity with the current version of the world within all the queries
+			*/
+
+			TDE2_API void MarkComponentChanged(TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId);
+
+			/*!
+				\brief The method flips the entity's bit and marks the entity within all queries, they check it on the next read.
+				The flag is reset when the entity is destroyed, so a reused identifier starts enabled
+			*/
+
+			TDE2_API void SetEntityEnabled(TDEngine2::TEntityId entityId, bool isEnabled);
+
+			TDE2_API bool IsEntityEnabled(TDEngine2::TEntityId entityId) const;
+
+			/*!
+				\brief The method copies a bit per identifier of an entity, a set one means the entity is disabled. Queries take
+				the copy once per read, so the lock isn't acquired for every checked entity
+			*/
+
+			TDE2_API void CopyDisabledEntitiesMask(std::vector<TDEngine2::U64>& mask) const;
+
+			TDE2_API TDEngine2::U32 GetWorldVersion() const;
+			TDE2_API TDEngine2::U32 AdvanceWorldVersion();
+
+			template <typename... TArgs>
+			TDE2_API TCachedComponentsQuery<TArgs...>* GetQuery(TDEngine2::IWorld* pWorld)
+			{
+				static const TDEngine2::U32 slotIndex = _allocateSlotIndex();
+
+				std::unique_ptr<CBaseComponentsQuery>& pSlot = _getSlot(slotIndex);
+
+				if (!pSlot || pSlot->GetWorld() != pWorld)
+				{
+					pSlot = std::make_unique<TCachedComponentsQuery<TArgs...>>(pWorld);
+					pSlot->Invalidate(static_cast<bool>(mpEventManager));
+				}
+
+				return static_cast<TCachedComponentsQuery<TArgs...>*>(pSlot.get());
+			}
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		private:
+			CComponentsQueriesCache() = default;
+			CComponentsQueriesCache(const CComponentsQueriesCache&) = delete;
+			CComponentsQueriesCache& operator= (const CComponentsQueriesCache&) = delete;
+
+			TDE2_API static TDEngine2::U32 _allocateSlotIndex();
+
+			TDE2_API std::unique_ptr<CBaseComponentsQuery>& _getSlot(TDEngine2::U32 slotIndex);
+
+			TDE2_API void _onComponentChanged(TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId);
+
+			TDE2_API void _markEntityDirty(TDEngine2::TEntityId entityId);
+		private:
+			TDEngine2::TPtr<TDEngine2::IEventManager>          mpEventManager = nullptr;
+
+			std::vector<std::unique_ptr<CBaseComponentsQuery>> mQueries;
+
+			std::atomic<TDEngine2::U32>                        mWorldVersion { 1 }; ///< Starts from 1, so the default version of a system treats everything as changed
+
+			std::vector<TDEngine2::U64>                        mDisabledEntitiesMask; ///< A bit per identifier of an entity, a set one means the entity is disabled
+			mutable std::mutex                                 mDisabledEntitiesMutex; ///< Systems could acquire pooled entities concurrently
+	};
+
+
+	/*!
+		\brief The function returns a persistent query over entities which have all of given components
+	*/
+
+	template <typename... TArgs>
+	TDE2_API TCachedComponentsQuery<TArgs...>* GetComponentsQuery(TDEngine2::IWorld* pWorld)
+	{
+		return CComponentsQueriesCache::Get().GetQuery<TArgs...>(pWorld);
+	}
+}
\ No newline at end of file
@@ -59,6 +59,24 @@ class CCustomEngineListener: public TDEngine2::IEngineListener, public TDEngine2
 		*/
 
 		TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+	protected:
+		/*!
+			\brief The method is invoked for each game system before its registration within the world.
+			Derived listeners can wrap the system into some decorator here
+
+			\param[in] pSystem A pointer to a newly created game system
+			\param[in] groupName A name of CSystemsGroup the system is added into, it's empty if the system is registered within the world itself
+
+			\return The method returns a pointer to a system which will be registered instead of the original one
+		*/
+
+		TDE2_API virtual TDEngine2::ISystem* _decorateGameSystem(TDEngine2::ISystem* pSystem, const std::string& groupName);
+
+		/*!
+			\brief The method loads the first level when the engine is started. By default it's a main menu
+		*/
+
+		TDE2_API virtual void _loadInitialLevel();
 	protected:
 		TDEngine2::IEngineCore*                             mpEngineCoreInstance;
 
@@ -76,6 +94,9 @@ class CCustomEngineListener: public TDEngine2::IEngineListener, public TDEngine2
 		
 		TDEngine2::TPtr<TDEngine2::ISceneManager>           mpSceneManager;
 
+		bool                                                mIsParallelSystemsUpdateEnabled = true; ///< If it's false game systems are updated one by one in order of their registration
+		TDEngine2::F32                                      mSystemsGroupsDeltaTime = 0.0f; ///< If it's positive, groups of game systems use it instead of frames' time, see CSystemsGroup::SetDeltaTimeOverride
+
 #if TDE2_EDITORS_ENABLED
 		TDEngine2::TPtr<TDEngine2::IEditorWindow>           mpLevelsEditor;
 #endif
@@ -0,0 +1,218 @@
+/*!
+	\file CEntitiesPool.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Game
+{
+	class CEntitiesPool;
+
+
+	/*!
+		struct TEntitiesPoolStatistics
+
+		\brief The structure describes a state of a single prefab's pool
+	*/
+
+	typedef struct TEntitiesPoolStatistics
+	{
+		std::string    mPrefabId;
+		TDEngine2::U32 mPrewarmedCount = 0;
+		TDEngine2::U32 mActiveCount = 0;
+		TDEngine2::U32 mFreeCount = 0;
+		TDEngine2::U32 mHighWaterMark = 0; ///< The maximum number of simultaneously active entities since the last reset
+	} TEntitiesPoolStatistics, *TEntitiesPoolStatisticsPtr;
+
+
+	/*!
+		\brief A factory function for creation objects of CEntitiesPool's type
+
+		\param[in, out] pSceneManager A pointer to ISceneManager implementation
+		\param[in, out] pEventManager A pointer to IEventManager implementation
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CEntitiesPool's implementation
+	*/
+
+	TDE2_API CEntitiesPool* CreateEntitiesPool(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CEntitiesPool
+
+		\brief The class stores instances of prefabs which are spawned and destroyed often (projectiles, balls, power ups).
+		A released entity is deactivated instead of being destroyed, so the next Acquire just activates it again.
+		All pooled entities belong to the current game level. When a new level is loaded the pools are reset and
+		prewarmed according to CLevelSettings of that level. New instances are spawned from CPrefabTemplatesCache.
+
+		Entities of a prefab with a parking offset aren't deactivated. A free one is disabled for components
+		queries and shifted by that offset, so neither releasing nor acquiring it adds or removes components
+	*/
+
+	class CEntitiesPool : public TDEngine2::CBaseObject, public TDEngine2::IEventHandler
+	{
+		public:
+			friend TDE2_API CEntitiesPool* CreateEntitiesPool(TDEngine2::TPtr<TDEngine2::ISceneManager>, TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_REGISTER_TYPE(CEntitiesPool)
+
+			/*!
+				\brief The method initializes an inner state of a pool
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			/*!
+				\brief The method spawns inactive instances of the prefab until the pool contains at least count free entities
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Prewarm(const std::string& prefabId, TDEngine2::U32 count);
+
+			/*!
+				\brief The method remembers the prefab that should be prewarmed on loading of every level in addition to
+				CLevelSettings. The larger count is used when both specify the same prefab
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE AddPrewarmRequest(const std::string& prefabId, TDEngine2::U32 count);
+
+			/*!
+				\brief The method makes the pool park free entities of the prefab instead of deactivating them. A parked entity is
+				shifted by the offset and gets its position back when it's acquired. Only the root of an instance is disabled,
+				so it suits prefabs of a single entity. The setting is kept between levels
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE SetParkingOffset(const std::string& prefabId, const TDEngine2::TVector3& offset);
+
+			/*!
+				\brief The method returns an active instance of the prefab. A new one is spawned only if the pool is empty
+
+				\return A pointer to the entity or nullptr if the prefab can't be spawned
+			*/
+
+			TDE2_API TDEngine2::CEntity* Acquire(const std::string& prefabId);
+
+			/*!
+				\brief The method returns count active instances of the prefab. Free ones are reused first, the rest
+				are spawned together from the prefab's template
+
+				\param[in] positions Positions of the instances, either empty or exactly count items
+				\param[out] entities Acquired entities are appended into the array
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE AcquireBatch(const std::string& prefabId, TDEngine2::U32 count, const std::vector<TDEngine2::TVector3>& positions,
+				std::vector<TDEngine2::CEntity*>& entities);
+
+			/*!
+				\brief The method deactivates the entity and returns it back into its pool. Entities that weren't
+				created with Acquire or Prewarm are destroyed. Should not be called while systems iterate over components
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Release(TDEngine2::TEntityId entityId);
+
+			/*!
+				\brief The method forgets all pooled entities and writes statistics of the pools into the log
+			*/
+
+			TDE2_API void Reset();
+
+			TDE2_API bool IsPooled(TDEngine2::TEntityId entityId) const;
+
+			TDE2_API std::vector<TEntitiesPoolStatistics> GetStatistics() const;
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CEntitiesPool)
+
+			TDE2_API TDEngine2::E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API TDEngine2::IScene* _getCurrLevelScene() const;
+
+			TDE2_API TDEngine2::TSceneId _getCurrLevelSceneId() const;
+
+			TDE2_API TDEngine2::U32 _getOrCreatePoolIndex(const std::string& prefabId);
+
+			TDE2_API void _pushFreeEntity(TDEngine2::U32 poolIndex, TDEngine2::TEntityId entityId);
+			TDE2_API void _removeFreeEntity(TDEngine2::U32 poolIndex, TDEngine2::TEntityId entityId);
+
+			TDE2_API TDEngine2::CEntity* _acquireFreeEntity(TDEngine2::U32 poolIndex);
+
+			TDE2_API void _markEntityActive(TDEngine2::U32 poolIndex, TDEngine2::TEntityId entityId);
+
+			TDE2_API TDEngine2::E_RESULT_CODE _parkEntity(TDEngine2::U32 poolIndex, TDEngine2::TEntityId entityId);
+			TDE2_API TDEngine2::E_RESULT_CODE _unparkEntity(TDEngine2::U32 poolIndex, TDEngine2::TEntityId entityId);
+
+			TDE2_API void _prewarmPools();
+		private:
+			typedef struct TPrefabPool
+			{
+				std::string                       mPrefabId;
+				std::vector<TDEngine2::TEntityId> mFreeEntities;
+
+				TDEngine2::U32                    mPrewarmedCount = 0;
+				TDEngine2::U32                    mActiveCount = 0;
+				TDEngine2::U32                    mHighWaterMark = 0;
+
+				bool                              mIsParked = false;
+				TDEngine2::TVector3               mParkingOffset;
+			} TPrefabPool;
+
+			typedef struct TPooledEntityInfo
+			{
+				TDEngine2::U32 mPoolIndex;
+				TDEngine2::U32 mFreeSlotIndex; ///< An index within mFreeEntities, it's valid only when mIsActive is false
+				bool           mIsActive;
+			} TPooledEntityInfo;
+		private:
+			TDEngine2::TPtr<TDEngine2::ISceneManager>                   mpSceneManager = nullptr;
+			TDEngine2::TPtr<TDEngine2::IEventManager>                   mpEventManager = nullptr;
+			TDEngine2::TPtr<TDEngine2::IWorld>                          mpWorld = nullptr;
+
+			std::vector<TPrefabPool>                                    mPools;
+			std::unordered_map<std::string, TDEngine2::U32>             mPoolsIndices;
+			std::unordered_map<TDEngine2::TEntityId, TPooledEntityInfo> mEntitiesInfo;
+
+			std::unordered_map<std::string, TDEngine2::U32>             mPrewarmRequests;
+			std::unordered_map<std::string, TDEngine2::TVector3>        mParkingOffsets;
+
+			std::vector<TDEngine2::CEntity*>                            mSpawnedEntities;
+			std::vector<TDEngine2::TVector3>                            mSpawnPositions;
+	};
+}
\ No newline at end of file
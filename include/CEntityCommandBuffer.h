@@ -0,0 +1,175 @@
+/*!
+	\file CEntityCommandBuffer.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CEntitiesPool.h"
+#include <mutex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+
+
+namespace Game
+{
+	class CEntityCommandBuffer;
+
+
+	enum class E_ENTITY_COMMAND_TYPE : TDEngine2::U8
+	{
+		DESTROY,
+		ADD_COMPONENT,
+		REMOVE_COMPONENT,
+		REPARENT,
+		SPAWN_PREFAB,
+	};
+
+
+	/*!
+		enum class TCommandStreamId
+
+		\brief An identifier of a stream of CEntityCommandBuffer. Every system that records commands owns its stream
+	*/
+
+	enum class TCommandStreamId : TDEngine2::U32 { Invalid = (std::numeric_limits<TDEngine2::U32>::max)() };
+
+
+	/*!
+		struct TEntityCommand
+
+		\brief The structure describes a single recorded structural change. It's a POD type, so recording
+		doesn't allocate anything except a growth of the buffer's storage
+	*/
+
+	typedef struct TEntityCommand
+	{
+		E_ENTITY_COMMAND_TYPE mType;
+		TDEngine2::TEntityId  mEntityId;        ///< A target entity, it's unused for SPAWN_PREFAB
+		TDEngine2::TEntityId  mParentEntityId;  ///< Used by REPARENT and SPAWN_PREFAB, TEntityId::Invalid means the scene's root
+		TDEngine2::TypeId     mComponentTypeId; ///< Used by ADD_COMPONENT and REMOVE_COMPONENT
+		TDEngine2::U32        mPrefabIndex;     ///< An index within the buffer's table of prefabs identifiers
+	} TEntityCommand, *TEntityCommandPtr;
+
+
+	/*!
+		\brief A factory function for creation objects of CEntityCommandBuffer's type
+
+		\param[in, out] pWorld A pointer to IWorld implementation
+		\param[in, out] pEntitiesPool A pointer to CEntitiesPool, destroyed entities are returned there
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CEntityCommandBuffer's implementation
+	*/
+
+	TDE2_API CEntityCommandBuffer* CreateEntityCommandBuffer(TDEngine2::TPtr<TDEngine2::IWorld> pWorld, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CEntityCommandBuffer
+
+		\brief The class records structural changes of the world which can't be applied while systems iterate over
+		components. Every recording system owns a stream, so systems that run concurrently don't share anything and
+		don't have to declare an access to the buffer. The buffer is played back once per frame by CEntityCommandBufferSystem.
+		Streams are merged in order of their creation, so the result doesn't depend on the systems' scheduling.
+		Destroys are sorted and coalesced, and all other commands that target destroyed entities are dropped
+	*/
+
+	class CEntityCommandBuffer : public TDEngine2::CBaseObject
+	{
+		public:
+			friend TDE2_API CEntityCommandBuffer* CreateEntityCommandBuffer(TDEngine2::TPtr<TDEngine2::IWorld>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_REGISTER_TYPE(CEntityCommandBuffer)
+
+			/*!
+				\brief The method initializes an inner state of a buffer
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IWorld> pWorld, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool);
+
+			/*!
+				\brief The method creates a new stream. It should be called when a system is initialized, the order of calls
+				defines the order of playback of streams
+
+				\return An identifier of the stream
+			*/
+
+			TDE2_API TCommandStreamId CreateStream();
+
+			/*!
+				\brief The method records destruction of the entity. Pooled entities are returned back into their pools
+			*/
+
+			TDE2_API void Destroy(TCommandStreamId streamId, TDEngine2::TEntityId entityId);
+
+			TDE2_API void AddComponent(TCommandStreamId streamId, TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId);
+			TDE2_API void RemoveComponent(TCommandStreamId streamId, TDEngine2::TEntityId entityId, TDEngine2::TypeId componentTypeId);
+
+			/*!
+				\brief The method records attachment of the entity to a new parent
+
+				\param[in] streamId An identifier of the caller's stream
+				\param[in] parentEntityId An identifier of the parent, TEntityId::Invalid detaches the entity
+				\param[in] childEntityId An identifier of the entity
+			*/
+
+			TDE2_API void Reparent(TCommandStreamId streamId, TDEngine2::TEntityId parentEntityId, TDEngine2::TEntityId childEntityId);
+
+			/*!
+				\brief The method records acquisition of the prefab's instance from CEntitiesPool
+
+				\param[in] streamId An identifier of the caller's stream
+				\param[in] prefabId An identifier of the prefab
+				\param[in] parentEntityId An identifier of the parent, TEntityId::Invalid means the scene's root
+			*/
+
+			TDE2_API void SpawnPrefab(TCommandStreamId streamId, const std::string& prefabId, TDEngine2::TEntityId parentEntityId = TDEngine2::TEntityId::Invalid);
+
+			/*!
+				\brief The method applies all recorded commands and clears the buffer. Commands that are recorded during
+				the playback are postponed until the next one
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Playback();
+
+			TDE2_API bool IsEmpty() const;
+		protected:
+			typedef struct TCommandStream
+			{
+				/// \note A stream is written by a single system, but its event handlers could be invoked from threads of different emitters
+				std::mutex                      mMutex;
+
+				std::vector<TEntityCommand>     mCommands;
+				std::vector<std::string>        mPrefabsIds;
+			} TCommandStream, *TCommandStreamPtr;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CEntityCommandBuffer)
+
+			TDE2_API void _record(TCommandStreamId streamId, const TEntityCommand& command);
+
+			TDE2_API TCommandStream* _getStream(TCommandStreamId streamId) const;
+
+			TDE2_API TDEngine2::E_RESULT_CODE _execute(const TEntityCommand& command);
+		private:
+			TDEngine2::TPtr<TDEngine2::IWorld>            mpWorld = nullptr;
+			TDEngine2::TPtr<CEntitiesPool>                mpEntitiesPool = nullptr;
+
+			/// \note Streams are created only while systems are registered, so recording doesn't lock the array itself
+			std::vector<std::unique_ptr<TCommandStream>>  mStreams;
+
+			/// \note Buffers of the playback are reused between frames
+			std::vector<TEntityCommand>                   mPendingCommands;
+			std::vector<std::string>                      mPendingPrefabsIds;
+			std::vector<TDEngine2::TEntityId>             mDestroyedEntities;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*!
+	\file CEntityHandles.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <unordered_map>
+#include <limits>
+
+
+namespace Game
+{
+	/*!
+		enum class TEntityHandle
+
+		\brief A generational reference to an entity. The low half is an index of a slot within CEntityHandlesTable,
+		the high half is a generation of the slot. A handle of a destroyed entity stays stale forever, even if
+		its slot is reused
+	*/
+
+	enum class TEntityHandle : TDEngine2::U64 { Invalid = (std::numeric_limits<TDEngine2::U64>::max)() };
+
+
+	/*!
+		class CEntityHandlesTable
+
+		\brief The class keeps a dense table of slots of entities that game code has resolved. Every slot caches
+		a pointer to the entity and its components, so access through a handle is two array lookups without locks
+		instead of IWorld::FindEntity and CEntity::GetComponent. The cache of a slot is refreshed on ECS events.
+
+		TEntityId based access (IWorld::FindEntity) stays as is, Resolve is the only hashed step here.
+		The table is accessed only from the main thread
+	*/
+
+	class CEntityHandlesTable : public TDEngine2::IEventHandler
+	{
+		public:
+			TDE2_API static CEntityHandlesTable& Get();
+
+			/*!
+				\brief The method subscribes the table to ECS events. Until it's called every handle is invalid
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IWorld> pWorld, TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method returns a handle of the entity, a slot is allocated on the first request
+
+				\return A handle of the entity or TEntityHandle::Invalid if there is no such entity
+			*/
+
+			TDE2_API TEntityHandle Resolve(TDEngine2::TEntityId entityId);
+
+			TDE2_API TDEngine2::CEntity* GetEntity(TEntityHandle handle);
+
+			/*!
+				\return The method returns all components of the entity or an empty array for a stale handle
+			*/
+
+			TDE2_API const std::vector<TDEngine2::IComponent*>& GetComponents(TEntityHandle handle);
+
+			template <typename T>
+			TDE2_API T* GetComponent(TEntityHandle handle)
+			{
+				static const TDEngine2::U32 columnIndex = _registerColumn(T::GetTypeId(), [](TDEngine2::IComponent* pComponent) -> void*
+				{
+					return dynamic_cast<T*>(pComponent);
+				});
+
+				TEntitySlot* pSlot = _getSlot(handle);
+				if (!pSlot)
+				{
+					return nullptr;
+				}
+
+				if (columnIndex >= pSlot->mColumns.size()) /// \note The type was registered after the slot had been filled
+				{
+					_fillSlot(*pSlot);
+				}
+
+				return static_cast<T*>(pSlot->mColumns[columnIndex]);
+			}
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		private:
+			typedef struct TEntitySlot
+			{
+				TDEngine2::TEntityId                 mEntityId = TDEngine2::TEntityId::Invalid;
+				TDEngine2::U32                       mGeneration = 0;
+				bool                                 mIsDirty = true;
+
+				TDEngine2::CEntity*                  mpEntity = nullptr;
+				std::vector<TDEngine2::IComponent*>  mComponents;
+				std::vector<void*>                   mColumns; ///< A component of every registered type, already casted to the type, or nullptr
+			} TEntitySlot, *TEntitySlotPtr;
+
+			typedef void* (*TComponentCaster)(TDEngine2::IComponent*);
+
+			typedef struct TComponentColumn
+			{
+				TDEngine2::U32   mIndex;
+				TComponentCaster mCaster; ///< IComponent is a virtual base, so the cast is done once when a slot is filled
+			} TComponentColumn, *TComponentColumnPtr;
+		private:
+			CEntityHandlesTable() = default;
+			CEntityHandlesTable(const CEntityHandlesTable&) = delete;
+			CEntityHandlesTable& operator= (const CEntityHandlesTable&) = delete;
+
+			TDE2_API TDEngine2::U32 _registerColumn(TDEngine2::TypeId componentTypeId, TComponentCaster caster);
+
+			TDE2_API TEntitySlot* _getSlot(TEntityHandle handle);
+
+			TDE2_API void _fillSlot(TEntitySlot& slot);
+
+			TDE2_API void _releaseSlot(TDEngine2::TEntityId entityId);
+
+			TDE2_API void _reset();
+		private:
+			TDEngine2::TPtr<TDEngine2::IWorld>                         mpWorld = nullptr;
+			TDEngine2::TPtr<TDEngine2::IEventManager>                  mpEventManager = nullptr;
+
+			std::vector<TEntitySlot>                                   mSlots;
+			std::vector<TDEngine2::U32>                                mFreeSlots;
+			std::unordered_map<TDEngine2::TEntityId, TDEngine2::U32>   mSlotsIndices;
+
+			std::unordered_map<TDEngine2::TypeId, TComponentColumn>    mColumns;
+	};
+
+
+	/*!
+		\brief The function returns a component of the entity or nullptr if the handle is stale
+	*/
+
+	template <typename T>
+	TDE2_API T* GetComponent(TEntityHandle handle)
+	{
+		return CEntityHandlesTable::Get().GetComponent<T>(handle);
+	}
+}
\ No newline at end of file
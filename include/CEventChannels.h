@@ -0,0 +1,335 @@
+/*!
+	\file CEventChannels.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+
+
+namespace Game
+{
+	enum class TEventSubscriptionId : TDEngine2::U32 { Invalid = (std::numeric_limits<TDEngine2::U32>::max)() };
+
+
+	/*!
+		class CEventChannels
+
+		\brief The class dispatches game events through typed channels. Every event's type gets its own list
+		of handlers which index is assigned once per process, so dispatching neither scans all listeners
+		nor casts an event to find out whether it's relevant as IEventManager::Notify does.
+
+		Notify invokes handlers right away on the calling thread. Post puts an event into a buffer of
+		the calling thread, so workers never touch handlers. Posted events are handled by Flush on the main
+		thread at sync points: between waves of CSystemsGroup and before CEntityCommandBuffer's playback.
+		Events of a thread are handled in order they were posted.
+
+		Handlers are subscribed and unsubscribed only on the main thread while no systems are being updated
+	*/
+
+	class CEventChannels
+	{
+		public:
+			template <typename TEvent>
+			using TEventHandler = std::function<void(const TEvent&)>;
+		public:
+			TDE2_API static CEventChannels& Get();
+
+			/*!
+				\brief The method removes all handlers and drops events that haven't been handled yet
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method registers a handler of events of TEvent type. It's safe to call the method
+				from a handler, a new handler receives only next events
+
+				\return An identifier that's passed into Unsubscribe or TEventSubscriptionId::Invalid
+			*/
+
+			template <typename TEvent>
+			TDE2_API TEventSubscriptionId Subscribe(const TEventHandler<TEvent>& handler)
+			{
+				if (!handler)
+				{
+					return TEventSubscriptionId::Invalid;
+				}
+
+				const TEventSubscriptionId subscriptionId = static_cast<TEventSubscriptionId>(mNextSubscriptionId++);
+
+				_getChannel<TEvent>().Subscribe(subscriptionId, handler);
+
+				return subscriptionId;
+			}
+
+			/*!
+				\brief The method removes a handler. It's safe to call the method from any handler including the removed one
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			template <typename TEvent>
+			TDE2_API TDEngine2::E_RESULT_CODE Unsubscribe(TEventSubscriptionId subscriptionId)
+			{
+				if (TEventSubscriptionId::Invalid == subscriptionId)
+				{
+					return TDEngine2::RC_INVALID_ARGS;
+				}
+
+				return _getChannel<TEvent>().Unsubscribe(subscriptionId) ? TDEngine2::RC_OK : TDEngine2::RC_FAIL;
+			}
+
+			/*!
+				\brief The method invokes all handlers of TEvent type on the calling thread
+			*/
+
+			template <typename TEvent>
+			TDE2_API void Notify(const TEvent& event)
+			{
+				const TDEngine2::U32 channelIndex = _getChannelIndex<TEvent>();
+
+				if (channelIndex < mChannels.size() && mChannels[channelIndex])
+				{
+					static_cast<TEventChannel<TEvent>*>(mChannels[channelIndex].get())->Dispatch(event);
+				}
+			}
+
+			/*!
+				\brief The method defers the event till the next Flush. The method could be called from any thread
+			*/
+
+			template <typename TEvent>
+			TDE2_API void Post(const TEvent& event)
+			{
+				const TDEngine2::U32 channelIndex = _getChannelIndex<TEvent>();
+
+				TThreadQueue& queue = _getThreadQueue();
+
+				if (channelIndex >= queue.mBuffers.size())
+				{
+					queue.mBuffers.resize(channelIndex + 1);
+				}
+
+				std::unique_ptr<TBaseEventsBuffer>& pBuffer = queue.mBuffers[channelIndex];
+				if (!pBuffer)
+				{
+					pBuffer = std::make_unique<TEventsBuffer<TEvent>>();
+				}
+
+				std::vector<TEvent>& events = static_cast<TEventsBuffer<TEvent>*>(pBuffer.get())->mEvents;
+
+				queue.mRecords.push_back({ channelIndex, static_cast<TDEngine2::U32>(events.size()) });
+				events.push_back(event);
+			}
+
+			/*!
+				\brief The method handles all posted events on the calling thread which should be the main one.
+				Events which are posted by handlers are handled too
+			*/
+
+			TDE2_API void Flush();
+		private:
+			class TBaseEventChannel
+			{
+				public:
+					virtual ~TBaseEventChannel() = default;
+			};
+
+			template <typename TEvent>
+			class TEventChannel : public TBaseEventChannel
+			{
+				public:
+					void Subscribe(TEventSubscriptionId subscriptionId, const TEventHandler<TEvent>& handler)
+					{
+						/// \note The array isn't resized while it's iterated
+						(mDispatchDepth ? mPendingHandlers : mHandlers).push_back({ subscriptionId, handler, false });
+					}
+
+					bool Unsubscribe(TEventSubscriptionId subscriptionId)
+					{
+						for (std::vector<THandlerEntry>* pHandlers : { &mHandlers, &mPendingHandlers })
+						{
+							for (THandlerEntry& currEntry : *pHandlers)
+							{
+								if (currEntry.mId != subscriptionId || currEntry.mIsRemoved)
+								{
+									continue;
+								}
+
+								/// \note The entry is erased after dispatching, because the handler could be the one which is executed now
+								currEntry.mIsRemoved = true;
+								mHasRemovedHandlers = true;
+
+								if (!mDispatchDepth)
+								{
+									_compact();
+								}
+
+								return true;
+							}
+						}
+
+						return false;
+					}
+
+					void Dispatch(const TEvent& event)
+					{
+						++mDispatchDepth;
+
+						for (const THandlerEntry& currEntry : mHandlers)
+						{
+							if (!currEntry.mIsRemoved)
+							{
+								currEntry.mHandler(event);
+							}
+						}
+
+						if (!--mDispatchDepth && (mHasRemovedHandlers || !mPendingHandlers.empty()))
+						{
+							_compact();
+						}
+					}
+				private:
+					typedef struct THandlerEntry
+					{
+						TEventSubscriptionId  mId;
+						TEventHandler<TEvent> mHandler;
+						bool                  mIsRemoved;
+					} THandlerEntry;
+				private:
+					void _compact()
+					{
+						mHandlers.insert(mHandlers.end(), mPendingHandlers.begin(), mPendingHandlers.end());
+						mPendingHandlers.clear();
+
+						mHandlers.erase(std::remove_if(mHandlers.begin(), mHandlers.end(), [](const THandlerEntry& entry) { return entry.mIsRemoved; }), mHandlers.end());
+						mHasRemovedHandlers = false;
+					}
+				private:
+					std::vector<THandlerEntry> mHandlers;
+					std::vector<THandlerEntry> mPendingHandlers;
+
+					std::atomic<TDEngine2::U32> mDispatchDepth { 0 }; ///< Workers could notify the channel concurrently
+					bool                       mHasRemovedHandlers = false;
+			};
+
+			class TBaseEventsBuffer
+			{
+				public:
+					virtual ~TBaseEventsBuffer() = default;
+
+					virtual void Dispatch(CEventChannels& channels, TDEngine2::U32 eventIndex) = 0;
+					virtual void Clear() = 0;
+			};
+
+			template <typename TEvent>
+			class TEventsBuffer : public TBaseEventsBuffer
+			{
+				public:
+					void Dispatch(CEventChannels& channels, TDEngine2::U32 eventIndex) override
+					{
+						/// \note A copy is taken, because a handler could post an event of the same type
+						const TEvent event = mEvents[eventIndex];
+						channels.Notify<TEvent>(event);
+					}
+
+					void Clear() override
+					{
+						mEvents.clear(); /// \note The capacity is kept, so a steady stream of events doesn't allocate
+					}
+				public:
+					std::vector<TEvent> mEvents;
+			};
+
+			typedef struct TPostedEventRecord
+			{
+				TDEngine2::U32 mChannelIndex;
+				TDEngine2::U32 mEventIndex;
+			} TPostedEventRecord;
+
+			typedef struct TThreadQueue
+			{
+				std::vector<TPostedEventRecord>                 mRecords; ///< Keeps the order of events of different types
+				std::vector<std::unique_ptr<TBaseEventsBuffer>> mBuffers; ///< A buffer per channel
+			} TThreadQueue;
+		private:
+			CEventChannels() = default;
+			CEventChannels(const CEventChannels&) = delete;
+			CEventChannels& operator= (const CEventChannels&) = delete;
+
+			template <typename TEvent>
+			TEventChannel<TEvent>& _getChannel()
+			{
+				const TDEngine2::U32 channelIndex = _getChannelIndex<TEvent>();
+
+				if (channelIndex >= mChannels.size())
+				{
+					mChannels.resize(channelIndex + 1);
+				}
+
+				std::unique_ptr<TBaseEventChannel>& pChannel = mChannels[channelIndex];
+				if (!pChannel)
+				{
+					pChannel = std::make_unique<TEventChannel<TEvent>>();
+				}
+
+				return *static_cast<TEventChannel<TEvent>*>(pChannel.get());
+			}
+
+			template <typename TEvent>
+			static TDEngine2::U32 _getChannelIndex()
+			{
+				static const TDEngine2::U32 channelIndex = _allocateChannelIndex();
+				return channelIndex;
+			}
+
+			TDE2_API static TDEngine2::U32 _allocateChannelIndex();
+
+			TDE2_API TThreadQueue& _getThreadQueue();
+
+			TDE2_API bool _flushQueue(TThreadQueue& queue);
+		private:
+			std::vector<std::unique_ptr<TBaseEventChannel>> mChannels;
+
+			std::vector<std::unique_ptr<TThreadQueue>>      mThreadQueues; ///< Queues are never released, threads keep pointers to them
+			std::vector<TThreadQueue*>                      mFlushedQueues;
+			std::mutex                                      mThreadQueuesMutex;
+
+			TDEngine2::U32                                  mNextSubscriptionId = 0;
+	};
+
+
+	/*!
+		\brief The function invokes handlers of TEvent type right away on the calling thread
+	*/
+
+	template <typename TEvent>
+	TDE2_API void NotifyEvent(const TEvent& event)
+	{
+		CEventChannels::Get().Notify<TEvent>(event);
+	}
+
+
+	/*!
+		\brief The function defers the event till the next sync point, it could be called from any thread
+	*/
+
+	template <typename TEvent>
+	TDE2_API void PostEvent(const TEvent& event)
+	{
+		CEventChannels::Get().Post<TEvent>(event);
+	}
+}
\ No newline at end of file
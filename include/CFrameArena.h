@@ -0,0 +1,158 @@
+/*!
+	\file CFrameArena.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CAllocationProfiler.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+
+
+namespace Game
+{
+	/*!
+		class CFrameArena
+
+		\brief The class is a scratch memory for transient data of a frame. There are two buffers, the current one
+		is filled during a frame and becomes the previous one at its end, so the data stays valid until the end of the next
+		frame (e.g. for the render stage). Nothing is deallocated individually, the buffer is reset as a whole.
+
+		Each thread takes chunks of the buffer with an atomic cursor and bumps within its own chunk without any
+		synchronization, so it could be used by systems and jobs of worker threads. Requests that don't fit into
+		the buffer return nullptr, TFrameAllocator falls back to the heap in that case
+	*/
+
+	class CFrameArena
+	{
+		public:
+			static constexpr TDEngine2::USIZE DefaultCapacity = 1 << 20; ///< A size of a single buffer in bytes
+			static constexpr TDEngine2::USIZE ThreadChunkSize = 16 * 1024;
+		public:
+			TDE2_API static CFrameArena& Get();
+
+			/*!
+				\brief The method allocates both buffers
+
+				\param[in] capacity A size of each buffer in bytes
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::USIZE capacity = DefaultCapacity);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method returns a block of the current frame's buffer. It's safe to call from any thread
+
+				\return A pointer to a memory block, nullptr if the arena isn't initialized or the buffer is exhausted
+			*/
+
+			TDE2_API void* Allocate(TDEngine2::USIZE size, TDEngine2::USIZE alignment);
+
+			/*!
+				\brief The method swaps the buffers and resets the one which will be filled next. It should be called
+				once at the end of a frame by the main thread, while no jobs use the arena
+			*/
+
+			TDE2_API void EndFrame();
+
+			TDE2_API bool Owns(const void* pPtr) const;
+
+			/*!
+				\brief The method returns a size of the buffer, which was used by the last completed frame.
+				Whole chunks of threads are counted
+			*/
+
+			TDE2_API TDEngine2::USIZE GetLastFrameUsedSize() const;
+
+			TDE2_API TDEngine2::USIZE GetPeakUsedSize() const;
+
+			/*!
+				\brief The method returns a number of allocations that didn't fit into the buffer since the last frame
+			*/
+
+			TDE2_API TDEngine2::U32 GetLastFrameOverflowsCount() const;
+
+			TDE2_API TDEngine2::USIZE GetCapacity() const;
+		private:
+			struct TFrameBuffer
+			{
+				std::unique_ptr<TDEngine2::U8[]> mpMemory;
+				std::atomic<TDEngine2::USIZE>    mUsedSize { 0 };
+			};
+		private:
+			CFrameArena() = default;
+			CFrameArena(const CFrameArena&) = delete;
+			CFrameArena& operator= (const CFrameArena&) = delete;
+
+			TDE2_API TDEngine2::U8* _acquireChunk(TDEngine2::USIZE size);
+		private:
+			TFrameBuffer                 mBuffers[2];
+
+			TDEngine2::USIZE             mCapacity = 0;
+
+			std::atomic<TDEngine2::U32>  mFrameIndex { 0 }; ///< Thread cursors of previous frames are discarded by comparison with it
+			std::atomic<TDEngine2::U32>  mOverflowsCount { 0 };
+
+			TDEngine2::USIZE             mLastFrameUsedSize = 0;
+			TDEngine2::USIZE             mPeakUsedSize = 0;
+			TDEngine2::U32               mLastFrameOverflowsCount = 0;
+
+			const TDEngine2::U32         mProfilerAllocatorId = CAllocationProfiler::Get().RegisterAllocator("frame-arena");
+	};
+
+
+	/*!
+		class TFrameAllocator
+
+		\brief STL compatible allocator over CFrameArena. Containers which use it should not outlive the next frame,
+		their deallocation is a no-op unless the memory was taken from the heap
+	*/
+
+	template <typename T>
+	class TFrameAllocator
+	{
+		public:
+			typedef T value_type;
+		public:
+			TFrameAllocator() = default;
+
+			template <typename U>
+			TFrameAllocator(const TFrameAllocator<U>&) {}
+
+			T* allocate(std::size_t count)
+			{
+				if (void* pPtr = CFrameArena::Get().Allocate(count * sizeof(T), alignof(T)))
+				{
+					return static_cast<T*>(pPtr);
+				}
+
+				return static_cast<T*>(::operator new(count * sizeof(T)));
+			}
+
+			void deallocate(T* pPtr, std::size_t)
+			{
+				if (!CFrameArena::Get().Owns(pPtr))
+				{
+					::operator delete(pPtr);
+				}
+			}
+	};
+
+	template <typename T, typename U>
+	bool operator== (const TFrameAllocator<T>&, const TFrameAllocator<U>&) { return true; }
+
+	template <typename T, typename U>
+	bool operator!= (const TFrameAllocator<T>&, const TFrameAllocator<U>&) { return false; }
+
+
+	template <typename T>
+	using TFrameVector = std::vector<T, TFrameAllocator<T>>;
+}
\ No newline at end of file
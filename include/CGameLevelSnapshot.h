@@ -0,0 +1,87 @@
+/*!
+	\file CGameLevelSnapshot.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+namespace Game
+{
+	/*!
+		class CGameLevelSnapshot
+
+		\brief The class stores a copy of the level's initial state which is taken right after the level is loaded.
+		Restarting of the level rewinds its entities back to the copy instead of reading the scene's file again.
+		Entities that still exist are reused, so only the values of their components are overwritten.
+		Runtime only components aren't a part of the snapshot. Only a single level is kept at once
+	*/
+
+	class CGameLevelSnapshot
+	{
+		public:
+			TDE2_API static CGameLevelSnapshot& Get();
+
+			/*!
+				\brief The method releases the stored copy, it should be called before the world is destroyed
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method copies all entities of the scene and replaces the previously stored snapshot
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Capture(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TSceneId sceneId);
+
+			/*!
+				\brief The method brings the scene back to the captured state. Entities that were created after the capture
+				are destroyed, the missing ones are recreated with the same identifiers
+
+				\return RC_OK if everything went ok, RC_FAIL if there is no snapshot of the scene
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Restore(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TSceneId sceneId);
+
+			TDE2_API bool HasSnapshot(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TSceneId sceneId) const;
+		private:
+			struct TComponentSnapshot
+			{
+				TDEngine2::TypeId      mTypeId;
+				TDEngine2::IComponent* mpComponent; ///< A detached copy, which isn't registered within the world
+			};
+
+			struct TEntitySnapshot
+			{
+				TDEngine2::TEntityId            mEntityId;
+				std::string                     mName;
+				std::vector<TComponentSnapshot> mComponents;
+			};
+
+			typedef std::unordered_map<TDEngine2::TypeId, TDEngine2::TPtr<TDEngine2::IComponentFactory>> TComponentsFactoriesTable;
+		private:
+			CGameLevelSnapshot() = default;
+			CGameLevelSnapshot(const CGameLevelSnapshot&) = delete;
+			CGameLevelSnapshot& operator= (const CGameLevelSnapshot&) = delete;
+
+			TDE2_API TDEngine2::IComponent* _copyComponent(const TDEngine2::IComponent* pComponent);
+
+			TDE2_API TDEngine2::E_RESULT_CODE _restoreEntity(TDEngine2::IWorld* pWorld, TDEngine2::IScene* pScene, const TEntitySnapshot& entitySnapshot, bool& isReused);
+		private:
+			std::string                  mScenePath;
+			std::vector<TEntitySnapshot> mEntities;
+
+			TComponentsFactoriesTable    mComponentsFactories; ///< Filled on the first capture
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*!
+	\file CGameLevelsCatalog.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CGameLevelsCollection.h"
+#include <limits>
+
+
+namespace Game
+{
+	/*!
+		class CGameLevelsCatalog
+
+		\brief The class keeps CGameLevelsCollection resident and caches an index of the current game level,
+		which is recomputed only once after TGameLevelLoadedEvent. Before Init is called every request loads
+		the collection through the resource manager and resolves the index from scratch
+	*/
+
+	class CGameLevelsCatalog : public TDEngine2::IEventHandler
+	{
+		public:
+			TDE2_API static CGameLevelsCatalog& Get();
+
+			/*!
+				\brief The method loads the collection and subscribes the catalog to TGameLevelLoadedEvent. Game resource
+				types should be registered before
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager,
+				TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			TDE2_API TDEngine2::TPtr<CGameLevelsCollection> GetLevelsCollection(TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager);
+
+			/*!
+				\brief The method returns an index of the currently loaded game level within the collection
+			*/
+
+			TDE2_API TDEngine2::TResult<TDEngine2::USIZE> GetCurrLevelIndex(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager);
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		private:
+			CGameLevelsCatalog() = default;
+			CGameLevelsCatalog(const CGameLevelsCatalog&) = delete;
+			CGameLevelsCatalog& operator= (const CGameLevelsCatalog&) = delete;
+
+			TDE2_API TDEngine2::TResult<TDEngine2::USIZE> _resolveCurrLevelIndex(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<CGameLevelsCollection> pLevelsCollection) const;
+		private:
+			static constexpr TDEngine2::USIZE mInvalidLevelIndex = (std::numeric_limits<TDEngine2::USIZE>::max)();
+
+			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
+			TDEngine2::TPtr<CGameLevelsCollection>    mpLevelsCollection = nullptr;
+
+			TDEngine2::USIZE                          mCurrLevelIndex = mInvalidLevelIndex;
+	};
+}
\ No newline at end of file
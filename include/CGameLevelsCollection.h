@@ -9,6 +9,7 @@
 
 #include <TDEngine2.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -86,6 +87,11 @@ namespace Game
 
 			TDE2_API TDEngine2::E_RESULT_CODE Save(TDEngine2::IArchiveWriter* pWriter) override;
 
+			/*!
+				\brief The method returns an index of the level within the collection. The lookup is hashed,
+				so its cost doesn't depend on the number of levels
+			*/
+
 			TDE2_API TDEngine2::TResult<TDEngine2::USIZE> FindLevelIndex(const std::string& levelPath) const;
 
 			TDE2_API TDEngine2::TResult<std::string> GetLevelPathByIndex(TDEngine2::USIZE index) const;
@@ -101,6 +107,7 @@ namespace Game
 			static constexpr TDEngine2::U16 mVersionTag = 0x1;
 
 			std::vector<std::string> mGameLevels;
+			std::unordered_map<std::string, TDEngine2::USIZE> mLevelsIndices; ///< It's rebuilt together with mGameLevels
 	};
 
 
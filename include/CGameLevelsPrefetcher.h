@@ -0,0 +1,104 @@
+/*!
+	\file CGameLevelsPrefetcher.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <string>
+#include <vector>
+
+
+namespace Game
+{
+	/*!
+		class CGameLevelsPrefetcher
+
+		\brief The class loads the next entry of CGameLevelsCollection in the background while the current level
+		is played. All entities of the staged scene stay inactive until the level is taken with TakePrefetchedLevel.
+		Only a single level is staged at once, a request for another one unloads the previous
+	*/
+
+	class CGameLevelsPrefetcher : public TDEngine2::IEventHandler
+	{
+		public:
+			TDE2_API static CGameLevelsPrefetcher& Get();
+
+			/*!
+				\brief The method subscribes the prefetcher to TGameLevelLoadedEvent, so the next level is requested
+				automatically after each loading
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager,
+				TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method starts asynchronous loading of the level. It does nothing if the level is already staged
+				or being loaded
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Prefetch(const std::string& levelPath);
+
+			/*!
+				\brief The method activates entities of the staged level and returns its identifier. The prefetcher
+				forgets about the scene after that. If the level is still being loaded the request is cancelled
+
+				\return An identifier of the scene or an error if the level isn't staged
+			*/
+
+			TDE2_API TDEngine2::TResult<TDEngine2::TSceneId> TakePrefetchedLevel(const std::string& levelPath);
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		private:
+			enum class E_PREFETCH_STATE : TDEngine2::U8
+			{
+				NONE,
+				LOADING,
+				STAGED,
+			};
+		private:
+			CGameLevelsPrefetcher() = default;
+			CGameLevelsPrefetcher(const CGameLevelsPrefetcher&) = delete;
+			CGameLevelsPrefetcher& operator= (const CGameLevelsPrefetcher&) = delete;
+
+			TDE2_API void _onLevelLoaded(TDEngine2::U32 requestIndex, const TDEngine2::TResult<TDEngine2::TSceneId>& sceneId);
+
+			TDE2_API void _discardLevel();
+		private:
+			TDEngine2::TPtr<TDEngine2::ISceneManager>    mpSceneManager = nullptr;
+			TDEngine2::TPtr<TDEngine2::IResourceManager> mpResourceManager = nullptr;
+			TDEngine2::TPtr<TDEngine2::IEventManager>    mpEventManager = nullptr;
+
+			E_PREFETCH_STATE                             mState = E_PREFETCH_STATE::NONE;
+			TDEngine2::U32                               mRequestIndex = 0; ///< Callbacks of outdated requests compare it with their own one
+			std::string                                  mLevelPath;
+			TDEngine2::TSceneId                          mSceneId = TDEngine2::TSceneId::Invalid;
+
+			std::vector<TDEngine2::TEntityId>            mDeactivatedEntities; ///< Roots of the staged scene's hierarchies
+	};
+}
\ No newline at end of file
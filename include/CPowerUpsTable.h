@@ -0,0 +1,131 @@
+/*!
+	\file CPowerUpsTable.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <string>
+#include <vector>
+
+
+namespace Game
+{
+	class CPowerUpsTable;
+
+
+	/*!
+		struct TPowerUpTableEntry
+
+		\brief The structure describes a single kind of power ups that could be dropped by a brick
+	*/
+
+	typedef struct TPowerUpTableEntry
+	{
+		TDEngine2::TypeId mPowerUpTypeId = TDEngine2::TypeId::Invalid; ///< A type of the bonus component which the prefab should contain
+		TDEngine2::F32    mWeight = 0.0f;
+		std::string       mPrefabId;
+		TDEngine2::U32    mPrewarmCount = 1; ///< The number of instances that are spawned in advance on each level's loading
+	} TPowerUpTableEntry, *TPowerUpTableEntryPtr;
+
+
+	/*!
+		\brief A factory function for creation objects of CPowerUpsTable's type
+
+		\param[in, out] pResourceManager A pointer to IResourceManager's implementation
+		\param[in] name A resource's name
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CPowerUpsTable's implementation
+	*/
+
+	TDE2_API CPowerUpsTable* CreatePowerUpsTable(TDEngine2::IResourceManager* pResourceManager, const std::string& name, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CPowerUpsTable
+
+		\brief The class contains weights of all power ups. An alias table is built on loading,
+		so sampling costs O(1) regardless of the number of entries
+	*/
+
+	class CPowerUpsTable : public TDEngine2::CBaseResource, public TDEngine2::ISerializable
+	{
+		public:
+			friend TDE2_API CPowerUpsTable* CreatePowerUpsTable(TDEngine2::IResourceManager*, const std::string&, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_REGISTER_RESOURCE_TYPE(CPowerUpsTable)
+			TDE2_REGISTER_TYPE(CPowerUpsTable)
+
+			/*!
+				\brief The method initializes an internal state of a table
+
+				\param[in, out] pResourceManager A pointer to IResourceManager's implementation
+				\param[in] name A resource's name
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API virtual TDEngine2::E_RESULT_CODE Init(TDEngine2::IResourceManager* pResourceManager, const std::string& name);
+
+			/*!
+				\brief The method resets current internal data of a resource
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Reset() override;
+
+			/*!
+				\brief The method deserializes object's state from given reader
+
+				\param[in, out] pReader An input stream of data that contains information about the object
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Load(TDEngine2::IArchiveReader* pReader) override;
+
+			/*!
+				\brief The method serializes object's state into given stream
+
+				\param[in, out] pWriter An output stream of data that writes information about the object
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Save(TDEngine2::IArchiveWriter* pWriter) override;
+
+			/*!
+				\brief The method picks an entry according to weights
+
+				\param[in] uniformValue A random value within [0; 1) range
+
+				\return A pointer to the entry or nullptr if the table is empty
+			*/
+
+			TDE2_API const TPowerUpTableEntry* Sample(TDEngine2::F32 uniformValue) const;
+
+			TDE2_API const std::vector<TPowerUpTableEntry>& GetEntries() const;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CPowerUpsTable)
+
+			TDE2_API const TDEngine2::TPtr<TDEngine2::IResourceLoader> _getResourceLoader() override;
+
+			TDE2_API void _buildAliasTable();
+		private:
+			static constexpr TDEngine2::U16 mVersionTag = 0x1;
+
+			std::vector<TPowerUpTableEntry> mEntries;
+
+			std::vector<TDEngine2::F32>     mProbabilities; ///< A probability to keep a column's own entry instead of its alias
+			std::vector<TDEngine2::U32>     mAliases;
+	};
+
+
+	TDE2_DECLARE_DEFAULT_RESOURCE_LOADER(PowerUpsTable)
+	TDE2_DECLARE_DEFAULT_RESOURCE_FACTORY(PowerUpsTable)
+}
\ No newline at end of file
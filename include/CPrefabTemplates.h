@@ -0,0 +1,101 @@
+/*!
+	\file CPrefabTemplates.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <limits>
+
+
+namespace Game
+{
+	/*!
+		class CPrefabTemplatesCache
+
+		\brief The class compiles a prefab on the first request into a flat template: entities of its hierarchy in
+		depth-first order with indices of their parents and detached prototypes of their components stored in a single array.
+		Instantiation of a template walks these arrays once per instance instead of resolving the prefab's tree and
+		applying its changes list as IScene::Spawn does. Runtime only components are created by their systems as usual
+	*/
+
+	class CPrefabTemplatesCache
+	{
+		public:
+			TDE2_API static CPrefabTemplatesCache& Get();
+
+			/*!
+				\brief The method releases all templates, it should be called before the world is destroyed
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method creates count instances of the prefab within the scene. The template is compiled
+				on the first call, so an instance is spawned and removed once for that
+
+				\param[in] positions Positions of roots of the instances, either empty or exactly count items
+				\param[out] spawnedEntities Roots of new instances are appended into the array
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE SpawnBatch(TDEngine2::IWorld* pWorld, TDEngine2::IScene* pScene, const std::string& prefabId, TDEngine2::U32 count,
+				const std::vector<TDEngine2::TVector3>& positions, std::vector<TDEngine2::CEntity*>& spawnedEntities);
+
+			TDE2_API bool HasTemplate(const std::string& prefabId) const;
+		private:
+			static constexpr TDEngine2::U32 InvalidParentIndex = (std::numeric_limits<TDEngine2::U32>::max)();
+
+			struct TComponentPrototype
+			{
+				TDEngine2::TypeId      mTypeId;
+				TDEngine2::IComponent* mpComponent; ///< A detached copy, which isn't registered within the world
+			};
+
+			struct TTemplateEntity
+			{
+				std::string            mName;
+				TDEngine2::U32         mParentIndex;
+				TDEngine2::U32         mFirstComponentIndex;
+				TDEngine2::U32         mComponentsCount;
+
+				TDEngine2::TVector3    mPosition; ///< CTransform is kept apart, because its copy would reference the hierarchy of the source
+				TDEngine2::TQuaternion mRotation;
+				TDEngine2::TVector3    mScale;
+			};
+
+			struct TPrefabTemplate
+			{
+				std::vector<TTemplateEntity>     mEntities; ///< The root goes first, a parent always precedes its children
+				std::vector<TComponentPrototype> mComponents;
+			};
+
+			typedef std::unordered_map<TDEngine2::TypeId, TDEngine2::TPtr<TDEngine2::IComponentFactory>> TComponentsFactoriesTable;
+		private:
+			CPrefabTemplatesCache() = default;
+			CPrefabTemplatesCache(const CPrefabTemplatesCache&) = delete;
+			CPrefabTemplatesCache& operator= (const CPrefabTemplatesCache&) = delete;
+
+			TDE2_API const TPrefabTemplate* _getOrCompileTemplate(TDEngine2::IWorld* pWorld, TDEngine2::IScene* pScene, const std::string& prefabId);
+
+			TDE2_API TDEngine2::IComponent* _copyComponent(const TDEngine2::IComponent* pComponent);
+
+			TDE2_API TDEngine2::E_RESULT_CODE _instantiate(TDEngine2::IWorld* pWorld, TDEngine2::IScene* pScene, const TPrefabTemplate& prefabTemplate,
+				const TDEngine2::TVector3* pRootPosition);
+		private:
+			std::unordered_map<std::string, TPrefabTemplate> mTemplates;
+
+			TComponentsFactoriesTable                        mComponentsFactories; ///< Filled on the first compilation
+
+			std::vector<TDEngine2::CEntity*>                 mInstanceEntities; ///< Entities of the instance that's being created, indexed as the template's ones
+	};
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+/*!
+	\file CSceneArenas.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CComponentPoolAllocPolicy.h"
+#include "CAllocationProfiler.h"
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+
+
+namespace Game
+{
+	/*!
+		struct TSceneArenaStatistics
+
+		\brief The structure describes memory of a single scene's arena
+	*/
+
+	typedef struct TSceneArenaStatistics
+	{
+		TDEngine2::TSceneId mSceneId;
+		TDEngine2::USIZE    mReservedMemorySize; ///< Sum of sizes of all pages
+		TDEngine2::USIZE    mUsedMemorySize;
+		TDEngine2::U32      mLiveObjectsCount;
+		bool                mIsReleased; ///< True if the scene is unloaded, but some of its objects are still alive
+	} TSceneArenaStatistics;
+
+
+	/*!
+		class CSceneArenas
+
+		\brief The class owns a bump arena per scene. Objects that derive CSceneArenaAllocPolicy and are created within
+		TSceneArenaScope are placed into the arena of the scope's scene. Their deletion only decrements a counter,
+		pages of the arena are returned wholesale when the scene is released and the last of its objects is deleted.
+		Objects that are created outside of any scope fall back to the pool allocator of their type.
+
+		The arena's id is written before each object, so the object could be deleted from any thread
+	*/
+
+	class CSceneArenas
+	{
+		public:
+			typedef std::function<void(const void*, TDEngine2::USIZE, bool)> TAllocationsListener; ///< A pointer, a size (0 for deallocations) and whether it's an allocation
+
+			static constexpr TDEngine2::USIZE HeaderSize = 16; ///< Also the maximal alignment of objects
+			static constexpr TDEngine2::USIZE DefaultPageSize = 64 * 1024;
+		public:
+			TDE2_API static CSceneArenas& Get();
+
+			/*!
+				\brief The method releases all arenas, pages of ones that still have live objects are returned
+				when the last of them is deleted
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method detaches the arena from the scene. Its pages are returned right away if there are
+				no live objects within it. A new arena is created if the scene's id is reused later
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE ReleaseScene(TDEngine2::TSceneId sceneId);
+
+			/*!
+				\brief The method allocates memory either within the arena of the current scope or with the given allocator
+
+				\param[in] size A size of an object
+				\param[in] pFallbackAllocator An allocator for blocks of (size + HeaderSize) bytes aligned by HeaderSize
+
+				\return A pointer to a memory block, nullptr if the allocation has failed
+			*/
+
+			TDE2_API void* Allocate(TDEngine2::USIZE size, TDEngine2::IAllocator* pFallbackAllocator);
+
+			TDE2_API void Deallocate(void* pObjectPtr, TDEngine2::IAllocator* pFallbackAllocator);
+
+			TDE2_API std::vector<TSceneArenaStatistics> GetStatistics() const;
+
+			TDE2_API TDEngine2::E_RESULT_CODE SetPageSize(TDEngine2::USIZE pageSize);
+
+			/*!
+				\brief The listener is invoked for each allocation and deallocation of objects, no matter where they're placed.
+				It's used to record allocation traces, so it should be set by the main thread while nothing is spawned
+			*/
+
+			TDE2_API void SetAllocationsListener(const TAllocationsListener& listener);
+		private:
+			friend class TSceneArenaScope;
+
+			struct TArena
+			{
+				TDEngine2::TSceneId         mSceneId;
+				std::vector<TDEngine2::U8*> mPages;
+				TDEngine2::USIZE            mCurrPageOffset = 0; ///< An offset within the last page
+				TDEngine2::USIZE            mCurrPageSize = 0;
+				TDEngine2::USIZE            mReservedMemorySize = 0;
+				TDEngine2::USIZE            mUsedMemorySize = 0;
+				TDEngine2::U32              mLiveObjectsCount = 0;
+				bool                        mIsReleased = false;
+			};
+
+			typedef std::unordered_map<TDEngine2::U32, TArena> TArenasTable;
+		private:
+			CSceneArenas() = default;
+			CSceneArenas(const CSceneArenas&) = delete;
+			CSceneArenas& operator= (const CSceneArenas&) = delete;
+
+			TDE2_API TDEngine2::U32 _getOrCreateArena(TDEngine2::TSceneId sceneId);
+
+			TDE2_API void* _allocateFromArena(TArena& arena, TDEngine2::USIZE size);
+
+			TDE2_API void _destroyArena(TArenasTable::iterator arenaIt);
+		private:
+			static constexpr TDEngine2::U32 InvalidArenaId = 0;
+
+			mutable std::mutex                                      mMutex;
+
+			TArenasTable                                            mArenas;
+			std::unordered_map<TDEngine2::TSceneId, TDEngine2::U32> mSceneArenas; ///< Arenas of scenes that aren't released yet
+
+			TDEngine2::U32                                          mNextArenaId = InvalidArenaId + 1;
+			TDEngine2::USIZE                                        mPageSize = DefaultPageSize;
+
+			TAllocationsListener                                    mAllocationsListener = nullptr;
+
+			const TDEngine2::U32                                    mProfilerAllocatorId = CAllocationProfiler::Get().RegisterAllocator("scene-arenas");
+	};
+
+
+	/*!
+		class TSceneArenaScope
+
+		\brief Objects with CSceneArenaAllocPolicy that are created by the current thread within the scope's lifetime
+		are placed into the scene's arena. Scopes could be nested, a scope with TSceneId::Invalid suspends the outer one
+	*/
+
+	class TSceneArenaScope
+	{
+		public:
+			TDE2_API explicit TSceneArenaScope(TDEngine2::TSceneId sceneId);
+			TDE2_API ~TSceneArenaScope();
+
+			TSceneArenaScope(const TSceneArenaScope&) = delete;
+			TSceneArenaScope& operator= (const TSceneArenaScope&) = delete;
+		private:
+			friend class CSceneArenas;
+
+			static thread_local TDEngine2::TSceneId mCurrSceneId;
+
+			TDEngine2::TSceneId mPrevSceneId;
+	};
+
+
+	/*!
+		\brief Derive your type from this below instead of CPoolMemoryAllocPolicy to place its instances into the arena
+		of the scene they're created for. Use GAME_SCENE_ARENA_COMPONENT_BASES for components
+	*/
+
+	template <typename T, TDEngine2::USIZE objectsPerPage = ComponentPoolDefaultObjectsPerPage>
+	class CSceneArenaAllocPolicy
+	{
+		public:
+			TDE2_API static void* operator new(std::size_t size, const std::nothrow_t&) { TDE2_ASSERT(sizeof(T) == size); return CSceneArenas::Get().Allocate(size, _getFallbackAllocator()); }
+
+			TDE2_API static void operator delete(void* pPtr, const std::nothrow_t&) { CSceneArenas::Get().Deallocate(pPtr, _getFallbackAllocator()); }
+			TDE2_API static void operator delete(void* pPtr) { CSceneArenas::Get().Deallocate(pPtr, _getFallbackAllocator()); }
+		private:
+			TDE2_API static TDEngine2::IAllocator* _getFallbackAllocator() noexcept
+			{
+				static_assert(std::is_base_of<CSceneArenaAllocPolicy<T, objectsPerPage>, T>::value, "[CSceneArenaAllocPolicy] The policy should be parametrized with the type's own type");
+				static_assert(sizeof(T) <= ComponentPoolMaxObjectSize, "[CSceneArenaAllocPolicy] The type is too large to be pooled");
+				static_assert(alignof(T) <= CSceneArenas::HeaderSize, "[CSceneArenaAllocPolicy] The type's alignment is greater than the arena's one");
+
+				if (!mpFallbackAllocator)
+				{
+					const TDEngine2::USIZE blockSize = sizeof(T) + CSceneArenas::HeaderSize;
+					mpFallbackAllocator = TDEngine2::CPoolAllocatorsRegistry::GetAllocator(blockSize, CSceneArenas::HeaderSize, GetComponentPoolPageSize(blockSize, objectsPerPage));
+				}
+
+				return mpFallbackAllocator;
+			}
+		private:
+			static TDEngine2::IAllocator* mpFallbackAllocator;
+	};
+
+	template <typename T, TDEngine2::USIZE objectsPerPage> TDEngine2::IAllocator* CSceneArenaAllocPolicy<T, objectsPerPage>::mpFallbackAllocator = nullptr;
+}
+
+
+/*!
+	\brief The same as GAME_POOLED_COMPONENT_BASES, but instances are placed into arenas of scenes
+*/
+
+#define GAME_SCENE_ARENA_COMPONENT_BASES(ComponentName) public ::TDEngine2::CBaseComponent, public ::Game::CSceneArenaAllocPolicy<ComponentName>
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*!
+	\file CSceneStreamer.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <functional>
+#include <vector>
+#include <deque>
+
+
+namespace Game
+{
+	/*!
+		class CSceneStreamer
+
+		\brief The class unloads scenes in slices instead of destroying all their entities within a single frame
+		as ISceneManager::UnloadScene does. Roots of a scene are deactivated right away, so the level disappears
+		immediately, then its entities are removed one by one until the frame's budget is spent. The emptied scene
+		is unloaded with the manager in the end. Scenes are processed in order they were requested.
+
+		The streamer is updated once per frame on the main thread
+	*/
+
+	class CSceneStreamer
+	{
+		public:
+			static constexpr TDEngine2::U32 DefaultFrameBudget = 2000; ///< In microseconds
+		public:
+			TDE2_API static CSceneStreamer& Get();
+
+			/*!
+				\brief The method initializes the streamer
+
+				\param[in] frameBudget A time in microseconds which is spent on the teardown within a frame
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::U32 frameBudget = DefaultFrameBudget);
+
+			/*!
+				\brief The method unloads all pending scenes at once and invokes callbacks which wait for that
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			/*!
+				\brief The method deactivates all entities of the scene and enqueues it for the teardown.
+				The request is ignored if the scene is already enqueued
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE UnloadScene(TDEngine2::TSceneId sceneId);
+
+			/*!
+				\brief The method removes entities of pending scenes until the budget is spent. At least one
+				entity is removed per call, so the teardown always advances
+			*/
+
+			TDE2_API void Update();
+
+			/*!
+				\brief The method invokes the callback when all pending scenes are unloaded, it's invoked right away
+				if there are no ones
+			*/
+
+			TDE2_API void NotifyWhenIdle(const std::function<void()>& callback);
+
+			TDE2_API TDEngine2::E_RESULT_CODE SetFrameBudget(TDEngine2::U32 microseconds);
+
+			TDE2_API TDEngine2::U32 GetFrameBudget() const;
+
+			TDE2_API bool IsIdle() const;
+
+			/*!
+				\brief The method returns a ratio of removed entities to all ones that were enqueued since
+				the streamer became busy
+
+				\return A value within [0; 1] range, 1 if there is nothing to do
+			*/
+
+			TDE2_API TDEngine2::F32 GetProgress() const;
+		private:
+			typedef struct TTeardownJob
+			{
+				TDEngine2::TSceneId               mSceneId;
+				std::vector<TDEngine2::TEntityId> mEntities; ///< Children go before their parents
+				TDEngine2::USIZE                  mNextEntityIndex;
+			} TTeardownJob;
+		private:
+			CSceneStreamer() = default;
+			CSceneStreamer(const CSceneStreamer&) = delete;
+			CSceneStreamer& operator= (const CSceneStreamer&) = delete;
+
+			TDE2_API void _deactivateRoots(TDEngine2::IWorld* pWorld, const std::vector<TDEngine2::TEntityId>& entities);
+
+			TDE2_API void _onIdle();
+		private:
+			TDEngine2::TPtr<TDEngine2::ISceneManager> mpSceneManager = nullptr;
+
+			TDEngine2::U32                            mFrameBudget = DefaultFrameBudget;
+
+			std::deque<TTeardownJob>                  mJobs;
+			std::vector<std::function<void()>>        mIdleCallbacks;
+
+			TDEngine2::USIZE                          mEnqueuedEntitiesCount = 0;
+			TDEngine2::USIZE                          mRemovedEntitiesCount = 0;
+	};
+}
\ No newline at end of file
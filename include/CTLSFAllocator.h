@@ -0,0 +1,194 @@
+/*!
+	\file CTLSFAllocator.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "CAllocationProfiler.h"
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+
+
+namespace Game
+{
+	/*!
+		\brief A factory function for creation objects of CTLSFAllocator's type
+
+		\param[in] pageSize A size of a page, a larger page is allocated for requests that don't fit into it
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CTLSFAllocator's implementation
+	*/
+
+	TDE2_API TDEngine2::IAllocator* CreateTLSFAllocator(TDEngine2::USIZE pageSize, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CTLSFAllocator
+
+		\brief The class implements two-level segregated fit allocator. Free blocks are kept in lists which are indexed
+		by a power of two of their size and one of 16 linear subdivisions of that range. Non-empty lists are marked
+		within bitmaps, so a suitable block is found with two bit scans instead of a walk over blocks. Freed blocks
+		are merged with their free neighbours right away, so both operations take constant time.
+
+		Blocks up to SmallObjectMaxSize bytes are cached by the calling thread and returned into the allocator in batches,
+		so job workers don't contend on its lock for small objects. Clear should not be called while other threads
+		use the allocator
+	*/
+
+	class CTLSFAllocator : public TDEngine2::CBaseObject, public TDEngine2::IAllocator
+	{
+		public:
+			friend TDE2_API TDEngine2::IAllocator* CreateTLSFAllocator(TDEngine2::USIZE, TDEngine2::E_RESULT_CODE&);
+		public:
+			static constexpr TDEngine2::USIZE SmallObjectMaxSize = 256;
+			static constexpr TDEngine2::U32   MaxThreadCachesCount = 16; ///< Threads beyond the limit use the allocator directly
+		public:
+			TDE2_REGISTER_TYPE(CTLSFAllocator)
+
+			/*!
+				\brief The method initializes an internal state of an allocator
+
+				\param[in] pageSize The value determines an initial size of memory that's allowed to the allocator. Also it defines
+				a size of newly allocated page when there is no enough space
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TSizeType pageSize) override;
+
+			/*!
+				\brief The method allocates a new piece of memory of specified size,
+				which is aligned by aligment's value
+
+				\param[in] size A size of an allocated memory
+
+				\param[in] alignment An alignment of a block, should be a power of 2
+
+				\return A pointer to the allocated block, returns nullptr if there is no free space
+			*/
+
+			TDE2_API void* Allocate(TSizeType size, TDEngine2::U8 alignment) override;
+
+			/*!
+				\brief The method deallocates memory in position specified with a given pointer
+
+				\param[in] pObjectPtr A pointer to piece of memory that should be freed
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Deallocate(void* pObjectPtr) override;
+
+			/*!
+				\brief The method releases all pages and drops the threads' caches
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Clear() override;
+
+#if TDE2_EDITORS_ENABLED
+			TDE2_API void SetBlockDebugName(const std::string& blockId) override;
+#endif
+
+			TDE2_API TSizeType GetTotalMemorySize() const override;
+
+			/*!
+				\brief The method returns a size of blocks that are given out, blocks within the threads' caches aren't counted
+			*/
+
+			TDE2_API TSizeType GetUsedMemorySize() const override;
+
+			TDE2_API TDEngine2::U32 GetAllocationsCount() const override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CTLSFAllocator)
+
+			TDE2_API TDEngine2::E_RESULT_CODE _onFreeInternal() override;
+		private:
+			static constexpr TDEngine2::U32   AlignSizeLog2 = 4;
+			static constexpr TDEngine2::USIZE AlignSize = 1 << AlignSizeLog2;
+			static constexpr TDEngine2::U32   SecondLevelsCountLog2 = 4;
+			static constexpr TDEngine2::U32   SecondLevelsCount = 1 << SecondLevelsCountLog2;
+			static constexpr TDEngine2::U32   FirstLevelShift = SecondLevelsCountLog2 + AlignSizeLog2;
+			static constexpr TDEngine2::U32   FirstLevelsCount = 8 * sizeof(TDEngine2::USIZE) - FirstLevelShift + 1;
+			static constexpr TDEngine2::USIZE SmallBlockSize = 1 << FirstLevelShift;
+
+			static constexpr TDEngine2::U32   SmallClassesCount = SmallObjectMaxSize / AlignSize;
+			static constexpr TDEngine2::U32   CacheRefillCount = 8;
+			static constexpr TDEngine2::U32   MaxCachedBlocksCount = 64; ///< Per size class, a half is returned into the allocator on overflow
+
+			struct TBlockHeader
+			{
+				TBlockHeader*    mpPrevPhysBlock; ///< nullptr for the first block of a page
+				TDEngine2::USIZE mSize;           ///< A size of the payload, the lowest bit is set if the block is free
+
+				/// \note The fields below overlap the payload, they're valid only for free blocks
+				TBlockHeader*    mpNextFreeBlock;
+				TBlockHeader*    mpPrevFreeBlock;
+			};
+
+			static constexpr TDEngine2::USIZE HeaderSize = offsetof(TBlockHeader, mpNextFreeBlock);
+			static constexpr TDEngine2::USIZE MinBlockSize = sizeof(TBlockHeader) - HeaderSize;
+
+			struct TThreadCache
+			{
+				TBlockHeader*  mpBlocks[SmallClassesCount];
+				TDEngine2::U32 mBlocksCount[SmallClassesCount];
+				TDEngine2::U8  mPadding[64]; ///< Caches of different threads don't share a cache line
+			};
+		private:
+			TDE2_API void* _allocateBlock(TDEngine2::USIZE size, TDEngine2::USIZE alignment);
+			TDE2_API void _freeBlock(TBlockHeader* pBlock);
+
+			TDE2_API TBlockHeader* _findFreeBlock(TDEngine2::USIZE size);
+			TDE2_API TDEngine2::E_RESULT_CODE _addPage(TDEngine2::USIZE minBlockSize);
+
+			TDE2_API void _insertFreeBlock(TBlockHeader* pBlock);
+			TDE2_API void _removeFreeBlock(TBlockHeader* pBlock);
+
+			TDE2_API TBlockHeader* _splitBlock(TBlockHeader* pBlock, TDEngine2::USIZE size);
+			TDE2_API TBlockHeader* _trimLeadingGap(TBlockHeader* pBlock, TDEngine2::USIZE gapSize);
+
+			TDE2_API void* _allocateSmall(TThreadCache& cache, TDEngine2::USIZE size);
+			TDE2_API void _flushCache(TThreadCache& cache, TDEngine2::U32 classIndex, TDEngine2::U32 keptBlocksCount);
+
+			TDE2_API TThreadCache* _getThreadCache();
+
+			TDE2_API static void _getListIndices(TDEngine2::USIZE size, TDEngine2::U32& firstLevel, TDEngine2::U32& secondLevel);
+
+			/*!
+				\brief The method rounds the size up to the beginning of the next list, so any block of that list fits the size
+			*/
+
+			TDE2_API static TDEngine2::USIZE _roundUpToListSize(TDEngine2::USIZE size);
+		private:
+			mutable std::mutex              mMutex;
+
+			TSizeType                       mPageSize = 0;
+			TSizeType                       mTotalMemorySize = 0;
+
+			std::atomic<TSizeType>          mUsedMemorySize { 0 };
+			std::atomic<TDEngine2::U32>     mAllocationsCount { 0 };
+
+			TDEngine2::U64                  mFirstLevelBitmap = 0;
+			TDEngine2::U32                  mSecondLevelBitmaps[FirstLevelsCount];
+			TBlockHeader*                   mpFreeBlocks[FirstLevelsCount][SecondLevelsCount];
+
+			std::vector<std::unique_ptr<TDEngine2::U8[]>> mPages;
+
+			std::unique_ptr<TThreadCache[]> mpThreadCaches;
+
+			TDEngine2::U32                  mProfilerAllocatorId = CAllocationProfiler::InvalidAllocatorId;
+
+#if TDE2_EDITORS_ENABLED
+			std::string                     mName;
+#endif
+	};
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*!
+	\file CWorldSingletons.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <mutex>
+
+
+namespace Game
+{
+	/*!
+		class CWorldSingletonsCache
+
+		\brief The class caches pointers to world-unique components (see TDE2_REGISTER_UNIQUE_COMPONENT).
+		Every type gets its own slot which index is assigned once per process, so a lookup costs a single
+		array access. A slot is invalidated only when a component of its type is added or removed or
+		the owner entity is destroyed.
+
+		The cache works without subscriptions too, but then it resolves the component on every call.
+		Lookups are synchronized, because systems of CSystemsGroup could be updated concurrently
+	*/
+
+	class CWorldSingletonsCache : public TDEngine2::IEventHandler
+	{
+		public:
+			TDE2_API static CWorldSingletonsCache& Get();
+
+			/*!
+				\brief The method subscribes the cache to ECS events, until it's called all requests are forwarded into IWorld
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+
+			TDE2_API TDEngine2::E_RESULT_CODE Free();
+
+			template <typename T>
+			TDE2_API T* GetSingleton(TDEngine2::IWorld* pWorld)
+			{
+				static const TDEngine2::U32 slotIndex = _allocateSlotIndex();
+
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				TSingletonSlot& slot = _getSlot(slotIndex);
+
+				if (slot.mpComponent && slot.mpWorld == pWorld && mpEventManager)
+				{
+					return static_cast<T*>(slot.mpComponent);
+				}
+
+				TDEngine2::CEntity* pEntity = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<T>());
+
+				slot.mTypeId = T::GetTypeId();
+				slot.mpWorld = pWorld;
+				slot.mEntityId = pEntity ? pEntity->GetId() : TDEngine2::TEntityId::Invalid;
+				slot.mpComponent = pEntity ? pEntity->GetComponent<T>() : nullptr;
+
+				return static_cast<T*>(slot.mpComponent);
+			}
+
+			/*!
+				\brief The method receives a given event and processes it
+
+				\param[in] pEvent A pointer to event data
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+
+			/*!
+				\brief The method returns an identifier of a listener
+
+				\return The method returns an identifier of a listener
+			*/
+
+			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+		private:
+			typedef struct TSingletonSlot
+			{
+				TDEngine2::TypeId    mTypeId = TDEngine2::TypeId::Invalid;
+				TDEngine2::TEntityId mEntityId = TDEngine2::TEntityId::Invalid;
+				TDEngine2::IWorld*   mpWorld = nullptr;
+				void*                mpComponent = nullptr; ///< Points to an object of mTypeId's type
+			} TSingletonSlot;
+		private:
+			CWorldSingletonsCache() = default;
+			CWorldSingletonsCache(const CWorldSingletonsCache&) = delete;
+			CWorldSingletonsCache& operator= (const CWorldSingletonsCache&) = delete;
+
+			TDE2_API static TDEngine2::U32 _allocateSlotIndex();
+
+			TDE2_API TSingletonSlot& _getSlot(TDEngine2::U32 slotIndex);
+
+			TDE2_API void _invalidateSlots(TDEngine2::TypeId typeId);
+		private:
+			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
+
+			std::vector<TSingletonSlot>               mSlots;
+
+			mutable std::mutex                        mMutex;
+	};
+
+
+	/*!
+		\brief The function returns a pointer to a world-unique component of type T or nullptr if there is no such
+	*/
+
+	template <typename T>
+	TDE2_API T* GetSingleton(TDEngine2::IWorld* pWorld)
+	{
+		return CWorldSingletonsCache::Get().GetSingleton<T>(pWorld);
+	}
+
+
+	template <typename T>
+	TDE2_API T* GetSingleton(const TDEngine2::TPtr<TDEngine2::IWorld>& pWorld)
+	{
+		return CWorldSingletonsCache::Get().GetSingleton<T>(pWorld.operator->());
+	}
+}
\ No newline at end of file
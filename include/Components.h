@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "CEntityHandles.h"
 
 
 namespace Game
@@ -192,4 +193,26 @@ namespace TDEngine2
 		REGISTER_EVENT_TYPE(TRestartLevelEvent)
 
 	} TRestartLevelEvent, *TRestartLevelEventPtr;
+
+
+	/*!
+		struct TBallCollisionEvent
+
+		\brief The structure represents an event which occurs when a ball hits a damageable object (a brick or a paddle).
+		The contacts are resolved by CBallUpdateSystem, so the ball's position and direction are already corrected
+	*/
+
+	typedef struct TBallCollisionEvent : TDEngine2::TBaseEvent
+	{
+		virtual ~TBallCollisionEvent() = default;
+
+		TDE2_REGISTER_TYPE(TBallCollisionEvent)
+		REGISTER_EVENT_TYPE(TBallCollisionEvent)
+
+		TDEngine2::TEntityId mBallEntityId = TDEngine2::TEntityId::Invalid;
+		TDEngine2::TEntityId mOtherEntityId = TDEngine2::TEntityId::Invalid;
+		Game::TEntityHandle  mBallEntityHandle = Game::TEntityHandle::Invalid;
+		Game::TEntityHandle  mOtherEntityHandle = Game::TEntityHandle::Invalid;
+		TDEngine2::TVector3 mContactNormal; ///< The normal points outside of the other entity
+	} TBallCollisionEvent, *TBallCollisionEventPtr;
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "CEventChannels.h"
 
 
 namespace Game
@@ -160,7 +161,8 @@ namespace Game
 		private:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CCoreGameMode)
 		private:
-			TDEngine2::TSceneId mPlayerSceneId;
+			TDEngine2::TSceneId  mPlayerSceneId;
+			TEventSubscriptionId mLivesChangedSubscriptionId = TEventSubscriptionId::Invalid;
 	};
 
 
@@ -377,7 +379,7 @@ namespace Game
 	/*!
 		class CLoadingGameMode
 
-		\brief The implementation of a loading screen
+		\brief The implementation of a loading screen. It shows progress of CSceneStreamer's teardown
 	*/
 
 	class CLoadingGameMode : public CCommonGameMode
@@ -404,7 +406,13 @@ namespace Game
 			TDE2_API void Update(TDEngine2::F32 dt) override;
 		private:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CLoadingGameMode)
+
+			TDE2_API void _updateProgressLabel();
 		private:
+			TDEngine2::TEntityId mProgressLabelEntityId = TDEngine2::TEntityId::Invalid; ///< An optional entity of the window named ProgressLabel
+			TDEngine2::F32       mProgress = -1.0f;
+
+			bool                 mWasGameplayActive = false;
 	};
 
 }
\ No newline at end of file
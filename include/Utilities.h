@@ -13,6 +13,9 @@
 
 namespace Game
 {
+	class CLevelSettings;
+
+
 	/*!
 		\brief Level's loading utilities
 	*/
@@ -26,6 +29,20 @@ namespace Game
 		TDEngine2::TPtr<TDEngine2::IGameModesManager> pGameModesManager,
 		TDEngine2::USIZE levelIndex);
 	
+	/*!
+		\brief The function returns CLevelSettings of the given scene. Several levels could be loaded at once,
+		so the world-wide lookup of the component isn't reliable
+	*/
+
+	TDE2_API CLevelSettings* FindLevelSettings(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TSceneId sceneId);
+
+	/*!
+		\brief The function returns true if a level is played right now, i.e. the game isn't paused and neither
+		menus nor the loading screen are shown. It's a run condition of gameplay systems' groups
+	*/
+
+	TDE2_API bool IsGameplayRunning(TDEngine2::IWorld* pWorld);
+
 	TDE2_API bool IsNextGameLevelExists(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager, TDEngine2::I32 offset = 1);
 
 	TDE2_API void LoadNextGameLevel(
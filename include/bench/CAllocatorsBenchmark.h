@@ -0,0 +1,102 @@
+/*!
+	\file CAllocatorsBenchmark.h
+	\date 17.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
+
+namespace Game
+{
+	/*!
+		struct TAllocationTraceEvent
+
+		\brief The structure describes a single operation of a recorded trace. Allocations are numbered
+		in order they were made, a deallocation refers to that number
+	*/
+
+	typedef struct TAllocationTraceEvent
+	{
+		TDEngine2::U32 mAllocationIndex;
+		TDEngine2::U32 mSize; ///< 0 for deallocations
+		bool           mIsAllocation;
+	} TAllocationTraceEvent;
+
+
+	/*!
+		class CAllocationTraceRecorder
+
+		\brief The class records allocations and deallocations of game components, which go through CSceneArenas.
+		Deallocations of objects which were created before the recording started are skipped
+	*/
+
+	class CAllocationTraceRecorder
+	{
+		public:
+			TDE2_API static CAllocationTraceRecorder& Get();
+
+			TDE2_API void Start();
+			TDE2_API void Stop();
+
+			TDE2_API const std::vector<TAllocationTraceEvent>& GetEvents() const;
+		private:
+			CAllocationTraceRecorder() = default;
+			CAllocationTraceRecorder(const CAllocationTraceRecorder&) = delete;
+			CAllocationTraceRecorder& operator= (const CAllocationTraceRecorder&) = delete;
+
+			TDE2_API void _onAllocationEvent(const void* pPtr, TDEngine2::USIZE size, bool isAllocation);
+		private:
+			std::mutex                                        mMutex;
+
+			std::vector<TAllocationTraceEvent>                mEvents;
+			std::unordered_map<const void*, TDEngine2::U32>   mLiveAllocations;
+
+			TDEngine2::U32                                    mAllocationsCount = 0;
+	};
+
+
+	/*!
+		\brief The function writes the trace as a text, a line per event: "a <index> <size>" or "f <index>"
+
+		\return RC_OK if everything went ok, or some other code, which describes an error
+	*/
+
+	TDE2_API TDEngine2::E_RESULT_CODE SaveAllocationTrace(const std::string& filePath, const std::vector<TAllocationTraceEvent>& events);
+
+	TDE2_API TDEngine2::TResult<std::vector<TAllocationTraceEvent>> LoadAllocationTrace(const std::string& filePath);
+
+
+	/*!
+		struct TAllocatorBenchmarkResult
+
+		\brief The structure contains results of the trace's replay with a single allocator
+	*/
+
+	typedef struct TAllocatorBenchmarkResult
+	{
+		std::string      mName;
+		TDEngine2::F64   mTotalTime;          ///< In microseconds
+		TDEngine2::F64   mAvgOperationTime;   ///< In nanoseconds
+		TDEngine2::USIZE mReservedMemorySize; ///< Reserved by the allocator when the replay has finished, 0 if it's unknown
+		bool             mHasDeallocations;   ///< False if the allocator can't free separate blocks, so deallocations are skipped
+	} TAllocatorBenchmarkResult;
+
+
+	/*!
+		\brief The function replays the trace iterationsCount times with TLSF, pools per size, linear allocator
+		and malloc. Blocks that are alive at the end of an iteration are freed before the next one. Malformed events,
+		e.g. empty allocations or deallocations of unknown blocks, are skipped with an error message
+
+		\return An array of results, a single entry per allocator
+	*/
+
+	TDE2_API std::vector<TAllocatorBenchmarkResult> RunAllocatorsBenchmark(const std::vector<TAllocationTraceEvent>& events, TDEngine2::U32 iterationsCount);
+}
\ No newline at end of file
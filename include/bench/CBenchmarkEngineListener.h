@@ -0,0 +1,121 @@
+/*!
+	\file CBenchmarkEngineListener.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include "../CCustomEngineListener.h"
+#include "CAllocatorsBenchmark.h"
+#include <vector>
+#include <string>
+
+
+namespace Game
+{
+	class CProfiledSystem;
+
+
+	/*!
+		struct TBenchmarkSettings
+
+		\brief The structure contains parameters of a headless benchmark's run
+	*/
+
+	struct TBenchmarkSettings
+	{
+		TDEngine2::USIZE mLevelIndex = 1;           ///< An index of a level within GameLevelsCollection.asset
+		TDEngine2::U32   mFramesCount = 1000;       ///< A number of measured frames
+		TDEngine2::U32   mWarmupFramesCount = 60;   ///< A number of frames that are skipped after the level's loaded
+		TDEngine2::F32   mFixedDeltaTime = 1.0f / 60.0f;
+		std::string      mOutputFilePath;           ///< If it's empty the report is written into stdout
+		bool             mIsSequentialUpdate = false; ///< Game systems are updated one by one instead of concurrently
+		std::string      mAllocationTraceFilePath;  ///< The trace is replayed if the file exists, otherwise the recorded one is saved there
+		TDEngine2::U32   mAllocatorsIterations = 10; ///< A number of the trace's replays per allocator, 0 disables the allocators benchmark
+	};
+
+
+	/*!
+		\brief The function reads TBenchmarkSettings from CProgramOptions, so ParseArgs should be called before
+	*/
+
+	TDE2_API TBenchmarkSettings GetBenchmarkSettingsFromProgramOptions();
+}
+
+
+/*!
+	class CBenchmarkEngineListener
+
+	\brief The listener boots the game in the same way as CCustomEngineListener does, but loads a specified level
+	right away and measures the game systems during a fixed number of frames. The results are written as JSON
+*/
+
+class CBenchmarkEngineListener : public CCustomEngineListener
+{
+	public:
+		explicit CBenchmarkEngineListener(const Game::TBenchmarkSettings& settings);
+		virtual ~CBenchmarkEngineListener() = default;
+
+		TDEngine2::E_RESULT_CODE OnStart() override;
+
+		TDEngine2::E_RESULT_CODE OnUpdate(const float& dt) override;
+
+		TDEngine2::E_RESULT_CODE OnFree() override;
+
+		TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+	protected:
+		TDE2_API TDEngine2::ISystem* _decorateGameSystem(TDEngine2::ISystem* pSystem, const std::string& groupName) override;
+
+		TDE2_API void _loadInitialLevel() override;
+
+		/*!
+			\brief The method keeps all balls moving, there is no input in headless mode, so nobody can launch them
+		*/
+
+		TDE2_API void _launchIdleBalls();
+
+		TDE2_API void _recordFrame(TDEngine2::F32 dt);
+
+		/*!
+			\brief The method replays the allocation trace of components with different allocators, the trace is either
+			loaded from mAllocationTraceFilePath or recorded during the run
+		*/
+
+		TDE2_API void _runAllocatorsBenchmark();
+
+		/*!
+			\brief The method checks that every system of the simulation group was updated exactly once within every measured frame
+			and its total time isn't zero, otherwise timings of the run can't be compared with other ones
+
+			\return The method returns true if the check has passed
+		*/
+
+		TDE2_API bool _hasValidSimulationTimings() const;
+
+		TDE2_API TDEngine2::E_RESULT_CODE _writeReport() const;
+	private:
+		struct TFrameRecord
+		{
+			TDEngine2::F64              mFrameTime;
+			TDEngine2::F32              mEngineDeltaTime;
+			std::vector<TDEngine2::F64> mSystemsTimes; ///< The order is the same as in mProfiledSystems
+			std::vector<TDEngine2::U32> mSystemsUpdatesCounts;
+		};
+
+		Game::TBenchmarkSettings             mSettings;
+
+		std::vector<Game::CProfiledSystem*>  mProfiledSystems; ///< The systems are owned by the world
+		std::vector<std::string>             mProfiledSystemsGroups; ///< Names of groups of mProfiledSystems, an empty one for a system outside of groups
+
+		std::vector<TFrameRecord>            mFrames;
+
+		std::vector<Game::TAllocatorBenchmarkResult> mAllocatorsResults;
+		TDEngine2::USIZE                     mAllocationTraceEventsCount = 0;
+
+		bool                                 mIsLevelLoaded = false;
+		TDEngine2::U32                       mSkippedFramesCount = 0;
+
+		TDEngine2::F64                       mPrevFrameTimestamp = 0.0;
+};
\ No newline at end of file
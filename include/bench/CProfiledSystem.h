@@ -0,0 +1,107 @@
+/*!
+	\file CProfiledSystem.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+
+
+namespace Game
+{
+	/*!
+		\brief A factory function for creation objects of CProfiledSystem's type
+
+		\param[in] pSystem A pointer to a system which will be measured, the decorator takes ownership over it
+		\param[in] fixedDeltaTime If the value is positive it overrides frame's delta time which is passed into the decorated system
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CProfiledSystem's implementation
+	*/
+
+	TDE2_API TDEngine2::ISystem* CreateProfiledSystem(TDEngine2::ISystem* pSystem, TDEngine2::F32 fixedDeltaTime, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CProfiledSystem
+
+		\brief The class is a decorator over ISystem's implementation which measures time of Update calls.
+		All the calls are forwarded into the decorated system, the type and name of the latter are reported
+		as its own ones, so FindSystem<T> still works for wrapped systems
+	*/
+
+	class CProfiledSystem : public virtual TDEngine2::ISystem, public TDEngine2::CBaseObject
+	{
+		public:
+			friend TDE2_API TDEngine2::ISystem* CreateProfiledSystem(TDEngine2::ISystem*, TDEngine2::F32, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_REGISTER_TYPE(CProfiledSystem)
+
+			/*!
+				\brief The method initializes an inner state of a decorator
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::ISystem* pSystem, TDEngine2::F32 fixedDeltaTime);
+
+			TDE2_API void InjectBindings(TDEngine2::IWorld* pWorld) override;
+
+			TDE2_API TDEngine2::E_RESULT_CODE AddDefferedCommand(const TCommandFunctor& action = nullptr) override;
+			TDE2_API void ExecuteDefferedCommands() override;
+
+			TDE2_API void OnInit(TDEngine2::TPtr<TDEngine2::IJobManager> pJobManager) override;
+
+			/*!
+				\brief The method invokes Update of the decorated system and accumulates its duration
+
+				\param[in] pWorld A pointer to a main scene's object
+				\param[in] dt A delta time's value, it's replaced with the fixed one if the latter was specified
+			*/
+
+			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
+
+#if TDE2_EDITORS_ENABLED
+			TDE2_API void DebugOutput(TDEngine2::IDebugUtility* pDebugUtility, TDEngine2::F32 dt) const override;
+#endif
+
+			TDE2_API void OnDestroy() override;
+			TDE2_API void OnActivated() override;
+			TDE2_API void OnDeactivated() override;
+
+			TDE2_API bool IsActive() const override;
+
+			TDE2_API const std::string& GetName() const override;
+			TDE2_API TDEngine2::TypeId GetSystemType() const override;
+
+			/*!
+				\brief The method returns time in microseconds which was spent in Update and deffered commands
+				of the decorated system since the last call of ResetAccumulatedTime
+			*/
+
+			TDE2_API TDEngine2::F64 GetAccumulatedTime() const;
+
+			/*!
+				\brief The method returns a number of Update calls since the last call of ResetAccumulatedTime
+			*/
+
+			TDE2_API TDEngine2::U32 GetUpdatesCount() const;
+
+			/*!
+				\brief The method resets both the accumulated time and the number of updates
+			*/
+
+			TDE2_API void ResetAccumulatedTime();
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CProfiledSystem)
+		private:
+			TDEngine2::TPtr<TDEngine2::ISystem> mpSystem = nullptr;
+
+			TDEngine2::F32 mFixedDeltaTime = 0.0f;
+			TDEngine2::F64 mAccumulatedTime = 0.0;
+			TDEngine2::U32 mUpdatesCount = 0;
+	};
+}
\ No newline at end of file
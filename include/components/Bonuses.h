@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CComponentPoolAllocPolicy.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CScoreBonus
 	*/
 
-	class CScoreBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CScoreBonus, 1 << 20>
+	class CScoreBonus : GAME_POOLED_COMPONENT_BASES(CScoreBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateScoreBonus(TDEngine2::E_RESULT_CODE&);
@@ -86,7 +87,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateScoreMultiplierBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CScoreMultiplierBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CScoreBonus, 1 << 20>
+	class CScoreMultiplierBonus : GAME_POOLED_COMPONENT_BASES(CScoreMultiplierBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateScoreMultiplierBonus(TDEngine2::E_RESULT_CODE&);
@@ -156,7 +157,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateGodModeBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CGodModeBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CScoreBonus, 1 << 20>
+	class CGodModeBonus : GAME_POOLED_COMPONENT_BASES(CGodModeBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateGodModeBonus(TDEngine2::E_RESULT_CODE&);
@@ -223,7 +224,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateExpandPaddleBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CExpandPaddleBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CScoreBonus, 1 << 20>
+	class CExpandPaddleBonus : GAME_POOLED_COMPONENT_BASES(CExpandPaddleBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateExpandPaddleBonus(TDEngine2::E_RESULT_CODE&);
@@ -291,7 +292,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateStickyPaddleBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CStickyPaddleBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CScoreBonus, 1 << 20>
+	class CStickyPaddleBonus : GAME_POOLED_COMPONENT_BASES(CStickyPaddleBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateStickyPaddleBonus(TDEngine2::E_RESULT_CODE&);
@@ -357,7 +358,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateExtraLifeBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CExtraLifeBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CExtraLifeBonus, 1 << 20>
+	class CExtraLifeBonus : GAME_POOLED_COMPONENT_BASES(CExtraLifeBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateExtraLifeBonus(TDEngine2::E_RESULT_CODE&);
@@ -423,7 +424,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateLaserBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CLaserBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CLaserBonus, 1 << 20>
+	class CLaserBonus : GAME_POOLED_COMPONENT_BASES(CLaserBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateLaserBonus(TDEngine2::E_RESULT_CODE&);
@@ -490,7 +491,7 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateMultipleBallsBonus(TDEngine2::E_RESULT_CODE& result);
 
 
-	class CMultipleBallsBonus : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CMultipleBallsBonus, 1 << 20>
+	class CMultipleBallsBonus : GAME_POOLED_COMPONENT_BASES(CMultipleBallsBonus)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateMultipleBallsBonus(TDEngine2::E_RESULT_CODE&);
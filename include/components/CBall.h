@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CBall
 	*/
 
-	class CBall : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CBall, 1 << 20>
+	class CBall : GAME_SCENE_ARENA_COMPONENT_BASES(CBall)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateBall(TDEngine2::E_RESULT_CODE&);
@@ -62,6 +63,7 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBall)
 		public:
 			TDEngine2::F32 mSpeed = 5.0f;
+			TDEngine2::F32 mRadius = 0.15f; ///< The ball is simulated as a circle in XZ plane
 
 			TDEngine2::TVector3 mDirection = TDEngine2::ZeroVector3;
 
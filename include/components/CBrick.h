@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CBrick
 	*/
 
-	class CBrick : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CBrick, 1 << 20>
+	class CBrick : GAME_SCENE_ARENA_COMPONENT_BASES(CBrick)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateBrick(TDEngine2::E_RESULT_CODE&);
@@ -61,7 +62,7 @@ namespace Game
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBrick)
 		public:
-			std::string mPowerUpPrefabId = Wrench::StringUtils::GetEmptyStr();
+			std::string mPowerUpPrefabId = Wrench::StringUtils::GetEmptyStr(); ///< Overrides PowerUpsTable.asset if it is not empty
 			TDEngine2::F32 mSpawnProbability = 0.15f;
 	};
 
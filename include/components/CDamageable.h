@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CDamageable
 	*/
 
-	class CDamageable : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CDamageable, 1 << 20>
+	class CDamageable : GAME_SCENE_ARENA_COMPONENT_BASES(CDamageable)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateDamageable(TDEngine2::E_RESULT_CODE&);
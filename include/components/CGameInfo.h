@@ -8,7 +8,7 @@
 
 
 #include <TDEngine2.h>
-#include <list>
+#include "../CComponentPoolAllocPolicy.h"
 
 
 namespace Game
@@ -20,7 +20,7 @@ namespace Game
 		class CGameInfo
 	*/
 
-	class CGameInfo : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CGameInfo, 1 << 20>
+	class CGameInfo : GAME_POOLED_COMPONENT_BASES(CGameInfo)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateGameInfo(TDEngine2::E_RESULT_CODE&);
@@ -67,9 +67,9 @@ namespace Game
 
 			TDEngine2::TSceneId mCurrLoadedGameId = TDEngine2::TSceneId::Invalid;
 
-			TDEngine2::F32 mBonusesSpawnCommonProbability = 0.75f; /// \note The common probability of bonus' spawning
+			bool mIsGameplayActive = false; /// \note Isn't serialized, game modes set it when the level is played
 
-			std::list<TDEngine2::CEntity*> mpProjectilesPool; /// \todo Replace with the generic and safe pool implementation in future
+			TDEngine2::F32 mBonusesSpawnCommonProbability = 0.75f; /// \note The common probability of bonus' spawning
 	};
 
 
@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CGravitable
 	*/
 
-	class CGravitable : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CGravitable, 1 << 20>
+	class CGravitable : GAME_SCENE_ARENA_COMPONENT_BASES(CGravitable)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateGravitable(TDEngine2::E_RESULT_CODE&);
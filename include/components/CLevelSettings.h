@@ -8,6 +8,9 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
+#include <string>
+#include <vector>
 
 
 namespace Game
@@ -15,11 +18,24 @@ namespace Game
 	TDE2_API TDEngine2::IComponent* CreateLevelSettings(TDEngine2::E_RESULT_CODE& result);
 
 
+	/*!
+		struct TPrefabPoolSettings
+
+		\brief The structure tells how many instances of the prefab should be prewarmed when the level's loaded
+	*/
+
+	typedef struct TPrefabPoolSettings
+	{
+		std::string    mPrefabId;
+		TDEngine2::U32 mSize = 0;
+	} TPrefabPoolSettings, *TPrefabPoolSettingsPtr;
+
+
 	/*!
 		class CLevelSettings
 	*/
 
-	class CLevelSettings : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CLevelSettings, 1 << 20>
+	class CLevelSettings : GAME_SCENE_ARENA_COMPONENT_BASES(CLevelSettings)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateLevelSettings(TDEngine2::E_RESULT_CODE&);
@@ -63,6 +79,8 @@ namespace Game
 		public:
 			TDEngine2::TRangeF32 mHorizontalConstraints = TDEngine2::TRangeF32(-4.0f, 4.0f);
 			TDEngine2::TRangeF32 mVerticalConstraints = TDEngine2::TRangeF32(-5.0f, 4.0f);
+
+			std::vector<TPrefabPoolSettings> mPoolsSettings;
 	};
 
 
@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CSceneArenas.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CPaddle
 	*/
 
-	class CPaddle : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CPaddle, 1 << 20>
+	class CPaddle : GAME_SCENE_ARENA_COMPONENT_BASES(CPaddle)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreatePaddle(TDEngine2::E_RESULT_CODE&);
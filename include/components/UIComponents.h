@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../CComponentPoolAllocPolicy.h"
 
 
 namespace Game
@@ -19,7 +20,7 @@ namespace Game
 		class CMainMenuPanel
 	*/
 
-	class CMainMenuPanel : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CMainMenuPanel, 1 << 20>
+	class CMainMenuPanel : GAME_POOLED_COMPONENT_BASES(CMainMenuPanel)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateMainMenuPanel(TDEngine2::E_RESULT_CODE&);
@@ -99,7 +100,7 @@ namespace Game
 		class CPauseMenuPanel
 	*/
 
-	class CPauseMenuPanel : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CPauseMenuPanel, 1 << 20>
+	class CPauseMenuPanel : GAME_POOLED_COMPONENT_BASES(CPauseMenuPanel)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreatePauseMenuPanel(TDEngine2::E_RESULT_CODE&);
@@ -175,7 +176,7 @@ namespace Game
 		class COptionsMenuPanel
 	*/
 
-	class COptionsMenuPanel : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<COptionsMenuPanel, 1 << 20>
+	class COptionsMenuPanel : GAME_POOLED_COMPONENT_BASES(COptionsMenuPanel)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateOptionsMenuPanel(TDEngine2::E_RESULT_CODE&);
@@ -249,7 +250,7 @@ namespace Game
 		class CCreditsMenuPanel
 	*/
 
-	class CCreditsMenuPanel : public TDEngine2::CBaseComponent, public TDEngine2::CPoolMemoryAllocPolicy<CCreditsMenuPanel, 1 << 20>
+	class CCreditsMenuPanel : GAME_POOLED_COMPONENT_BASES(CCreditsMenuPanel)
 	{
 		public:
 			friend TDE2_API TDEngine2::IComponent* CreateCreditsMenuPanel(TDEngine2::E_RESULT_CODE&);
@@ -18,13 +18,13 @@ namespace Game
 		\brief AddScoreBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CAddScoreBonusCollectSystem : public Game::CCollectingSystem<CScoreBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CAddScoreBonusCollectSystem);
 
@@ -32,6 +32,7 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CAddScoreBonusCollectSystem)
 
 			TDE2_API void _onApplyCollectable(const CScoreBonus* pCollectable) override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -39,13 +40,13 @@ namespace Game
 		\brief ScoreMultiplierBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CScoreMultiplierBonusCollectSystem : public Game::CCollectingSystem<CScoreMultiplierBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CScoreMultiplierBonusCollectSystem);
 
@@ -54,6 +55,7 @@ namespace Game
 
 			TDE2_API void _onApplyCollectable(const CScoreMultiplierBonus* pCollectable) override;
 			TDE2_API void _onCollectableEffectFinished() override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -61,13 +63,13 @@ namespace Game
 		\brief GodModeBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CGodModeBonusCollectSystem : public Game::CCollectingSystem<CGodModeBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CGodModeBonusCollectSystem);
 
@@ -76,6 +78,7 @@ namespace Game
 
 			TDE2_API void _onApplyCollectable(const CGodModeBonus* pCollectable) override;
 			TDE2_API void _onCollectableEffectFinished() override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -83,13 +86,13 @@ namespace Game
 		\brief ExpandPaddleBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CExpandPaddleBonusCollectSystem : public Game::CCollectingSystem<CExpandPaddleBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CExpandPaddleBonusCollectSystem);
 
@@ -98,6 +101,7 @@ namespace Game
 
 			TDE2_API void _onApplyCollectable(const CExpandPaddleBonus* pCollectable) override;
 			TDE2_API void _onCollectableEffectFinished() override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 
 		private:
 			TDEngine2::F32 mPrevScale = 1.0f;
@@ -108,13 +112,13 @@ namespace Game
 		\brief StickyPaddleBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CStickyPaddleBonusCollectSystem : public Game::CCollectingSystem<CStickyPaddleBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CStickyPaddleBonusCollectSystem);
 
@@ -122,6 +126,7 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CStickyPaddleBonusCollectSystem)
 
 			TDE2_API void _onApplyCollectable(const CStickyPaddleBonus* pCollectable) override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -129,13 +134,13 @@ namespace Game
 		\brief ExtraLifeBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CExtraLifeBonusCollectSystem : public Game::CCollectingSystem<CExtraLifeBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CExtraLifeBonusCollectSystem);
 
@@ -143,6 +148,7 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CExtraLifeBonusCollectSystem)
 
 			TDE2_API void _onApplyCollectable(const CExtraLifeBonus* pCollectable) override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -150,13 +156,13 @@ namespace Game
 		\brief LaserBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CLaserBonusCollectSystem : public Game::CCollectingSystem<CLaserBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CLaserBonusCollectSystem);
 
@@ -165,6 +171,7 @@ namespace Game
 
 			TDE2_API void _onApplyCollectable(const CLaserBonus* pCollectable) override;
 			TDE2_API void _onCollectableEffectFinished() override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 
 
@@ -172,13 +179,13 @@ namespace Game
 		\brief MultipleBallsBonusCollectSystem
 	*/
 
-	TDE2_API TDEngine2::ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CMultipleBallsBonusCollectSystem : public Game::CCollectingSystem<CMultipleBallsBonus>
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<TDEngine2::ISceneManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CMultipleBallsBonusCollectSystem);
 
@@ -186,5 +193,6 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CMultipleBallsBonusCollectSystem)
 
 			TDE2_API void _onApplyCollectable(const CMultipleBallsBonus* pCollectable) override;
+			TDE2_API void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const override;
 	};
 }
\ No newline at end of file
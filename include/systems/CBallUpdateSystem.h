@@ -8,22 +8,33 @@
 
 
 #include <TDEngine2.h>
+#include "../CCollisionGrid2D.h"
+#include "../CComponentsQueries.h"
+#include "../CChunkedSoAStore.h"
+#include "../CEntityCommandBuffer.h"
+#include <vector>
 
 
 namespace Game
 {
 	class CBall;
+	class CDamageable;
 
 
-	TDE2_API TDEngine2::ISystem* CreateBallUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateBallUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext,
+		TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
 	class CBallUpdateSystem : public TDEngine2::CBaseSystem
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateBallUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateBallUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		private:
-			typedef TDEngine2::TComponentsQueryLocalSlice<Game::CBall, TDEngine2::CTransform> TSystemContext;
+			typedef TCachedComponentsQuery<Game::CBall, TDEngine2::CTransform> TSystemContext;
+			typedef TCachedComponentsQuery<Game::CDamageable, TDEngine2::CTransform> TObstaclesContext;
+
+			/// \note Bounds in XZ plane, lifes, an owner of every obstacle and its handle
+			typedef TChunkedQueryMirror<TObstaclesContext, TDEngine2::TVector2, TDEngine2::TVector2, TDEngine2::U32, TDEngine2::TEntityId, TEntityHandle> TObstaclesMirror;
 		public:
 			TDE2_SYSTEM(CBallUpdateSystem);
 
@@ -33,7 +44,7 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext>);
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer);
 
 			/*!
 				\brief The method inject components array into a system
@@ -56,12 +67,34 @@ namespace Game
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CBallUpdateSystem)
 
+			/*!
+				\brief The method rebuilds the grid if an obstacle has appeared or gone since the previous frame,
+				otherwise only the obstacles which components have changed are updated. The grid is built from
+				mObstaclesMirror, so the components are read only for changed obstacles
+			*/
+
+			TDE2_API void _updateCollisionGrid();
+
+			/*!
+				\brief The method moves the ball along its direction and resolves contacts with damageables in continuous way,
+				so fast balls can't pass through thin bricks. Every contact is reported with TBallCollisionEvent
+			*/
+
+			TDE2_API void _moveBall(TDEngine2::CTransform* pBallTransform, CBall* pBall, TDEngine2::F32 dt);
 		private:
 			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
 			TDEngine2::TPtr<TDEngine2::IDesktopInputContext> mpInputContext = nullptr;
+			TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+			TCommandStreamId mCommandStreamId = TCommandStreamId::Invalid;
 			
-			TSystemContext mSystemContext;
-			
-			TDEngine2::TEntityId mGameInfoEntityId = TDEngine2::TEntityId::Invalid;
+			TSystemContext* mpSystemContext = nullptr;
+			TObstaclesContext* mpObstaclesContext = nullptr;
+
+			CCollisionGrid2D mCollisionGrid;
+			std::vector<CDamageable*> mObstaclesDamageables; ///< The order is the same as obstacles' one in mCollisionGrid
+			std::vector<TDEngine2::U32> mObstaclesIndices;    ///< Maps an index within mpObstaclesContext into an index of an obstacle within mCollisionGrid
+
+			TObstaclesMirror mObstaclesMirror;
+			std::vector<TDEngine2::USIZE> mChangedObstacles; ///< Indices of elements of mObstaclesMirror that were copied by the latest Sync
 	};
 }
\ No newline at end of file
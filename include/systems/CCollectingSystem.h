@@ -9,12 +9,17 @@
 
 #include <TDEngine2.h>
 #include "../components/CPaddle.h"
+#include "../components/CGameInfo.h"
+#include "CSystemsGroup.h"
+#include "../CCollisionsRouter.h"
+#include "../CEntitiesPool.h"
+#include "../CEntityCommandBuffer.h"
 
 
 namespace Game
 {
 	template <typename T>
-	class CCollectingSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler
+	class CCollectingSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 		public:
 			TDE2_SYSTEM(CCollectingSystem);
@@ -25,22 +30,34 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API virtual TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager = nullptr)
+			TDE2_API virtual TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter,
+				TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer)
 			{
 				if (mIsInitialized)
 				{
 					return TDEngine2::RC_FAIL;
 				}
 
-				if (!pEventManager)
+				if (!pEventManager || !pCollisionsRouter || !pEntitiesPool || !pCommandBuffer)
 				{
 					return TDEngine2::RC_INVALID_ARGS;
 				}
 
-				pEventManager->Subscribe(TDEngine2::TOn3DCollisionRegisteredEvent::GetTypeId(), this);
+				TDEngine2::E_RESULT_CODE result = pCollisionsRouter->RegisterHandler<CPaddle, T>([this](CPaddle*, T* pCollectable, const TCollisionContactInfo& contactInfo)
+				{
+					_onCollect(pCollectable, contactInfo.mSecondEntityId);
+				});
+
+				if (TDEngine2::RC_OK != result)
+				{
+					return result;
+				}
 
 				mpEventManager = pEventManager;
-				mpSceneManager = pSceneManager;
+				mpCollisionsRouter = pCollisionsRouter;
+				mpEntitiesPool = pEntitiesPool;
+				mpCommandBuffer = pCommandBuffer;
+				mCommandStreamId = pCommandBuffer->CreateStream();
 
 				mIsInitialized = true;
 
@@ -84,68 +101,33 @@ namespace Game
 			}
 
 			/*!
-				\brief The method receives a given event and processes it
-
-				\param[in] pEvent A pointer to event data
-
-				\return RC_OK if everything went ok, or some other code, which describes an error
+				\brief The method returns components and objects which the system touches. _onCollect is run by CCollisionsRouter's
+				handler on the thread that dispatches a contact, so its accesses are listed together with the effect's ones
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override
 			{
-				const TDEngine2::TOn3DCollisionRegisteredEvent* pCollisionEvent = dynamic_cast<const TDEngine2::TOn3DCollisionRegisteredEvent*>(pEvent);
-				if (!pCollisionEvent)
-				{
-					return TDEngine2::RC_FAIL;
-				}
+				TSystemAccessInfo accessInfo;
 
-				TDEngine2::CEntity* pEntity0 = mpWorld->FindEntity(pCollisionEvent->mEntities[0]);
-				TDEngine2::CEntity* pEntity1 = mpWorld->FindEntity(pCollisionEvent->mEntities[1]);
+				accessInfo
+					.Reads<CPaddle>()
+					.Handles<TDEngine2::TOn3DCollisionRegisteredEvent>();
 
-				if (!pEntity0 || !pEntity1 || TDEngine2::TOn3DCollisionRegisteredEvent::E_COLLISION_EVENT_TYPE::ON_ENTER != pCollisionEvent->mType)
-				{
-					return TDEngine2::RC_OK;
-				}
-
-				if (!GetValidPtrOrDefault(pEntity0->GetComponent<CPaddle>(), pEntity1->GetComponent<CPaddle>()))
-				{
-					return TDEngine2::RC_OK;
-				}
+				accessInfo.Reads<T>();
 
-				TDEngine2::CEntity* pCollectableEntity = pEntity0;
+				_appendEffectAccessInfo(accessInfo);
 
-				T* pCollectable = pCollectableEntity->GetComponent<T>();
-				if (!pCollectable)
-				{
-					pCollectable = pEntity1->GetComponent<T>();
-					pCollectableEntity = pEntity1;
-				}
-
-				if (pCollectable)
-				{
-					_onApplyCollectable(pCollectable);
-
-					AddDefferedCommand([this, id = pCollectableEntity->GetId()]
-					{
-						mpWorld->Destroy(id);
-					});
-				}				
-
-				return TDEngine2::RC_OK;
+				return accessInfo;
 			}
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CCollectingSystem)
 
-			/*!
-				\brief The method returns an identifier of a listener
-
-				\return The method returns an identifier of a listener
-			*/
-
-			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override
+			TDE2_API void _onCollect(T* pCollectable, TDEngine2::TEntityId collectableEntityId)
 			{
-				return TDEngine2::TEventListenerId(GetTypeId());
+				_onApplyCollectable(pCollectable);
+
+				mpCommandBuffer->Destroy(mCommandStreamId, collectableEntityId);
 			}
-		protected:
-			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CCollectingSystem)
 
 			TDE2_API virtual void _onApplyCollectable(const T* pCollectable) = 0;
 			
@@ -154,10 +136,21 @@ namespace Game
 				mIsEffectActive = false;
 			}
 
+			/*!
+				\brief The method appends accesses of _onApplyCollectable and _onCollectableEffectFinished, by default there are none
+			*/
+
+			TDE2_API virtual void _appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+			{
+			}
+
 		protected:
 			TDEngine2::IWorld* mpWorld = nullptr; 
 			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
-			TDEngine2::TPtr<TDEngine2::ISceneManager> mpSceneManager = nullptr;
+			TDEngine2::TPtr<CCollisionsRouter> mpCollisionsRouter = nullptr;
+			TDEngine2::TPtr<CEntitiesPool> mpEntitiesPool = nullptr;
+			TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+			TCommandStreamId mCommandStreamId = TCommandStreamId::Invalid;
 
 			TDEngine2::F32 mCurrTimer = 0.0f;
 			bool           mIsEffectActive = false;
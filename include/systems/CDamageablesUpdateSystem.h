@@ -8,21 +8,25 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
 #include "../components/CDamageable.h"
 #include "../components/CBall.h"
+#include "../CCollisionsRouter.h"
+#include "../CEntityCommandBuffer.h"
 #include <vector>
 #include "randomUtils.hpp"
 
 
 namespace Game
 {
-	TDE2_API TDEngine2::ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter,
+		TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CDamageablesUpdateSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler
+	class CDamageablesUpdateSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<CCollisionsRouter>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 
 		public:
 			TDE2_SYSTEM(CDamageablesUpdateSystem);
@@ -33,7 +37,8 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter,
+				TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer);
 
 			/*!
 				\brief The method inject components array into a system
@@ -55,27 +60,25 @@ namespace Game
 			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
 
 			/*!
-				\brief The method receives a given event and processes it
-
-				\param[in] pEvent A pointer to event data
-
-				\return RC_OK if everything went ok, or some other code, which describes an error
+				\brief The method returns components and objects which the system touches within Update and its collision handlers
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CDamageablesUpdateSystem)
 
 			/*!
-				\brief The method returns an identifier of a listener
-
-				\return The method returns an identifier of a listener
+				\brief The method decrements lifes of the damageable, rewards the player and destroys the entity
+				when there are no more lifes
 			*/
 
-			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
-		protected:
-			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CDamageablesUpdateSystem)
+			TDE2_API void _applyDamage(const TCollisionContactInfo& contactInfo, CDamageable* pDamageable);
 
 		private:
 			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
+			TDEngine2::TPtr<CCollisionsRouter> mpCollisionsRouter = nullptr;
+			TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+			TCommandStreamId mCommandStreamId = TCommandStreamId::Invalid;
 			TDEngine2::IWorld* mpWorld = nullptr;
 
 			Wrench::DefaultRandom mRandomUtility;
@@ -0,0 +1,65 @@
+/*!
+	\file CEntityCommandBufferSystem.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include "../CEntityCommandBuffer.h"
+
+
+namespace Game
+{
+	TDE2_API TDEngine2::ISystem* CreateEntityCommandBufferSystem(TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CEntityCommandBufferSystem
+
+		\brief The system plays back the shared command buffer right within its Update, so structural changes are applied
+		after all systems that are registered before it. Within a CSystemsGroup it's run exclusively and serves as the group's
+		sync point, so commands of every step of a FIXED_STEP group are played back before the next step. It should be registered the last one
+	*/
+
+	class CEntityCommandBufferSystem : public TDEngine2::CBaseSystem
+	{
+		public:
+			friend TDE2_API TDEngine2::ISystem* CreateEntityCommandBufferSystem(TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_SYSTEM(CEntityCommandBufferSystem);
+
+			/*!
+				\brief The method initializes an inner state of a system
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer);
+
+			/*!
+				\brief The method inject components array into a system
+
+				\param[in] pWorld A pointer to a main scene's object
+			*/
+
+			TDE2_API void InjectBindings(TDEngine2::IWorld* pWorld) override;
+
+			/*!
+				\brief The main method that should be implemented in all derived classes.
+				It contains all the logic that the system will execute during engine's work.
+
+				\param[in] pWorld A pointer to a main scene's object
+
+				\param[in] dt A delta time's value
+			*/
+
+			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CEntityCommandBufferSystem)
+		private:
+			TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+	};
+}
\ No newline at end of file
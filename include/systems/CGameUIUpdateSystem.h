@@ -8,17 +8,19 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
+#include "../CEventChannels.h"
 
 
 namespace Game
 {
-	TDE2_API TDEngine2::ISystem* CreateGameUIUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateGameUIUpdateSystem(CSystemsGroup* pOwnerGroup, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CGameUIUpdateSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler
+	class CGameUIUpdateSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateGameUIUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateGameUIUpdateSystem(CSystemsGroup*, TDEngine2::E_RESULT_CODE&);
 
 		public:
 			TDE2_SYSTEM(CGameUIUpdateSystem);
@@ -29,7 +31,7 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager);
+			TDE2_API TDEngine2::E_RESULT_CODE Init(CSystemsGroup* pOwnerGroup);
 
 			/*!
 				\brief The method inject components array into a system
@@ -51,29 +53,30 @@ namespace Game
 			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
 
 			/*!
-				\brief The method receives a given event and processes it
-
-				\param[in] pEvent A pointer to event data
-
-				\return RC_OK if everything went ok, or some other code, which describes an error
-			*/
-
-			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
-
-			/*!
-				\brief The method returns an identifier of a listener
-
-				\return The method returns an identifier of a listener
+				\brief The method returns components and objects which the system touches within Update
 			*/
 
-			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CGameUIUpdateSystem)
 
+			TDE2_API TDEngine2::E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API void _setLabelText(TDEngine2::TEntityId labelEntityId, const std::string& text);
 		private:
-			TDEngine2::IWorld* mpWorld = nullptr;
+			TDEngine2::IWorld*   mpWorld = nullptr;
+			CSystemsGroup*       mpOwnerGroup = nullptr;
+
+			TEventSubscriptionId mScoreChangedSubscriptionId = TEventSubscriptionId::Invalid;
+			TEventSubscriptionId mLivesChangedSubscriptionId = TEventSubscriptionId::Invalid;
 
 			TDEngine2::TEntityId mScoreLabelElementId;
 			TDEngine2::TEntityId mLivesLabelElementId;
+
+			TDEngine2::U32       mPlayerScore = 0;
+			TDEngine2::U32       mPlayerLives = 0;
+
+			bool                 mIsScoreChanged = false;
+			bool                 mIsLivesChanged = false;
 	};
 }
\ No newline at end of file
@@ -8,18 +8,22 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
+#include "../CComponentsQueries.h"
 #include "../components/CGravitable.h"
+#include "../CEntitiesPool.h"
+#include "../CEntityCommandBuffer.h"
 
 
 namespace Game
 {
-	TDE2_API TDEngine2::ISystem* CreateGravityUpdateSystem(TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateGravityUpdateSystem(TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CGravityUpdateSystem : public TDEngine2::CBaseSystem
+	class CGravityUpdateSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreateGravityUpdateSystem(TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreateGravityUpdateSystem(TDEngine2::TPtr<CEntitiesPool>, TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CGravityUpdateSystem);
 
@@ -29,7 +33,7 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init();
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer);
 
 			/*!
 				\brief The method inject components array into a system
@@ -49,12 +53,22 @@ namespace Game
 			*/
 
 			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
+
+			/*!
+				\brief The method returns components and objects which the system touches within Update
+			*/
+
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CGravityUpdateSystem)
 
 		private:
 			static const TDEngine2::TVector3 mGravityDirection;
 
-			TDEngine2::TComponentsQueryLocalSlice<CGravitable, TDEngine2::CTransform> mSystemContext;
+			TDEngine2::TPtr<CEntitiesPool> mpEntitiesPool = nullptr;
+			TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+			TCommandStreamId mCommandStreamId = TCommandStreamId::Invalid;
+
+			TCachedComponentsQuery<CGravitable, TDEngine2::CTransform>* mpSystemContext = nullptr;
 	};
 }
\ No newline at end of file
@@ -8,21 +8,23 @@
 
 
 #include <TDEngine2.h>
+#include "../CComponentsQueries.h"
 #include "../components/CPaddle.h"
+#include "../CEntitiesPool.h"
 
 
 namespace Game
 {
 	TDE2_API TDEngine2::ISystem* CreatePaddleControlSystem(
 		TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext, 
-		TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, 
+		TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, 
 		TDEngine2::E_RESULT_CODE& result);
 
 
 	class CPaddleControlSystem : public TDEngine2::CBaseSystem
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreatePaddleControlSystem(TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<TDEngine2::ISceneManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreatePaddleControlSystem(TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::E_RESULT_CODE&);
 		public:
 			TDE2_SYSTEM(CPaddleControlSystem);
 
@@ -32,7 +34,7 @@ namespace Game
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager);
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IDesktopInputContext>, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool);
 
 			/*!
 				\brief The method inject components array into a system
@@ -57,10 +59,8 @@ namespace Game
 
 		private:
 			TDEngine2::TPtr<TDEngine2::IDesktopInputContext> mpInputContext = nullptr; 
-			TDEngine2::TPtr<TDEngine2::ISceneManager> mpSceneManager = nullptr;
+			TDEngine2::TPtr<CEntitiesPool> mpEntitiesPool = nullptr;
 			
-			TDEngine2::TComponentsQueryLocalSlice<CPaddle, TDEngine2::CTransform> mSystemContext;
-
-			TDEngine2::TEntityId mGameInfoEntityId = TDEngine2::TEntityId::Invalid;
+			TCachedComponentsQuery<CPaddle, TDEngine2::CTransform>* mpSystemContext = nullptr;
 	};
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
+#include "../CComponentsQueries.h"
 #include "../components/CPaddle.h"
 #include "../Components.h"
 #include <vector>
@@ -18,7 +20,7 @@ namespace Game
 	TDE2_API TDEngine2::ISystem* CreatePaddlePositionerSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CPaddlePositionerSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler
+	class CPaddlePositionerSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler, public ISystemAccessProvider
 	{
 		public:
 			friend TDE2_API TDEngine2::ISystem* CreatePaddlePositionerSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::E_RESULT_CODE&);
@@ -53,6 +55,12 @@ namespace Game
 
 			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
 
+			/*!
+				\brief The method returns components and objects which the system touches within Update
+			*/
+
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override;
+
 			/*!
 				\brief The method receives a given event and processes it
 
@@ -74,8 +82,8 @@ namespace Game
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CPaddlePositionerSystem)
 
 		private:
-			TDEngine2::TComponentsQueryLocalSlice<Game::CPaddle, TDEngine2::CTransform> mPaddlesContext;
-			TDEngine2::TComponentsQueryLocalSlice<Game::CPlayerPositioner, TDEngine2::CTransform> mPositionersContext;
+			TCachedComponentsQuery<Game::CPaddle, TDEngine2::CTransform>* mpPaddlesContext = nullptr;
+			TCachedComponentsQuery<Game::CPlayerPositioner, TDEngine2::CTransform>* mpPositionersContext = nullptr;
 			TDEngine2::IWorld* mpWorld = nullptr;
 			bool mIsDirty = false;
 	};
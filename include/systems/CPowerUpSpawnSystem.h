@@ -8,29 +8,37 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
 #include "randomUtils.hpp"
+#include "../CEntitiesPool.h"
+#include "../CPowerUpsTable.h"
+#include "../CEventChannels.h"
+#include "../Components.h"
 
 
 namespace Game
 {
-	TDE2_API TDEngine2::ISystem* CreatePowerUpSpawnSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreatePowerUpSpawnSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager,
+		TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CPowerUpSpawnSystem : public TDEngine2::CBaseSystem, public TDEngine2::IEventHandler
+	class CPowerUpSpawnSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 		public:
-			friend TDE2_API TDEngine2::ISystem* CreatePowerUpSpawnSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<TDEngine2::ISceneManager>, TDEngine2::E_RESULT_CODE&);
+			friend TDE2_API TDEngine2::ISystem* CreatePowerUpSpawnSystem(TDEngine2::TPtr<TDEngine2::IEventManager>, TDEngine2::TPtr<TDEngine2::IResourceManager>, TDEngine2::TPtr<CEntitiesPool>, TDEngine2::E_RESULT_CODE&);
 
 		public:
 			TDE2_SYSTEM(CPowerUpSpawnSystem);
 
 			/*!
-				\brief The method initializes an inner state of a system
+				\brief The method initializes an inner state of a system. The power ups table is loaded here and
+				all prefabs it references are registered for prewarming within the pool
 
 				\return RC_OK if everything went ok, or some other code, which describes an error
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager);
+			TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager,
+				TDEngine2::TPtr<CEntitiesPool> pEntitiesPool);
 
 			/*!
 				\brief The method inject components array into a system
@@ -52,30 +60,25 @@ namespace Game
 			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
 
 			/*!
-				\brief The method receives a given event and processes it
-
-				\param[in] pEvent A pointer to event data
-
-				\return RC_OK if everything went ok, or some other code, which describes an error
+				\brief The method returns components and objects which the system touches within Update
 			*/
 
-			TDE2_API TDEngine2::E_RESULT_CODE OnEvent(const TDEngine2::TBaseEvent* pEvent) override;
-
-			/*!
-				\brief The method returns an identifier of a listener
-
-				\return The method returns an identifier of a listener
-			*/
-
-			TDE2_API TDEngine2::TEventListenerId GetListenerId() const override;
+			TDE2_API TSystemAccessInfo GetAccessInfo() const override;
 		protected:
 			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CPowerUpSpawnSystem)
 
+			TDE2_API TDEngine2::E_RESULT_CODE _onFreeInternal() override;
+
+			TDE2_API void _onSpawnNewBonus(const TDEngine2::TSpawnNewBonusEvent& spawnEvent);
+
 		private:
 			TDEngine2::TPtr<TDEngine2::IEventManager> mpEventManager = nullptr;
-			TDEngine2::TPtr<TDEngine2::ISceneManager> mpSceneManager = nullptr;
+			TDEngine2::TPtr<CEntitiesPool> mpEntitiesPool = nullptr;
+			TDEngine2::TPtr<CPowerUpsTable> mpPowerUpsTable = nullptr;
 			TDEngine2::IWorld* mpWorld = nullptr;
 
 			Wrench::DefaultRandom mRandomUtility;
+
+			TEventSubscriptionId mSpawnNewBonusSubscriptionId = TEventSubscriptionId::Invalid;
 	};
 }
\ No newline at end of file
@@ -8,18 +8,21 @@
 
 
 #include <TDEngine2.h>
+#include "CSystemsGroup.h"
+#include "../CComponentsQueries.h"
 #include "../Components.h"
+#include "../CEntityCommandBuffer.h"
 
 
 namespace Game
 {
-	TDE2_API TDEngine2::ISystem* CreateProjectilesPoolSystem(TDEngine2::E_RESULT_CODE& result);
+	TDE2_API TDEngine2::ISystem* CreateProjectilesPoolSystem(TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, TDEngine2::E_RESULT_CODE& result);
 
 
-	class CProjectilesPoolSystem : public TDEngine2::CBaseSystem
+	class CProjectilesPoolSystem : public TDEngine2::CBaseSystem, public ISystemAccessProvider
 	{
 	public:
-		friend TDE2_API TDEngine2::ISystem* CreateProjectilesPoolSystem(TDEngine2::E_RESULT_CODE&);
+		friend TDE2_API TDEngine2::ISystem* CreateProjectilesPoolSystem(TDEngine2::TPtr<CEntityCommandBuffer>, TDEngine2::E_RESULT_CODE&);
 	public:
 		TDE2_SYSTEM(CProjectilesPoolSystem);
 
@@ -29,7 +32,7 @@ namespace Game
 			\return RC_OK if everything went ok, or some other code, which describes an error
 		*/
 
-		TDE2_API TDEngine2::E_RESULT_CODE Init();
+		TDE2_API TDEngine2::E_RESULT_CODE Init(TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer);
 
 		/*!
 			\brief The method inject components array into a system
@@ -49,12 +52,19 @@ namespace Game
 		*/
 
 		TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
+
+		/*!
+			\brief The method returns components and objects which the system touches within Update
+		*/
+
+		TDE2_API TSystemAccessInfo GetAccessInfo() const override;
 	protected:
 		DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CProjectilesPoolSystem)
 
 	private:
-		TDEngine2::TComponentsQueryLocalSlice<CProjectile, TDEngine2::CTransform> mSystemContext;
+		TDEngine2::TPtr<CEntityCommandBuffer> mpCommandBuffer = nullptr;
+		TCommandStreamId mCommandStreamId = TCommandStreamId::Invalid;
 
-		TDEngine2::TEntityId mGameInfoEntityId = TDEngine2::TEntityId::Invalid;
+		TCachedComponentsQuery<CProjectile, TDEngine2::CTransform>* mpSystemContext = nullptr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,265 @@
+/*!
+	\file CSystemsGroup.h
+	\date 16.10.2026
+	\author Ildar Kasimov
+*/
+
+#pragma once
+
+
+#include <TDEngine2.h>
+#include <vector>
+#include <string>
+#include <functional>
+
+
+namespace Game
+{
+	/*!
+		struct TSystemAccessInfo
+
+		\brief The type describes what a system touches within its Update. Components and shared game objects
+		(CEntityCommandBuffer, CEntitiesPool, etc) are identified by their GetTypeId() in the same way.
+		Handlers of notified events are executed by the thread that emits the event, so both sides should be listed.
+		Events which are posted with PostEvent are handled at the group's sync points and aren't listed at all
+	*/
+
+	typedef struct TSystemAccessInfo
+	{
+		template <typename T> TSystemAccessInfo& Reads() { mReads.push_back(T::GetTypeId()); return *this; }
+		template <typename T> TSystemAccessInfo& Writes() { mWrites.push_back(T::GetTypeId()); return *this; }
+		template <typename T> TSystemAccessInfo& Emits() { mEmittedEvents.push_back(T::GetTypeId()); return *this; }
+		template <typename T> TSystemAccessInfo& Handles() { mHandledEvents.push_back(T::GetTypeId()); return *this; }
+
+		std::vector<TDEngine2::TypeId> mReads;
+		std::vector<TDEngine2::TypeId> mWrites;
+		std::vector<TDEngine2::TypeId> mEmittedEvents;
+		std::vector<TDEngine2::TypeId> mHandledEvents;
+	} TSystemAccessInfo, *TSystemAccessInfoPtr;
+
+
+	/*!
+		interface ISystemAccessProvider
+
+		\brief A system implements the interface to be run concurrently with others. A system which doesn't
+		implement it, e.g. because it creates entities or switches levels right away, is always run exclusively
+	*/
+
+	class ISystemAccessProvider
+	{
+		public:
+			TDE2_API virtual ~ISystemAccessProvider() = default;
+
+			TDE2_API virtual TSystemAccessInfo GetAccessInfo() const = 0;
+	};
+
+
+	enum class E_SYSTEMS_SCHEDULING_MODE : TDEngine2::U8
+	{
+		SEQUENTIAL, ///< Systems are updated one by one in order of their addition
+		PARALLEL,   ///< Independent systems are updated on IJobManager's workers
+	};
+
+
+	enum class E_SYSTEMS_GROUP_UPDATE_RATE : TDEngine2::U8
+	{
+		EVERY_FRAME,
+		FIXED_STEP,     ///< Systems get a constant dt as many times as the accumulated frames' time contains it
+		EVERY_N_FRAMES, ///< Systems get the summary dt of the skipped frames
+		ON_DEMAND,      ///< Systems are updated once within the frame that goes after CSystemsGroup::RequestUpdate
+	};
+
+
+	/*!
+		struct TSystemsGroupUpdateRate
+
+		\brief The type describes how often systems of a group are updated
+	*/
+
+	typedef struct TSystemsGroupUpdateRate
+	{
+		TDE2_API static TSystemsGroupUpdateRate EveryFrame();
+		TDE2_API static TSystemsGroupUpdateRate FixedStep(TDEngine2::F32 step, TDEngine2::U32 maxStepsPerFrame = 4);
+		TDE2_API static TSystemsGroupUpdateRate EveryNFrames(TDEngine2::U32 framesCount);
+		TDE2_API static TSystemsGroupUpdateRate OnDemand();
+
+		E_SYSTEMS_GROUP_UPDATE_RATE mType = E_SYSTEMS_GROUP_UPDATE_RATE::EVERY_FRAME;
+
+		TDEngine2::F32              mFixedStep = 1.0f / 60.0f;
+		TDEngine2::U32              mMaxStepsPerFrame = 4; ///< The rest of a long frame is dropped, so a slow frame doesn't make next ones slower
+		TDEngine2::U32              mFramesCount = 1;
+	} TSystemsGroupUpdateRate, *TSystemsGroupUpdateRatePtr;
+
+
+	/*!
+		\brief A group is updated only if its condition returns true. Frames when it's false aren't accumulated
+		by FIXED_STEP and EVERY_N_FRAMES groups, so a group doesn't catch up after a pause
+	*/
+
+	typedef std::function<bool(TDEngine2::IWorld*)> TSystemsGroupRunCondition;
+
+
+	class CSystemsGroup;
+
+
+	/*!
+		\brief A factory function for creation objects of CSystemsGroup's type
+
+		\param[in] name A name of the group which is reported as the system's name
+		\param[in] mode A way the group's systems are updated
+		\param[out] result Contains RC_OK if everything went ok, or some other code, which describes an error
+
+		\return A pointer to CSystemsGroup's implementation
+	*/
+
+	TDE2_API CSystemsGroup* CreateSystemsGroup(const std::string& name, E_SYSTEMS_SCHEDULING_MODE mode, TDEngine2::E_RESULT_CODE& result);
+
+
+	/*!
+		class CSystemsGroup
+
+		\brief The class is registered within IWorld as a single system and updates its own systems. Systems' accesses
+		are turned into a dependency graph: a system depends on every earlier one that it conflicts with. The graph
+		is split into waves of independent systems, a wave is executed on IJobManager's workers and the calling thread.
+		Conflicting systems are never reordered, so the result matches SEQUENTIAL mode which is kept as a fallback.
+		Events posted into CEventChannels are flushed on the calling thread after every wave.
+
+		The group is updated with its TSystemsGroupUpdateRate if its run condition is met, otherwise the call
+		returns right away without touching any of its systems.
+
+		Systems of a group aren't visible for IWorld::FindSystem
+	*/
+
+	class CSystemsGroup : public virtual TDEngine2::ISystem, public TDEngine2::CBaseObject
+	{
+		public:
+			friend TDE2_API CSystemsGroup* CreateSystemsGroup(const std::string&, E_SYSTEMS_SCHEDULING_MODE, TDEngine2::E_RESULT_CODE&);
+		public:
+			TDE2_REGISTER_TYPE(CSystemsGroup)
+
+			/*!
+				\brief The method initializes an inner state of a group
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE Init(const std::string& name, E_SYSTEMS_SCHEDULING_MODE mode);
+
+			/*!
+				\brief The method adds a system that can be run concurrently with the ones it doesn't conflict with.
+				The group takes ownership over the system
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE AddSystem(TDEngine2::ISystem* pSystem, const TSystemAccessInfo& accessInfo);
+
+			/*!
+				\brief The method adds a system which conflicts with all others. The group takes ownership over the system
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE AddExclusiveSystem(TDEngine2::ISystem* pSystem);
+
+			TDE2_API void SetSchedulingMode(E_SYSTEMS_SCHEDULING_MODE mode);
+
+			/*!
+				\brief The method resets time that's accumulated with the previous rate
+
+				\return RC_OK if everything went ok, or some other code, which describes an error
+			*/
+
+			TDE2_API TDEngine2::E_RESULT_CODE SetUpdateRate(const TSystemsGroupUpdateRate& updateRate);
+
+			/*!
+				\brief The method sets a condition which is checked every frame before the update. An empty one means always
+			*/
+
+			TDE2_API void SetRunCondition(const TSystemsGroupRunCondition& condition);
+
+			/*!
+				\brief The method makes the group ignore time of frames. If the value is positive, every frame is treated as a frame
+				of that duration and a FIXED_STEP group runs exactly a single step of that size, so the group's work doesn't depend
+				on the host's speed. It's used by the benchmark, 0 restores the usual behaviour
+			*/
+
+			TDE2_API void SetDeltaTimeOverride(TDEngine2::F32 dt);
+
+			/*!
+				\brief The method makes ON_DEMAND group update its systems within the next frame
+			*/
+
+			TDE2_API void RequestUpdate();
+
+			TDE2_API void InjectBindings(TDEngine2::IWorld* pWorld) override;
+
+			TDE2_API TDEngine2::E_RESULT_CODE AddDefferedCommand(const TCommandFunctor& action = nullptr) override;
+			TDE2_API void ExecuteDefferedCommands() override;
+
+			TDE2_API void OnInit(TDEngine2::TPtr<TDEngine2::IJobManager> pJobManager) override;
+
+			/*!
+				\brief The method updates all active systems of the group
+
+				\param[in] pWorld A pointer to a main scene's object
+				\param[in] dt A delta time's value
+			*/
+
+			TDE2_API void Update(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt) override;
+
+#if TDE2_EDITORS_ENABLED
+			TDE2_API void DebugOutput(TDEngine2::IDebugUtility* pDebugUtility, TDEngine2::F32 dt) const override;
+#endif
+
+			TDE2_API void OnDestroy() override;
+			TDE2_API void OnActivated() override;
+			TDE2_API void OnDeactivated() override;
+
+			TDE2_API bool IsActive() const override;
+
+			TDE2_API const std::string& GetName() const override;
+			TDE2_API TDEngine2::TypeId GetSystemType() const override;
+		protected:
+			DECLARE_INTERFACE_IMPL_PROTECTED_MEMBERS(CSystemsGroup)
+		private:
+			typedef struct TSystemEntry
+			{
+				TDEngine2::TPtr<TDEngine2::ISystem> mpSystem;
+				TSystemAccessInfo                   mAccessInfo;
+				bool                                mIsExclusive;
+			} TSystemEntry, *TSystemEntryPtr;
+
+			typedef std::vector<TDEngine2::U32> TSystemsWave;
+		private:
+			TDE2_API TDEngine2::E_RESULT_CODE _addSystemEntry(TDEngine2::ISystem* pSystem, const TSystemAccessInfo& accessInfo, bool isExclusive);
+
+			TDE2_API void _buildWaves();
+
+			TDE2_API void _updateSystems(TDEngine2::IWorld* pWorld, TDEngine2::F32 dt);
+
+			TDE2_API void _updateWave(const TSystemsWave& wave, TDEngine2::IWorld* pWorld, TDEngine2::F32 dt);
+
+			TDE2_API static bool _hasConflict(const TSystemEntry& left, const TSystemEntry& right);
+		private:
+			std::string                         mName;
+			E_SYSTEMS_SCHEDULING_MODE           mSchedulingMode = E_SYSTEMS_SCHEDULING_MODE::SEQUENTIAL;
+
+			TDEngine2::TPtr<TDEngine2::IJobManager> mpJobManager = nullptr;
+
+			std::vector<TSystemEntry>           mSystems;
+			std::vector<TSystemsWave>           mWaves;
+
+			std::vector<TCommandFunctor>        mDefferedCommandsBuffer;
+
+			TSystemsGroupUpdateRate             mUpdateRate;
+			TSystemsGroupRunCondition           mRunCondition = nullptr;
+
+			TDEngine2::F32                      mAccumulatedTime = 0.0f;
+			TDEngine2::F32                      mDeltaTimeOverride = 0.0f;
+			TDEngine2::U32                      mSkippedFramesCount = 0;
+			bool                                mIsUpdateRequested = false;
+
+			bool                                mIsActive = false;
+	};
+}
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 
 #include <TDEngine2.h>
+#include "../../CComponentsQueries.h"
 #include "../../components/UIComponents.h"
 
 
@@ -67,6 +68,6 @@ namespace Game
 			TDEngine2::TPtr<TDEngine2::IEventManager>     mpEventManager = nullptr;
 			TDEngine2::TPtr<TDEngine2::ISceneManager>     mpSceneManager = nullptr;
 
-			TDEngine2::TComponentsQueryLocalSlice<Game::CMainMenuPanel> mSystemContext;
+			TCachedComponentsQuery<Game::CMainMenuPanel>* mpSystemContext = nullptr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,424 @@
+#include "../include/CAllocationProfiler.h"
+#include <utils/CFileLogger.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#if defined(TDE2_USE_WINPLATFORM)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+	#include <DbgHelp.h>
+	#pragma comment(lib, "dbghelp.lib")
+#else
+	#include <execinfo.h>
+	#include <cxxabi.h>
+	#include <cstdlib>
+#endif
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	constexpr USIZE CAllocationProfiler::DefaultSamplingInterval;
+	constexpr U32 CAllocationProfiler::MaxAllocatorsCount;
+	constexpr U32 CAllocationProfiler::MaxCallstackDepth;
+	constexpr U32 CAllocationProfiler::InvalidAllocatorId;
+	constexpr U32 CAllocationProfiler::SampledBucketsCount;
+	constexpr U32 CAllocationProfiler::SamplesShardsCount;
+
+
+	static constexpr U32 ProfilerFramesCount = 1; ///< _recordSample isn't written into callstacks
+
+
+	static F64 GetTimeInSeconds()
+	{
+		return std::chrono::duration<F64>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static U64 HashCallstack(const void* const* ppFrames, U32 framesCount)
+	{
+		U64 hash = 14695981039346656037ull; /// \note FNV-1a over addresses of frames
+
+		for (U32 i = 0; i < framesCount; i++)
+		{
+			hash ^= static_cast<U64>(reinterpret_cast<uintptr_t>(ppFrames[i]));
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	static inline U64 GetCallsiteKey(U64 callstackHash, U32 allocatorId)
+	{
+		return callstackHash ^ (static_cast<U64>(allocatorId + 1) * 0x9E3779B97F4A7C15ull);
+	}
+
+
+	CAllocationProfiler& CAllocationProfiler::Get()
+	{
+		static CAllocationProfiler instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CAllocationProfiler::Init(USIZE samplingInterval)
+	{
+		if (!samplingInterval)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = Free();
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mSamplingInterval = samplingInterval;
+		mStartTime = GetTimeInSeconds();
+
+		mIsEnabled.store(true, std::memory_order_release);
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CAllocationProfiler::Free()
+	{
+		mIsEnabled.store(false, std::memory_order_release);
+
+		for (TSamplesShard& currShard : mSamplesShards)
+		{
+			std::lock_guard<std::mutex> lock(currShard.mMutex);
+			currShard.mSamples.clear();
+		}
+
+		for (auto& currBucket : mSampledBuckets)
+		{
+			currBucket.store(0, std::memory_order_relaxed);
+		}
+
+		mLiveSamplesCount.store(0, std::memory_order_release);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCallsites.clear();
+
+		return RC_OK;
+	}
+
+	U32 CAllocationProfiler::RegisterAllocator(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto it = std::find(mAllocatorsNames.cbegin(), mAllocatorsNames.cend(), name);
+		if (mAllocatorsNames.cend() != it)
+		{
+			return static_cast<U32>(std::distance(mAllocatorsNames.cbegin(), it));
+		}
+
+		if (mAllocatorsNames.size() >= MaxAllocatorsCount)
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CAllocationProfiler] Allocator {0} couldn't be registered, the limit is reached", name));
+			return InvalidAllocatorId;
+		}
+
+		mAllocatorsNames.push_back(name);
+
+		return static_cast<U32>(mAllocatorsNames.size() - 1);
+	}
+
+	std::vector<TAllocationCallsiteStatistics> CAllocationProfiler::GetCallsitesStatistics() const
+	{
+		std::vector<TAllocationCallsiteStatistics> statistics;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			statistics.reserve(mCallsites.size());
+
+			for (auto&& currCallsiteEntry : mCallsites)
+			{
+				const TCallsite& callsite = currCallsiteEntry.second;
+
+				statistics.push_back({ HashCallstack(callsite.mCallstack.data(), static_cast<U32>(callsite.mCallstack.size())), callsite.mAllocatorId, callsite.mCallstack,
+					callsite.mAllocatedSize, callsite.mLiveSize, callsite.mAllocationsCount, callsite.mSamplesCount });
+			}
+		}
+
+		std::sort(statistics.begin(), statistics.end(), [](const TAllocationCallsiteStatistics& left, const TAllocationCallsiteStatistics& right)
+		{
+			return left.mLiveSize > right.mLiveSize;
+		});
+
+		return statistics;
+	}
+
+	std::vector<TAllocatorProfileStatistics> CAllocationProfiler::GetAllocatorsStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		std::vector<TAllocatorProfileStatistics> statistics;
+
+		for (const std::string& currName : mAllocatorsNames)
+		{
+			statistics.push_back({ currName, 0, 0, 0, 0.0 });
+		}
+
+		for (auto&& currCallsiteEntry : mCallsites)
+		{
+			const TCallsite& callsite = currCallsiteEntry.second;
+
+			TAllocatorProfileStatistics& allocatorStatistics = statistics[callsite.mAllocatorId];
+			allocatorStatistics.mAllocatedSize += callsite.mAllocatedSize;
+			allocatorStatistics.mLiveSize += callsite.mLiveSize;
+			allocatorStatistics.mAllocationsCount += callsite.mAllocationsCount;
+		}
+
+		const F64 elapsedTime = IsEnabled() ? (GetTimeInSeconds() - mStartTime) : 0.0;
+
+		for (TAllocatorProfileStatistics& currStatistics : statistics)
+		{
+			currStatistics.mAllocationRate = (elapsedTime > 0.0) ? (static_cast<F64>(currStatistics.mAllocatedSize) / elapsedTime) : 0.0;
+		}
+
+		return statistics;
+	}
+
+	E_RESULT_CODE CAllocationProfiler::DumpFlameGraph(const std::string& filePath, bool useLiveSize) const
+	{
+		std::ofstream outputFile(filePath, std::ios::out | std::ios::trunc);
+		if (!outputFile.is_open())
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CAllocationProfiler] Couldn't open file {0}", filePath));
+			return RC_FILE_NOT_FOUND;
+		}
+
+		std::vector<std::string> allocatorsNames;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			allocatorsNames = mAllocatorsNames;
+		}
+
+		/// \note Symbols are resolved without the lock, so sampling isn't blocked by the dump
+		const std::vector<TAllocationCallsiteStatistics> callsites = GetCallsitesStatistics();
+
+		std::unordered_map<const void*, std::string> symbols;
+
+		for (const TAllocationCallsiteStatistics& currCallsite : callsites)
+		{
+			const U64 weight = useLiveSize ? currCallsite.mLiveSize : currCallsite.mAllocatedSize;
+			if (!weight)
+			{
+				continue;
+			}
+
+			outputFile << allocatorsNames[currCallsite.mAllocatorId];
+
+			for (auto it = currCallsite.mCallstack.crbegin(); it != currCallsite.mCallstack.crend(); ++it)
+			{
+				auto symbolIt = symbols.find(*it);
+				if (symbols.cend() == symbolIt)
+				{
+					symbolIt = symbols.emplace(*it, _resolveSymbol(*it)).first;
+				}
+
+				outputFile << ";" << symbolIt->second;
+			}
+
+			outputFile << " " << weight << "\n";
+		}
+
+		return outputFile.good() ? RC_OK : RC_FAIL;
+	}
+
+	bool CAllocationProfiler::IsEnabled() const
+	{
+		return mIsEnabled.load(std::memory_order_acquire);
+	}
+
+	std::array<CAllocationProfiler::TThreadCounter, CAllocationProfiler::MaxAllocatorsCount>& CAllocationProfiler::_getThreadCounters()
+	{
+		static thread_local std::array<TThreadCounter, MaxAllocatorsCount> counters {};
+		return counters;
+	}
+
+	U64 CAllocationProfiler::_getNextSampleSize() const
+	{
+		static thread_local U64 randomState = 0x853C49E6748FEA9Bull ^ static_cast<U64>(reinterpret_cast<uintptr_t>(&randomState));
+
+		/// \note xorshift64*, the upper 53 bits give a uniform value within (0, 1]
+		randomState ^= randomState >> 12;
+		randomState ^= randomState << 25;
+		randomState ^= randomState >> 27;
+
+		const F64 uniformValue = static_cast<F64>(((randomState * 2685821657736338717ull) >> 11) + 1) / 9007199254740992.0;
+
+		return static_cast<U64>(-std::log(uniformValue) * static_cast<F64>(mSamplingInterval)) + 1;
+	}
+
+	void CAllocationProfiler::_recordSample(U32 allocatorId, const void* pPtr, USIZE size, U64 weight)
+	{
+		/// \note The callstack is captured right here, so a number of the profiler's own frames doesn't depend on inlining
+		const void* frames[MaxCallstackDepth];
+		U32 framesCount = 0;
+
+#if defined(TDE2_USE_WINPLATFORM)
+		framesCount = static_cast<U32>(CaptureStackBackTrace(ProfilerFramesCount, MaxCallstackDepth, const_cast<void**>(frames), nullptr));
+#else
+		void* rawFrames[MaxCallstackDepth + ProfilerFramesCount];
+
+		const I32 rawFramesCount = backtrace(rawFrames, static_cast<I32>(MaxCallstackDepth + ProfilerFramesCount));
+		if (rawFramesCount > static_cast<I32>(ProfilerFramesCount))
+		{
+			framesCount = static_cast<U32>(rawFramesCount) - ProfilerFramesCount;
+			std::copy(rawFrames + ProfilerFramesCount, rawFrames + rawFramesCount, frames);
+		}
+#endif
+
+		const U64 callsiteKey = GetCallsiteKey(HashCallstack(frames, framesCount), allocatorId);
+
+		/// \note The block was sampled before, but its deallocation wasn't reported (e.g. the allocator was cleared)
+		if (pPtr && mSampledBuckets[_getBucketIndex(pPtr)].load(std::memory_order_relaxed))
+		{
+			_releaseSample(allocatorId, pPtr);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			TCallsite& callsite = mCallsites[callsiteKey];
+
+			if (!callsite.mSamplesCount)
+			{
+				callsite.mAllocatorId = allocatorId;
+				callsite.mCallstack.assign(frames, frames + framesCount);
+			}
+
+			callsite.mAllocatedSize += weight;
+			callsite.mLiveSize += pPtr ? weight : 0;
+			callsite.mAllocationsCount += std::max<U64>(1, weight / std::max<USIZE>(1, size));
+			++callsite.mSamplesCount;
+		}
+
+		if (!pPtr)
+		{
+			return;
+		}
+
+		const U32 bucketIndex = _getBucketIndex(pPtr);
+
+		TSamplesShard& shard = mSamplesShards[bucketIndex % SamplesShardsCount];
+		std::lock_guard<std::mutex> lock(shard.mMutex);
+
+		shard.mSamples[pPtr] = { callsiteKey, weight, allocatorId };
+
+		mSampledBuckets[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+		mLiveSamplesCount.fetch_add(1, std::memory_order_release);
+	}
+
+	void CAllocationProfiler::_releaseSample(U32 allocatorId, const void* pPtr)
+	{
+		const U32 bucketIndex = _getBucketIndex(pPtr);
+
+		TLiveSample sample;
+
+		{
+			TSamplesShard& shard = mSamplesShards[bucketIndex % SamplesShardsCount];
+			std::lock_guard<std::mutex> lock(shard.mMutex);
+
+			auto it = shard.mSamples.find(pPtr);
+			if (shard.mSamples.cend() == it || it->second.mAllocatorId != allocatorId)
+			{
+				return;
+			}
+
+			sample = it->second;
+			shard.mSamples.erase(it);
+
+			mSampledBuckets[bucketIndex].fetch_sub(1, std::memory_order_relaxed);
+			mLiveSamplesCount.fetch_sub(1, std::memory_order_release);
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto it = mCallsites.find(sample.mCallsiteKey);
+		if (mCallsites.end() == it)
+		{
+			return;
+		}
+
+		TCallsite& callsite = it->second;
+		callsite.mLiveSize -= std::min(callsite.mLiveSize, sample.mWeight);
+	}
+
+	U32 CAllocationProfiler::_getBucketIndex(const void* pPtr)
+	{
+		const U64 address = static_cast<U64>(reinterpret_cast<uintptr_t>(pPtr));
+		return static_cast<U32>(((address >> 4) * 0x9E3779B97F4A7C15ull) >> 52) % SampledBucketsCount;
+	}
+
+	std::string CAllocationProfiler::_resolveSymbol(const void* pFrame)
+	{
+		std::string symbol;
+
+#if defined(TDE2_USE_WINPLATFORM)
+		static const bool isSymbolsHandlerInitialized = (TRUE == SymInitialize(GetCurrentProcess(), nullptr, TRUE));
+
+		if (isSymbolsHandlerInitialized)
+		{
+			U8 buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME] {};
+
+			SYMBOL_INFO* pSymbolInfo = reinterpret_cast<SYMBOL_INFO*>(buffer);
+			pSymbolInfo->SizeOfStruct = sizeof(SYMBOL_INFO);
+			pSymbolInfo->MaxNameLen = MAX_SYM_NAME;
+
+			if (SymFromAddr(GetCurrentProcess(), reinterpret_cast<DWORD64>(pFrame), nullptr, pSymbolInfo))
+			{
+				symbol = pSymbolInfo->Name;
+			}
+		}
+#else
+		void* frames[] = { const_cast<void*>(pFrame) };
+
+		if (C8** ppSymbols = backtrace_symbols(frames, 1))
+		{
+			/// \note The format is "module(mangled_name+offset) [address]"
+			const std::string description = ppSymbols[0];
+			std::free(ppSymbols);
+
+			const USIZE nameBegin = description.find('(');
+			const USIZE nameEnd = description.find_first_of("+)", nameBegin);
+
+			if (std::string::npos != nameBegin && std::string::npos != nameEnd && nameEnd > nameBegin + 1)
+			{
+				symbol = description.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+
+				I32 status = -1;
+
+				if (C8* pDemangledName = abi::__cxa_demangle(symbol.c_str(), nullptr, nullptr, &status))
+				{
+					symbol = (0 == status) ? pDemangledName : symbol;
+					std::free(pDemangledName);
+				}
+			}
+		}
+#endif
+
+		if (symbol.empty())
+		{
+			std::ostringstream stream;
+			stream << pFrame;
+
+			symbol = stream.str();
+		}
+
+		/// \note Semicolons separate frames in folded stacks
+		std::replace(symbol.begin(), symbol.end(), ';', ':');
+
+		return symbol;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include "../include/CCollisionGrid2D.h"
+#include "../include/CFrameArena.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	void CCollisionGrid2D::Reset(F32 cellSize)
+	{
+		TDE2_ASSERT(cellSize > 0.0f);
+
+		mObstaclesBounds.clear();
+		mObstaclesEntities.clear();
+		mObstaclesHandles.clear();
+		mObstaclesEnabledFlags.clear();
+		mObstaclesMovedFlags.clear();
+		mMovedObstacles.clear();
+		mCellsOffsets.clear();
+		mCellsItems.clear();
+
+		mCellSize = cellSize;
+		mColumnsCount = 0;
+		mRowsCount = 0;
+	}
+
+	U32 CCollisionGrid2D::AddObstacle(const TGridObstacle& obstacle)
+	{
+		mObstaclesBounds.push_back({ obstacle.mMin, obstacle.mMax });
+		mObstaclesEntities.push_back(obstacle.mEntityId);
+		mObstaclesHandles.push_back(obstacle.mEntityHandle);
+		mObstaclesEnabledFlags.push_back(1);
+		mObstaclesMovedFlags.push_back(0);
+
+		return static_cast<U32>(mObstaclesBounds.size() - 1);
+	}
+
+	void CCollisionGrid2D::Build()
+	{
+		mCellsOffsets.clear();
+		mCellsItems.clear();
+
+		std::fill(mObstaclesMovedFlags.begin(), mObstaclesMovedFlags.end(), 0);
+		mMovedObstacles.clear();
+
+		if (mObstaclesBounds.empty())
+		{
+			mColumnsCount = 0;
+			mRowsCount = 0;
+
+			return;
+		}
+
+		TVector2 boundsMin = mObstaclesBounds.front().mMin;
+		TVector2 boundsMax = mObstaclesBounds.front().mMax;
+
+		for (const TObstacleBounds& currObstacle : mObstaclesBounds)
+		{
+			boundsMin = TVector2(CMathUtils::Min(boundsMin.x, currObstacle.mMin.x), CMathUtils::Min(boundsMin.y, currObstacle.mMin.y));
+			boundsMax = TVector2(CMathUtils::Max(boundsMax.x, currObstacle.mMax.x), CMathUtils::Max(boundsMax.y, currObstacle.mMax.y));
+		}
+
+		/// \note Huge playfields get coarser cells instead of unbounded memory consumption
+		mCellSize = CMathUtils::Max(mCellSize, CMathUtils::Max(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y) / static_cast<F32>(mMaxCellsPerAxis));
+
+		mOrigin = boundsMin;
+		mColumnsCount = std::min<U32>(mMaxCellsPerAxis, static_cast<U32>((boundsMax.x - boundsMin.x) / mCellSize) + 1);
+		mRowsCount = std::min<U32>(mMaxCellsPerAxis, static_cast<U32>((boundsMax.y - boundsMin.y) / mCellSize) + 1);
+
+		/// \note Counting sort: compute sizes of cells first, then scatter indices of obstacles
+		mCellsOffsets.resize(mColumnsCount * mRowsCount + 1, 0);
+
+		for (const TObstacleBounds& currObstacle : mObstaclesBounds)
+		{
+			for (U32 row = _getRow(currObstacle.mMin.y); row <= _getRow(currObstacle.mMax.y); row++)
+			{
+				for (U32 column = _getColumn(currObstacle.mMin.x); column <= _getColumn(currObstacle.mMax.x); column++)
+				{
+					++mCellsOffsets[_getCellIndex(column, row) + 1];
+				}
+			}
+		}
+
+		for (USIZE i = 1; i < mCellsOffsets.size(); i++)
+		{
+			mCellsOffsets[i] += mCellsOffsets[i - 1];
+		}
+
+		mCellsItems.resize(mCellsOffsets.back());
+
+		TFrameVector<U32> cellsCursors(mCellsOffsets.begin(), mCellsOffsets.end() - 1);
+
+		for (U32 i = 0; i < static_cast<U32>(mObstaclesBounds.size()); i++)
+		{
+			const TObstacleBounds& currObstacle = mObstaclesBounds[i];
+
+			for (U32 row = _getRow(currObstacle.mMin.y); row <= _getRow(currObstacle.mMax.y); row++)
+			{
+				for (U32 column = _getColumn(currObstacle.mMin.x); column <= _getColumn(currObstacle.mMax.x); column++)
+				{
+					mCellsItems[cellsCursors[_getCellIndex(column, row)]++] = i;
+				}
+			}
+		}
+
+		mVisitMarks.assign(mObstaclesBounds.size(), 0);
+		mCurrVisitMark = 0;
+	}
+
+	void CCollisionGrid2D::DisableObstacle(U32 obstacleIndex)
+	{
+		if (obstacleIndex >= mObstaclesEnabledFlags.size())
+		{
+			return;
+		}
+
+		mObstaclesEnabledFlags[obstacleIndex] = 0;
+	}
+
+	void CCollisionGrid2D::UpdateObstacle(U32 obstacleIndex, const TVector2& min, const TVector2& max)
+	{
+		if (obstacleIndex >= mObstaclesBounds.size())
+		{
+			return;
+		}
+
+		mObstaclesBounds[obstacleIndex] = { min, max };
+
+		if (!mObstaclesMovedFlags[obstacleIndex])
+		{
+			mObstaclesMovedFlags[obstacleIndex] = 1;
+			mMovedObstacles.push_back(obstacleIndex);
+		}
+	}
+
+
+	/*!
+		\brief The function intersects a segment origin + t * displacement, t in [0; 1] with a box that's expanded by radius.
+		The rounded corners of Minkowski sum are approximated with the square ones which is enough for a ball.
+
+		If the circle already overlaps the box, e.g. the paddle has moved into the ball, the contact is reported at t = 0
+		with a normal of the axis of the least penetration, but only if the circle moves into the box along the normal
+	*/
+
+	static bool SweepCircleVsBox(const TVector2& origin, const TVector2& displacement, F32 radius, const TVector2& boxMin, const TVector2& boxMax, F32& time, TVector2& normal)
+	{
+		const F32 origins[2] { origin.x, origin.y };
+		const F32 directions[2] { displacement.x, displacement.y };
+		const F32 mins[2] { boxMin.x - radius, boxMin.y - radius };
+		const F32 maxs[2] { boxMax.x + radius, boxMax.y + radius };
+
+		if (origins[0] > mins[0] && origins[0] < maxs[0] && origins[1] > mins[1] && origins[1] < maxs[1])
+		{
+			F32 minPenetration = (std::numeric_limits<F32>::max)();
+
+			for (U32 axis = 0; axis < 2; axis++)
+			{
+				const F32 penetrations[2] { origins[axis] - mins[axis], maxs[axis] - origins[axis] };
+
+				for (U32 side = 0; side < 2; side++)
+				{
+					if (penetrations[side] >= minPenetration)
+					{
+						continue;
+					}
+
+					minPenetration = penetrations[side];
+
+					const F32 sign = side ? 1.0f : -1.0f;
+					normal = (0 == axis) ? TVector2(sign, 0.0f) : TVector2(0.0f, sign);
+				}
+			}
+
+			/// \note The circle that moves out of the box is left alone, otherwise it would be reflected back inside
+			if (directions[0] * normal.x + directions[1] * normal.y >= 0.0f)
+			{
+				return false;
+			}
+
+			time = 0.0f;
+
+			return true;
+		}
+
+		F32 enterTime = -(std::numeric_limits<F32>::max)();
+		F32 exitTime = (std::numeric_limits<F32>::max)();
+
+		U32 enterAxis = 0;
+
+		for (U32 axis = 0; axis < 2; axis++)
+		{
+			if (CMathUtils::Abs(directions[axis]) < FloatEpsilon)
+			{
+				if (origins[axis] <= mins[axis] || origins[axis] >= maxs[axis])
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			const F32 invDirection = 1.0f / directions[axis];
+
+			F32 nearTime = (mins[axis] - origins[axis]) * invDirection;
+			F32 farTime = (maxs[axis] - origins[axis]) * invDirection;
+
+			if (nearTime > farTime)
+			{
+				std::swap(nearTime, farTime);
+			}
+
+			if (nearTime > enterTime)
+			{
+				enterTime = nearTime;
+				enterAxis = axis;
+			}
+
+			exitTime = CMathUtils::Min(exitTime, farTime);
+		}
+
+		/// \note Negative enterTime means the box is behind the circle, overlaps are handled above
+		if (enterTime > exitTime || enterTime < 0.0f || enterTime > 1.0f)
+		{
+			return false;
+		}
+
+		time = enterTime;
+		normal = (0 == enterAxis) ? TVector2(directions[0] > 0.0f ? -1.0f : 1.0f, 0.0f) : TVector2(0.0f, directions[1] > 0.0f ? -1.0f : 1.0f);
+
+		return true;
+	}
+
+
+	bool CCollisionGrid2D::SweepCircle(const TVector2& origin, const TVector2& displacement, F32 radius, TSweptCircleHit& hit) const
+	{
+		if (mCellsOffsets.empty())
+		{
+			return false;
+		}
+
+		/// \note The visit marks are reset only when the counter overflows
+		if (0 == ++mCurrVisitMark)
+		{
+			std::fill(mVisitMarks.begin(), mVisitMarks.end(), 0);
+			mCurrVisitMark = 1;
+		}
+
+		const TVector2 target = origin + displacement;
+
+		const U32 firstColumn = _getColumn(CMathUtils::Min(origin.x, target.x) - radius);
+		const U32 lastColumn  = _getColumn(CMathUtils::Max(origin.x, target.x) + radius);
+		const U32 firstRow    = _getRow(CMathUtils::Min(origin.y, target.y) - radius);
+		const U32 lastRow     = _getRow(CMathUtils::Max(origin.y, target.y) + radius);
+
+		bool hasHit = false;
+
+		hit.mTime = 1.0f;
+
+		auto testObstacle = [&](U32 obstacleIndex)
+		{
+			F32 time = 0.0f;
+			TVector2 normal;
+
+			const TObstacleBounds& bounds = mObstaclesBounds[obstacleIndex];
+
+			if (!SweepCircleVsBox(origin, displacement, radius, bounds.mMin, bounds.mMax, time, normal) || time > hit.mTime)
+			{
+				return;
+			}
+
+			hit.mEntityId = mObstaclesEntities[obstacleIndex];
+			hit.mEntityHandle = mObstaclesHandles[obstacleIndex];
+			hit.mObstacleIndex = obstacleIndex;
+			hit.mTime = time;
+			hit.mNormal = normal;
+
+			hasHit = true;
+		};
+
+		for (U32 row = firstRow; row <= lastRow; row++)
+		{
+			for (U32 column = firstColumn; column <= lastColumn; column++)
+			{
+				const U32 cellIndex = _getCellIndex(column, row);
+
+				for (U32 i = mCellsOffsets[cellIndex]; i < mCellsOffsets[cellIndex + 1]; i++)
+				{
+					const U32 obstacleIndex = mCellsItems[i];
+
+					if (mVisitMarks[obstacleIndex] == mCurrVisitMark || !mObstaclesEnabledFlags[obstacleIndex] || mObstaclesMovedFlags[obstacleIndex])
+					{
+						continue;
+					}
+
+					mVisitMarks[obstacleIndex] = mCurrVisitMark;
+
+					testObstacle(obstacleIndex);
+				}
+			}
+		}
+
+		for (const U32 currObstacleIndex : mMovedObstacles)
+		{
+			if (mObstaclesEnabledFlags[currObstacleIndex])
+			{
+				testObstacle(currObstacleIndex);
+			}
+		}
+
+		return hasHit;
+	}
+
+	U32 CCollisionGrid2D::_getCellIndex(U32 column, U32 row) const
+	{
+		return row * mColumnsCount + column;
+	}
+
+	U32 CCollisionGrid2D::_getColumn(F32 x) const
+	{
+		const F32 column = std::floor((x - mOrigin.x) / mCellSize);
+		return static_cast<U32>(CMathUtils::Clamp(0.0f, static_cast<F32>(mColumnsCount - 1), column));
+	}
+
+	U32 CCollisionGrid2D::_getRow(F32 y) const
+	{
+		const F32 row = std::floor((y - mOrigin.y) / mCellSize);
+		return static_cast<U32>(CMathUtils::Clamp(0.0f, static_cast<F32>(mRowsCount - 1), row));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "../include/CCollisionsRouter.h"
+#include "../include/Components.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CCollisionsRouter::CCollisionsRouter() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CCollisionsRouter::Init(TPtr<IWorld> pWorld, TPtr<IEventManager> pEventManager)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pWorld || !pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpWorld = pWorld;
+		mpEventManager = pEventManager;
+
+		E_RESULT_CODE result = pEventManager->Subscribe(TOn3DCollisionRegisteredEvent::GetTypeId(), this);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mBallCollisionSubscriptionId = CEventChannels::Get().Subscribe<TBallCollisionEvent>([this](const TBallCollisionEvent& event)
+		{
+			_dispatch(event.mBallEntityId, event.mBallEntityHandle, event.mOtherEntityId, event.mOtherEntityHandle, event.mContactNormal);
+		});
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CCollisionsRouter::_onFreeInternal()
+	{
+		E_RESULT_CODE result = RC_OK;
+		result = result | mpEventManager->Unsubscribe(TOn3DCollisionRegisteredEvent::GetTypeId(), this);
+		result = result | CEventChannels::Get().Unsubscribe<TBallCollisionEvent>(mBallCollisionSubscriptionId);
+
+		mHandlers.clear();
+
+		return result;
+	}
+
+	E_RESULT_CODE CCollisionsRouter::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (TOn3DCollisionRegisteredEvent::GetTypeId() != pEvent->GetEventType())
+		{
+			return RC_FAIL;
+		}
+
+		const TOn3DCollisionRegisteredEvent* pCollisionEvent = static_cast<const TOn3DCollisionRegisteredEvent*>(pEvent);
+
+		if (TOn3DCollisionRegisteredEvent::E_COLLISION_EVENT_TYPE::ON_ENTER != pCollisionEvent->mType)
+		{
+			return RC_OK;
+		}
+
+		_dispatch(pCollisionEvent->mEntities[0], pCollisionEvent->mEntities[1], pCollisionEvent->mContactNormal);
+
+		return RC_OK;
+	}
+
+	TEventListenerId CCollisionsRouter::GetListenerId() const
+	{
+		return TEventListenerId(GetTypeId());
+	}
+
+	E_RESULT_CODE CCollisionsRouter::_registerHandlerInternal(TypeId firstTypeId, TypeId secondTypeId, const THandlerFunctor& handler)
+	{
+		if (!handler || TypeId::Invalid == firstTypeId || TypeId::Invalid == secondTypeId)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mHandlers[firstTypeId].push_back({ secondTypeId, handler });
+
+		return RC_OK;
+	}
+
+	void CCollisionsRouter::_dispatch(TEntityId firstEntityId, TEntityId secondEntityId, const TVector3& contactNormal)
+	{
+		if (mHandlers.empty())
+		{
+			return;
+		}
+
+		CEntityHandlesTable& entityHandles = CEntityHandlesTable::Get();
+
+		_dispatch(firstEntityId, entityHandles.Resolve(firstEntityId), secondEntityId, entityHandles.Resolve(secondEntityId), contactNormal);
+	}
+
+	void CCollisionsRouter::_dispatch(TEntityId firstEntityId, TEntityHandle firstEntityHandle, TEntityId secondEntityId, TEntityHandle secondEntityHandle,
+		const TVector3& contactNormal)
+	{
+		if (mHandlers.empty())
+		{
+			return;
+		}
+
+		CEntityHandlesTable& entityHandles = CEntityHandlesTable::Get();
+
+		if (!entityHandles.GetEntity(firstEntityHandle) || !entityHandles.GetEntity(secondEntityHandle))
+		{
+			return;
+		}
+
+		/// \note Copies are taken, because handlers could add or remove components of the entities
+		const std::vector<IComponent*>& firstEntityComponents = entityHandles.GetComponents(firstEntityHandle);
+		const std::vector<IComponent*>& secondEntityComponents = entityHandles.GetComponents(secondEntityHandle);
+
+		const TFrameVector<IComponent*> firstComponents(firstEntityComponents.cbegin(), firstEntityComponents.cend());
+		const TFrameVector<IComponent*> secondComponents(secondEntityComponents.cbegin(), secondEntityComponents.cend());
+
+		TCollisionContactInfo contactInfo;
+		contactInfo.mFirstEntityId = firstEntityId;
+		contactInfo.mSecondEntityId = secondEntityId;
+		contactInfo.mFirstEntityHandle = firstEntityHandle;
+		contactInfo.mSecondEntityHandle = secondEntityHandle;
+		contactInfo.mContactNormal = contactNormal;
+
+		_dispatchOrdered(firstComponents, secondComponents, contactInfo);
+
+		/// \note A pair could be registered in any order, so try the swapped one too
+		std::swap(contactInfo.mFirstEntityId, contactInfo.mSecondEntityId);
+		std::swap(contactInfo.mFirstEntityHandle, contactInfo.mSecondEntityHandle);
+		contactInfo.mContactNormal = -contactNormal;
+
+		_dispatchOrdered(secondComponents, firstComponents, contactInfo);
+	}
+
+	void CCollisionsRouter::_dispatchOrdered(const TFrameVector<IComponent*>& firstComponents, const TFrameVector<IComponent*>& secondComponents,
+		const TCollisionContactInfo& contactInfo)
+	{
+		for (IComponent* pFirstComponent : firstComponents)
+		{
+			auto it = mHandlers.find(pFirstComponent->GetComponentTypeId());
+			if (mHandlers.cend() == it)
+			{
+				continue;
+			}
+
+			for (const THandlerEntry& currEntry : it->second)
+			{
+				for (IComponent* pSecondComponent : secondComponents)
+				{
+					if (pSecondComponent->GetComponentTypeId() != currEntry.mSecondTypeId)
+					{
+						continue;
+					}
+
+					currEntry.mHandler(pFirstComponent, pSecondComponent, contactInfo);
+					break;
+				}
+			}
+		}
+	}
+
+
+	TDE2_API CCollisionsRouter* CreateCollisionsRouter(TPtr<IWorld> pWorld, TPtr<IEventManager> pEventManager, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CCollisionsRouter, CCollisionsRouter, result, pWorld, pEventManager);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include "../include/CComponentsQueries.h"
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	/*!
+		\brief CBaseComponentsQuery's definition
+	*/
+
+	CBaseComponentsQuery::CBaseComponentsQuery(IWorld* pWorld, std::vector<TypeId>&& componentsTypes) :
+		mpWorld(pWorld), mComponentsTypes(std::move(componentsTypes)), mComponentsVersions(mComponentsTypes.size())
+	{
+	}
+
+	CBaseComponentsQuery::~CBaseComponentsQuery()
+	{
+		for (IComponentsQueryListener* pCurrListener : mListeners)
+		{
+			pCurrListener->OnQueryDestroyed();
+		}
+	}
+
+	void CBaseComponentsQuery::AddListener(IComponentsQueryListener* pListener)
+	{
+		if (!pListener)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mListeners.push_back(pListener);
+
+		for (USIZE i = 0; i < mEntities.size(); i++)
+		{
+			pListener->OnElementAppended(i);
+		}
+	}
+
+	void CBaseComponentsQuery::RemoveListener(IComponentsQueryListener* pListener)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mListeners.erase(std::remove(mListeners.begin(), mListeners.end(), pListener), mListeners.end());
+	}
+
+	void CBaseComponentsQuery::MarkEntityDirty(TEntityId entityId)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (mNeedsRebuild)
+		{
+			return;
+		}
+
+		/// \note A query that isn't read for a long time is cheaper to collect again than to replay all the changes
+		if (mDirtyEntities.size() >= mEntities.size() + mMaxDirtyEntitiesSlack)
+		{
+			mDirtyEntities.clear();
+			mNeedsRebuild = true;
+
+			return;
+		}
+
+		mDirtyEntities.push_back(entityId);
+	}
+
+	void CBaseComponentsQuery::Invalidate(bool isTracked)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mIsTracked = isTracked;
+		mNeedsRebuild = true;
+
+		mDirtyEntities.clear();
+	}
+
+	bool CBaseComponentsQuery::DependsOn(TypeId componentTypeId) const
+	{
+		return std::find(mComponentsTypes.cbegin(), mComponentsTypes.cend(), componentTypeId) != mComponentsTypes.cend();
+	}
+
+	bool CBaseComponentsQuery::Contains(TEntityId entityId) const
+	{
+		return mEntitiesIndices.find(entityId) != mEntitiesIndices.cend();
+	}
+
+	IWorld* CBaseComponentsQuery::GetWorld() const
+	{
+		return mpWorld;
+	}
+
+	void CBaseComponentsQuery::MarkComponentChanged(TEntityId entityId, TypeId componentTypeId, U32 version)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto it = mEntitiesIndices.find(entityId);
+		if (mEntitiesIndices.cend() == it)
+		{
+			return;
+		}
+
+		const USIZE typeIndex = static_cast<USIZE>(std::distance(mComponentsTypes.cbegin(), std::find(mComponentsTypes.cbegin(), mComponentsTypes.cend(), componentTypeId)));
+		if (typeIndex >= mComponentsTypes.size())
+		{
+			return;
+		}
+
+		mComponentsVersions[typeIndex][it->second] = version;
+		mLatestVersion = std::max(mLatestVersion, version);
+	}
+
+	U32 CBaseComponentsQuery::GetStructureVersion() const
+	{
+		return mStructureVersion;
+	}
+
+	bool CBaseComponentsQuery::HasChangedSince(U32 version) const
+	{
+		return mStructureVersion >= version || mLatestVersion >= version;
+	}
+
+	bool CBaseComponentsQuery::HasChangedSince(USIZE index, U32 version) const
+	{
+		for (const std::vector<U32>& currVersions : mComponentsVersions)
+		{
+			if (currVersions[index] >= version)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CBaseComponentsQuery::_takeDisabledEntitiesSnapshot()
+	{
+		CComponentsQueriesCache::Get().CopyDisabledEntitiesMask(mDisabledEntitiesMask);
+	}
+
+	bool CBaseComponentsQuery::_isEntityActive(CEntity* pEntity) const
+	{
+		if (pEntity->HasComponent<CDeactivatedComponent>() || pEntity->HasComponent<CDeactivatedGroupComponent>())
+		{
+			return false;
+		}
+
+		const USIZE index = static_cast<USIZE>(pEntity->GetId());
+		const USIZE wordIndex = index / 64;
+
+		return wordIndex >= mDisabledEntitiesMask.size() || !(mDisabledEntitiesMask[wordIndex] & (1ull << (index % 64)));
+	}
+
+	void CBaseComponentsQuery::_resetVersions(U32 version)
+	{
+		for (std::vector<U32>& currVersions : mComponentsVersions)
+		{
+			currVersions.clear();
+		}
+
+		mStructureVersion = version;
+		mLatestVersion = version;
+
+		for (IComponentsQueryListener* pCurrListener : mListeners)
+		{
+			pCurrListener->OnElementsCleared();
+		}
+	}
+
+	void CBaseComponentsQuery::_appendVersions(U32 version)
+	{
+		for (std::vector<U32>& currVersions : mComponentsVersions)
+		{
+			currVersions.push_back(version);
+		}
+
+		/// \note Arrays of readers that are indexed by elements of the query should grow, so it's a structural change too
+		mStructureVersion = version;
+		mLatestVersion = std::max(mLatestVersion, version);
+
+		for (IComponentsQueryListener* pCurrListener : mListeners)
+		{
+			pCurrListener->OnElementAppended(mEntities.size() - 1);
+		}
+	}
+
+	void CBaseComponentsQuery::_stampVersions(USIZE index, U32 version)
+	{
+		for (std::vector<U32>& currVersions : mComponentsVersions)
+		{
+			currVersions[index] = version;
+		}
+
+		mLatestVersion = std::max(mLatestVersion, version);
+	}
+
+	void CBaseComponentsQuery::_removeVersions(USIZE index, U32 version)
+	{
+		for (std::vector<U32>& currVersions : mComponentsVersions)
+		{
+			currVersions[index] = currVersions.back();
+			currVersions.pop_back();
+		}
+
+		mStructureVersion = version;
+
+		for (IComponentsQueryListener* pCurrListener : mListeners)
+		{
+			pCurrListener->OnElementRemoved(index);
+		}
+	}
+
+
+	/*!
+		\brief CComponentsQueriesCache's definition
+	*/
+
+	CComponentsQueriesCache& CComponentsQueriesCache::Get()
+	{
+		static CComponentsQueriesCache instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CComponentsQueriesCache::Init(TPtr<IEventManager> pEventManager)
+	{
+		if (mpEventManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | pEventManager->Subscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		/// \note Queries could be collected before the subscription, so they can't be trusted
+		for (auto& pCurrQuery : mQueries)
+		{
+			if (pCurrQuery)
+			{
+				pCurrQuery->Invalidate(true);
+			}
+		}
+
+		mpEventManager = pEventManager;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CComponentsQueriesCache::Free()
+	{
+		if (!mpEventManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | mpEventManager->Unsubscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		mpEventManager = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(mDisabledEntitiesMutex);
+			mDisabledEntitiesMask.clear();
+		}
+
+		/// \note Systems keep pointers to the queries, so they're just switched into untracked mode
+		for (auto& pCurrQuery : mQueries)
+		{
+			if (pCurrQuery)
+			{
+				pCurrQuery->Invalidate(false);
+			}
+		}
+
+		return result;
+	}
+
+	E_RESULT_CODE CComponentsQueriesCache::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (const TOnComponentCreatedEvent* pComponentCreatedEvent = dynamic_cast<const TOnComponentCreatedEvent*>(pEvent))
+		{
+			_onComponentChanged(pComponentCreatedEvent->mEntityId, pComponentCreatedEvent->mCreatedComponentTypeId);
+			return RC_OK;
+		}
+
+		if (const TOnComponentRemovedEvent* pComponentRemovedEvent = dynamic_cast<const TOnComponentRemovedEvent*>(pEvent))
+		{
+			for (const TypeId currTypeId : pComponentRemovedEvent->mRemovedComponentsTypeId)
+			{
+				_onComponentChanged(pComponentRemovedEvent->mEntityId, currTypeId);
+			}
+
+			return RC_OK;
+		}
+
+		if (const TOnEntityRemovedEvent* pEntityRemovedEvent = dynamic_cast<const TOnEntityRemovedEvent*>(pEvent))
+		{
+			SetEntityEnabled(pEntityRemovedEvent->mRemovedEntityId, true);
+
+			for (auto& pCurrQuery : mQueries)
+			{
+				if (pCurrQuery && pCurrQuery->Contains(pEntityRemovedEvent->mRemovedEntityId))
+				{
+					pCurrQuery->MarkEntityDirty(pEntityRemovedEvent->mRemovedEntityId);
+				}
+			}
+
+			return RC_OK;
+		}
+
+		return RC_FAIL;
+	}
+
+	void CComponentsQueriesCache::MarkComponentChanged(TEntityId entityId, TypeId componentTypeId)
+	{
+		const U32 version = GetWorldVersion();
+
+		for (auto& pCurrQuery : mQueries)
+		{
+			if (pCurrQuery && pCurrQuery->DependsOn(componentTypeId))
+			{
+				pCurrQuery->MarkComponentChanged(entityId, componentTypeId, version);
+			}
+		}
+	}
+
+	void CComponentsQueriesCache::SetEntityEnabled(TEntityId entityId, bool isEnabled)
+	{
+		if (TEntityId::Invalid == entityId)
+		{
+			return;
+		}
+
+		const USIZE index = static_cast<USIZE>(entityId);
+		const USIZE wordIndex = index / 64;
+		const U64 bitMask = 1ull << (index % 64);
+
+		{
+			std::lock_guard<std::mutex> lock(mDisabledEntitiesMutex);
+
+			if (wordIndex >= mDisabledEntitiesMask.size())
+			{
+				if (isEnabled)
+				{
+					return;
+				}
+
+				mDisabledEntitiesMask.resize(wordIndex + 1, 0);
+			}
+
+			U64& word = mDisabledEntitiesMask[wordIndex];
+
+			if (isEnabled == !(word & bitMask))
+			{
+				return;
+			}
+
+			word ^= bitMask;
+		}
+
+		_markEntityDirty(entityId);
+	}
+
+	bool CComponentsQueriesCache::IsEntityEnabled(TEntityId entityId) const
+	{
+		const USIZE index = static_cast<USIZE>(entityId);
+		const USIZE wordIndex = index / 64;
+
+		std::lock_guard<std::mutex> lock(mDisabledEntitiesMutex);
+
+		return wordIndex >= mDisabledEntitiesMask.size() || !(mDisabledEntitiesMask[wordIndex] & (1ull << (index % 64)));
+	}
+
+	void CComponentsQueriesCache::CopyDisabledEntitiesMask(std::vector<U64>& mask) const
+	{
+		std::lock_guard<std::mutex> lock(mDisabledEntitiesMutex);
+
+		/// \note The assignment reuses the capacity of the copy, so a query doesn't allocate on every read
+		mask.assign(mDisabledEntitiesMask.cbegin(), mDisabledEntitiesMask.cend());
+	}
+
+	U32 CComponentsQueriesCache::GetWorldVersion() const
+	{
+		return mWorldVersion.load(std::memory_order_acquire);
+	}
+
+	U32 CComponentsQueriesCache::AdvanceWorldVersion()
+	{
+		return mWorldVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+	}
+
+	TEventListenerId CComponentsQueriesCache::GetListenerId() const
+	{
+		return TEventListenerId(TDE2_TYPE_ID(CComponentsQueriesCache));
+	}
+
+	U32 CComponentsQueriesCache::_allocateSlotIndex()
+	{
+		static U32 slotsCounter = 0;
+		return slotsCounter++;
+	}
+
+	std::unique_ptr<CBaseComponentsQuery>& CComponentsQueriesCache::_getSlot(U32 slotIndex)
+	{
+		if (slotIndex >= mQueries.size())
+		{
+			mQueries.resize(slotIndex + 1);
+		}
+
+		return mQueries[slotIndex];
+	}
+
+	void CComponentsQueriesCache::_onComponentChanged(TEntityId entityId, TypeId componentTypeId)
+	{
+		/// \note Activity of an entity is a pair of flag components, so it affects all queries
+		const bool isActivityChanged = (CDeactivatedComponent::GetTypeId() == componentTypeId) || (CDeactivatedGroupComponent::GetTypeId() == componentTypeId);
+
+		for (auto& pCurrQuery : mQueries)
+		{
+			if (pCurrQuery && (isActivityChanged || pCurrQuery->DependsOn(componentTypeId)))
+			{
+				pCurrQuery->MarkEntityDirty(entityId);
+			}
+		}
+	}
+
+	void CComponentsQueriesCache::_markEntityDirty(TEntityId entityId)
+	{
+		for (auto& pCurrQuery : mQueries)
+		{
+			if (pCurrQuery)
+			{
+				pCurrQuery->MarkEntityDirty(entityId);
+			}
+		}
+	}
+
+
+	U32 GetWorldVersion()
+	{
+		return CComponentsQueriesCache::Get().GetWorldVersion();
+	}
+
+	U32 AdvanceWorldVersion()
+	{
+		return CComponentsQueriesCache::Get().AdvanceWorldVersion();
+	}
+
+	void MarkComponentChanged(TEntityId entityId, TypeId componentTypeId)
+	{
+		CComponentsQueriesCache::Get().MarkComponentChanged(entityId, componentTypeId);
+	}
+
+	void SetEntityEnabled(TEntityId entityId, bool isEnabled)
+	{
+		CComponentsQueriesCache::Get().SetEntityEnabled(entityId, isEnabled);
+	}
+
+	bool IsEntityEnabled(TEntityId entityId)
+	{
+		return CComponentsQueriesCache::Get().IsEntityEnabled(entityId);
+	}
+}
\ No newline at end of file
@@ -2,6 +2,21 @@
 #include "../include/Components.h"
 #include "../include/Utilities.h"
 #include "../include/GameModes.h"
+#include "../include/CCollisionsRouter.h"
+#include "../include/CEntitiesPool.h"
+#include "../include/CEntityCommandBuffer.h"
+#include "../include/CWorldSingletons.h"
+#include "../include/CComponentsQueries.h"
+#include "../include/CEntityHandles.h"
+#include "../include/CEventChannels.h"
+#include "../include/CPrefabTemplates.h"
+#include "../include/CGameLevelsCatalog.h"
+#include "../include/CGameLevelsPrefetcher.h"
+#include "../include/CGameLevelSnapshot.h"
+#include "../include/CSceneStreamer.h"
+#include "../include/CSceneArenas.h"
+#include "../include/CFrameArena.h"
+#include "../include/CAllocationProfiler.h"
 #include "../include/systems/CPaddleControlSystem.h"
 #include "../include/systems/CBallUpdateSystem.h"
 #include "../include/systems/CDamageablesUpdateSystem.h"
@@ -11,8 +26,10 @@
 #include "../include/systems/CStickyBallsProcessSystem.h"
 #include "../include/systems/CPowerUpSpawnSystem.h"
 #include "../include/systems/CProjectilesPoolSystem.h"
+#include "../include/systems/CEntityCommandBufferSystem.h"
 #include "../include/systems/CGameUIUpdateSystem.h"
 #include "../include/systems/CPaddlePositionerSystem.h"
+#include "../include/systems/CSystemsGroup.h"
 #include "../include/systems/UI/CMainMenuLogicSystem.h"
 #include "../include/systems/UI/CPauseMenuLogicSystem.h"
 #include "../include/systems/UI/COptionsMenuLogicSystem.h"
@@ -33,37 +50,137 @@ namespace Game
 		TPtr<IDesktopInputContext> pInputContext, 
 		TPtr<IEventManager> pEventManager, 
 		TPtr<ISceneManager> pSceneManager,
-		TPtr<IGameModesManager> pGameModesManager)
+		TPtr<IResourceManager> pResourceManager,
+		TPtr<IGameModesManager> pGameModesManager,
+		E_SYSTEMS_SCHEDULING_MODE schedulingMode,
+		F32 groupsDeltaTimeOverride,
+		const std::function<ISystem*(ISystem*, const std::string&)>& decorateSystem)
 	{
 		TDEngine2::E_RESULT_CODE result = TDEngine2::RC_OK;
 
-		pWorld->RegisterSystem(Game::CreatePaddleControlSystem(pInputContext, pSceneManager, result));
-		pWorld->RegisterSystem(Game::CreateBallUpdateSystem(pEventManager, pInputContext, result));
-		pWorld->RegisterSystem(Game::CreateDamageablesUpdateSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateGravityUpdateSystem(result));
-		pWorld->RegisterSystem(Game::CreateStickyBallsProcessSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreatePowerUpSpawnSystem(pEventManager, pSceneManager, result));
+		/// \note Systems are registered as groups, a group updates its independent systems concurrently.
+		/// Groups themselves aren't decorated, their systems are
+		CSystemsGroup* pInputSystems = CreateSystemsGroup("InputSystemsGroup", schedulingMode, result);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		CSystemsGroup* pSimulationSystems = CreateSystemsGroup("SimulationSystemsGroup", schedulingMode, result);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		CSystemsGroup* pPresentationSystems = CreateSystemsGroup("PresentationSystemsGroup", schedulingMode, result);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		CSystemsGroup* pUISystems = CreateSystemsGroup("UISystemsGroup", schedulingMode, result);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		/// \note Systems which react on pressed keys or follow the paddle are updated every frame, otherwise a press could fall between fixed steps
+		pInputSystems->SetRunCondition(IsGameplayRunning);
+
+		pSimulationSystems->SetRunCondition(IsGameplayRunning);
+		result = result | pSimulationSystems->SetUpdateRate(TSystemsGroupUpdateRate::FixedStep(1.0f / 60.0f));
+
+		/// \note Labels change only when the score or lives do, CGameUIUpdateSystem requests an update from handlers of these events
+		result = result | pPresentationSystems->SetUpdateRate(TSystemsGroupUpdateRate::OnDemand());
+
+		for (CSystemsGroup* pCurrGroup : { pInputSystems, pSimulationSystems, pPresentationSystems, pUISystems })
+		{
+			pCurrGroup->SetDeltaTimeOverride(groupsDeltaTimeOverride);
+		}
+
+		/// \note Accesses are taken from the original system, a decorator just forwards calls into it
+		auto addSystem = [&decorateSystem](CSystemsGroup* pGroup, ISystem* pSystem)
+		{
+			ISystem* pDecoratedSystem = decorateSystem ? decorateSystem(pSystem, pGroup->GetName()) : pSystem;
+
+			if (const ISystemAccessProvider* pAccessProvider = dynamic_cast<const ISystemAccessProvider*>(pSystem))
+			{
+				pGroup->AddSystem(pDecoratedSystem, pAccessProvider->GetAccessInfo());
+				return;
+			}
+
+			pGroup->AddExclusiveSystem(pDecoratedSystem);
+		};
+
+		auto registerSystem = [&pWorld, &decorateSystem](ISystem* pSystem)
+		{
+			pWorld->RegisterSystem(decorateSystem ? decorateSystem(pSystem, std::string()) : pSystem);
+		};
+
+		/// \note The router is shared between all systems that process contacts, it's released together with the last of them
+		TPtr<CCollisionsRouter> pCollisionsRouter = TPtr<CCollisionsRouter>(CreateCollisionsRouter(pWorld, pEventManager, result));
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		/// \note Instances of frequently spawned prefabs are reused by all systems, the pool is prewarmed on each level's loading
+		TPtr<CEntitiesPool> pEntitiesPool = TPtr<CEntitiesPool>(CreateEntitiesPool(pSceneManager, pEventManager, result));
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		/// \note Structural changes that are made by systems during the update are recorded here and applied at once
+		TPtr<CEntityCommandBuffer> pCommandBuffer = TPtr<CEntityCommandBuffer>(CreateEntityCommandBuffer(pWorld, pEntitiesPool, result));
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		addSystem(pInputSystems, Game::CreatePaddleControlSystem(pInputContext, pEntitiesPool, result));
+		addSystem(pInputSystems, Game::CreateBallUpdateSystem(pEventManager, pInputContext, pCommandBuffer, result));
+		addSystem(pInputSystems, Game::CreateStickyBallsProcessSystem(pCollisionsRouter, pCommandBuffer, result));
+
+		pWorld->RegisterSystem(pInputSystems);
+
+		addSystem(pSimulationSystems, Game::CreateDamageablesUpdateSystem(pEventManager, pCollisionsRouter, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateGravityUpdateSystem(pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreatePowerUpSpawnSystem(pEventManager, pResourceManager, pEntitiesPool, result));
 
 		// bonuses' systems
-		pWorld->RegisterSystem(Game::CreateAddScoreBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateScoreMultiplierBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateGodModeBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateExpandPaddleBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateStickyPaddleBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateExtraLifeBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateLaserBonusCollectSystem(pEventManager, result));
-		pWorld->RegisterSystem(Game::CreateMultipleBallsBonusCollectSystem(pEventManager, pSceneManager, result));
+		addSystem(pSimulationSystems, Game::CreateAddScoreBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateScoreMultiplierBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateGodModeBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateExpandPaddleBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateStickyPaddleBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateExtraLifeBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateLaserBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
+		addSystem(pSimulationSystems, Game::CreateMultipleBallsBonusCollectSystem(pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer, result));
 
-		pWorld->RegisterSystem(Game::CreateProjectilesPoolSystem(result));
-		pWorld->RegisterSystem(Game::CreateGameUIUpdateSystem(pEventManager, result));
+		addSystem(pSimulationSystems, Game::CreateProjectilesPoolSystem(pCommandBuffer, result));
 
-		pWorld->RegisterSystem(Game::CreatePaddlePositionerSystem(pEventManager, result));
+		addSystem(pSimulationSystems, Game::CreatePaddlePositionerSystem(pEventManager, result));
+
+		/// \note Commands of a step are played back before the next one, so a step never sees entities that are already destroyed
+		addSystem(pSimulationSystems, Game::CreateEntityCommandBufferSystem(pCommandBuffer, result));
+
+		pWorld->RegisterSystem(pSimulationSystems);
+
+		addSystem(pPresentationSystems, Game::CreateGameUIUpdateSystem(pPresentationSystems, result));
+
+		pWorld->RegisterSystem(pPresentationSystems);
 
 		/// UI systems
-		pWorld->RegisterSystem(Game::CreateMainMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
-		pWorld->RegisterSystem(Game::CreatePauseMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
-		pWorld->RegisterSystem(Game::CreateOptionsMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
-		pWorld->RegisterSystem(Game::CreateCreditsMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
+		addSystem(pUISystems, Game::CreateMainMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
+		addSystem(pUISystems, Game::CreatePauseMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
+		addSystem(pUISystems, Game::CreateOptionsMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
+		addSystem(pUISystems, Game::CreateCreditsMenuLogicSystem({ pGameModesManager, pEventManager, pSceneManager }, result));
+
+		pWorld->RegisterSystem(pUISystems);
+
+		/// \note Should be the last one to play back commands of all systems above including ones of input systems
+		registerSystem(Game::CreateEntityCommandBufferSystem(pCommandBuffer, result));
 
 		return result;
 	}
@@ -81,13 +198,32 @@ E_RESULT_CODE CCustomEngineListener::OnStart()
 	pEventManager->Subscribe(TLoadSettingsMenuEvent::GetTypeId(), this);
 	pEventManager->Subscribe(TLoadCreditsMenuEvent::GetTypeId(), this);
 
+	CWorldSingletonsCache::Get().Init(pEventManager);
+	CComponentsQueriesCache::Get().Init(pEventManager);
+	CEntityHandlesTable::Get().Init(mpWorld, pEventManager);
+	CFrameArena::Get().Init();
+
+#if TDE2_EDITORS_ENABLED
+	CAllocationProfiler::Get().Init(); /// \note Sampling is cheap enough to be always on within internal builds
+#endif
+
+	/// \note Resource types go first, because some systems load their assets within Init
+	Game::RegisterGameResourceTypes(mpEngineCoreInstance->GetSubsystem<IResourceManager>(), mpEngineCoreInstance->GetSubsystem<IFileSystem>());
+
+	E_RESULT_CODE levelsResult = CSceneStreamer::Get().Init(mpSceneManager);
+	levelsResult = levelsResult | CGameLevelsCatalog::Get().Init(mpSceneManager, mpResourceManager, pEventManager);
+	levelsResult = levelsResult | CGameLevelsPrefetcher::Get().Init(mpSceneManager, mpResourceManager, pEventManager);
+	TDE2_ASSERT(RC_OK == levelsResult);
+
 	Game::RegisterGameComponents(mpWorld, mpEngineCoreInstance->GetSubsystem<IEditorsManager>());
 	Game::RegisterGameSystems(
 		mpWorld, mpInputContext, pEventManager,
 		mpEngineCoreInstance->GetSubsystem<ISceneManager>(),
-		mpEngineCoreInstance->GetSubsystem<IGameModesManager>());
-
-	Game::RegisterGameResourceTypes(mpEngineCoreInstance->GetSubsystem<IResourceManager>(), mpEngineCoreInstance->GetSubsystem<IFileSystem>());
+		mpEngineCoreInstance->GetSubsystem<IResourceManager>(),
+		mpEngineCoreInstance->GetSubsystem<IGameModesManager>(),
+		mIsParallelSystemsUpdateEnabled ? E_SYSTEMS_SCHEDULING_MODE::PARALLEL : E_SYSTEMS_SCHEDULING_MODE::SEQUENTIAL,
+		mSystemsGroupsDeltaTime,
+		[this](ISystem* pSystem, const std::string& groupName) { return _decorateGameSystem(pSystem, groupName); });
 
 	/// \todo Replace this later with scene's configurable solution
 	if (auto pMainScene = mpSceneManager->GetScene(MainScene).Get())
@@ -117,13 +253,7 @@ E_RESULT_CODE CCustomEngineListener::OnStart()
 		}
 	}
 
-	/// \note The initial mode for the game is a main menu
-	LoadMainMenu(
-		mpSceneManager, 
-		mpResourceManager, 
-		mpEngineCoreInstance->GetSubsystem<IEventManager>(), 
-		mpEngineCoreInstance->GetSubsystem<IGameModesManager>(), 
-		mpInputContext);
+	_loadInitialLevel();
 
 #if TDE2_EDITORS_ENABLED
 	E_RESULT_CODE result = RC_OK;
@@ -142,6 +272,8 @@ E_RESULT_CODE CCustomEngineListener::OnStart()
 
 E_RESULT_CODE CCustomEngineListener::OnUpdate(const float& dt)
 {
+	CSceneStreamer::Get().Update();
+
 #if TDE2_EDITORS_ENABLED
 
 	if (mpLevelsEditor)
@@ -156,6 +288,8 @@ E_RESULT_CODE CCustomEngineListener::OnUpdate(const float& dt)
 
 #endif
 
+	CFrameArena::Get().EndFrame();
+
 	return RC_OK;
 }
 
@@ -163,7 +297,20 @@ E_RESULT_CODE CCustomEngineListener::OnFree()
 {
 	mpLevelsEditor = nullptr;
 
-	return RC_OK;
+	E_RESULT_CODE result = CGameLevelsPrefetcher::Get().Free();
+	result = result | CSceneStreamer::Get().Free(); /// \note Goes after the prefetcher, which could enqueue its staged level
+	result = result | CSceneArenas::Get().Free(); /// \note Pages with live components are returned when the world destroys them
+	result = result | CGameLevelSnapshot::Get().Free();
+	result = result | CGameLevelsCatalog::Get().Free();
+	result = result | CWorldSingletonsCache::Get().Free();
+	result = result | CComponentsQueriesCache::Get().Free();
+	result = result | CEntityHandlesTable::Get().Free();
+	result = result | CEventChannels::Get().Free();
+	result = result | CPrefabTemplatesCache::Get().Free();
+	result = result | CFrameArena::Get().Free();
+	result = result | CAllocationProfiler::Get().Free();
+
+	return result;
 }
 
 void CCustomEngineListener::SetEngineInstance(IEngineCore* pEngineCore)
@@ -236,3 +383,18 @@ TEventListenerId CCustomEngineListener::GetListenerId() const
 	return static_cast<TEventListenerId>(TDE2_TYPE_ID(CCustomEngineListener));
 }
 
+ISystem* CCustomEngineListener::_decorateGameSystem(ISystem* pSystem, const std::string& groupName)
+{
+	return pSystem;
+}
+
+void CCustomEngineListener::_loadInitialLevel()
+{
+	/// \note The initial mode for the game is a main menu
+	LoadMainMenu(
+		mpSceneManager, 
+		mpResourceManager, 
+		mpEngineCoreInstance->GetSubsystem<IEventManager>(), 
+		mpEngineCoreInstance->GetSubsystem<IGameModesManager>(), 
+		mpInputContext);
+}
\ No newline at end of file
@@ -0,0 +1,534 @@
+#include "../include/CEntitiesPool.h"
+#include "../include/Components.h"
+#include "../include/components/CGameInfo.h"
+#include "../include/components/CLevelSettings.h"
+#include "../include/CWorldSingletons.h"
+#include "../include/Utilities.h"
+#include "../include/CPrefabTemplates.h"
+#include "../include/CComponentsQueries.h"
+#include "../include/CSceneArenas.h"
+#include <utils/CFileLogger.h>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CEntitiesPool::CEntitiesPool() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CEntitiesPool::Init(TPtr<ISceneManager> pSceneManager, TPtr<IEventManager> pEventManager)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pSceneManager || !pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpSceneManager = pSceneManager;
+		mpEventManager = pEventManager;
+		mpWorld = pSceneManager->GetWorld();
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | pEventManager->Subscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CEntitiesPool::_onFreeInternal()
+	{
+		E_RESULT_CODE result = RC_OK;
+		result = result | mpEventManager->Unsubscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		Reset();
+
+		return result;
+	}
+
+	E_RESULT_CODE CEntitiesPool::Prewarm(const std::string& prefabId, U32 count)
+	{
+		if (prefabId.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		IScene* pScene = _getCurrLevelScene();
+		if (!pScene)
+		{
+			return RC_FAIL;
+		}
+
+		const U32 poolIndex = _getOrCreatePoolIndex(prefabId);
+		const U32 freeCount = static_cast<U32>(mPools[poolIndex].mFreeEntities.size());
+
+		if (freeCount >= count)
+		{
+			return RC_OK;
+		}
+
+		mSpawnedEntities.clear();
+
+		TSceneArenaScope arenaScope(_getCurrLevelSceneId());
+
+		E_RESULT_CODE result = CPrefabTemplatesCache::Get().SpawnBatch(mpWorld.Get(), pScene, prefabId, count - freeCount, {}, mSpawnedEntities);
+
+		for (CEntity* pEntity : mSpawnedEntities)
+		{
+			result = result | _parkEntity(poolIndex, pEntity->GetId());
+
+			_pushFreeEntity(poolIndex, pEntity->GetId());
+			++mPools[poolIndex].mPrewarmedCount;
+		}
+
+		return result;
+	}
+
+	E_RESULT_CODE CEntitiesPool::AddPrewarmRequest(const std::string& prefabId, U32 count)
+	{
+		if (prefabId.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		U32& requestedCount = mPrewarmRequests[prefabId];
+		requestedCount = std::max(requestedCount, count);
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CEntitiesPool::SetParkingOffset(const std::string& prefabId, const TVector3& offset)
+	{
+		if (prefabId.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mParkingOffsets[prefabId] = offset;
+
+		auto it = mPoolsIndices.find(prefabId);
+		if (mPoolsIndices.cend() == it)
+		{
+			return RC_OK;
+		}
+
+		TPrefabPool& pool = mPools[it->second];
+
+		E_RESULT_CODE result = RC_OK;
+
+		/// \note Free entities are unparked with the previous way and parked again with the new one
+		for (TEntityId currEntityId : pool.mFreeEntities)
+		{
+			result = result | _unparkEntity(it->second, currEntityId);
+		}
+
+		pool.mIsParked = true;
+		pool.mParkingOffset = offset;
+
+		for (TEntityId currEntityId : pool.mFreeEntities)
+		{
+			result = result | _parkEntity(it->second, currEntityId);
+		}
+
+		return result;
+	}
+
+	CEntity* CEntitiesPool::Acquire(const std::string& prefabId)
+	{
+		const U32 poolIndex = _getOrCreatePoolIndex(prefabId);
+
+		CEntity* pEntity = _acquireFreeEntity(poolIndex);
+
+		if (!pEntity)
+		{
+			IScene* pScene = _getCurrLevelScene();
+			if (!pScene)
+			{
+				return nullptr;
+			}
+
+			mSpawnedEntities.clear();
+
+			TSceneArenaScope arenaScope(_getCurrLevelSceneId());
+
+			CPrefabTemplatesCache::Get().SpawnBatch(mpWorld.Get(), pScene, prefabId, 1, {}, mSpawnedEntities);
+			if (mSpawnedEntities.empty())
+			{
+				return nullptr;
+			}
+
+			pEntity = mSpawnedEntities.front();
+		}
+
+		_markEntityActive(poolIndex, pEntity->GetId());
+
+		return pEntity;
+	}
+
+	E_RESULT_CODE CEntitiesPool::AcquireBatch(const std::string& prefabId, U32 count, const std::vector<TVector3>& positions, std::vector<CEntity*>& entities)
+	{
+		if (prefabId.empty() || (!positions.empty() && positions.size() != count))
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		const U32 poolIndex = _getOrCreatePoolIndex(prefabId);
+
+		entities.reserve(entities.size() + count);
+
+		U32 acquiredCount = 0;
+
+		for (; acquiredCount < count; acquiredCount++)
+		{
+			CEntity* pEntity = _acquireFreeEntity(poolIndex);
+			if (!pEntity)
+			{
+				break;
+			}
+
+			if (!positions.empty())
+			{
+				pEntity->GetComponent<CTransform>()->SetPosition(positions[acquiredCount]);
+			}
+
+			_markEntityActive(poolIndex, pEntity->GetId());
+			entities.push_back(pEntity);
+		}
+
+		if (acquiredCount == count)
+		{
+			return RC_OK;
+		}
+
+		IScene* pScene = _getCurrLevelScene();
+		if (!pScene)
+		{
+			return RC_FAIL;
+		}
+
+		mSpawnPositions.clear();
+
+		if (!positions.empty())
+		{
+			mSpawnPositions.insert(mSpawnPositions.end(), positions.cbegin() + acquiredCount, positions.cend());
+		}
+
+		mSpawnedEntities.clear();
+
+		TSceneArenaScope arenaScope(_getCurrLevelSceneId());
+
+		const E_RESULT_CODE result = CPrefabTemplatesCache::Get().SpawnBatch(mpWorld.Get(), pScene, prefabId, count - acquiredCount, mSpawnPositions, mSpawnedEntities);
+
+		for (CEntity* pEntity : mSpawnedEntities)
+		{
+			_markEntityActive(poolIndex, pEntity->GetId());
+			entities.push_back(pEntity);
+		}
+
+		return result;
+	}
+
+	E_RESULT_CODE CEntitiesPool::Release(TEntityId entityId)
+	{
+		auto it = mEntitiesInfo.find(entityId);
+		if (mEntitiesInfo.cend() == it)
+		{
+			return mpWorld->Destroy(entityId);
+		}
+
+		if (!it->second.mIsActive)
+		{
+			return RC_OK;
+		}
+
+		const U32 poolIndex = it->second.mPoolIndex;
+
+		E_RESULT_CODE result = _parkEntity(poolIndex, entityId);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		--mPools[poolIndex].mActiveCount;
+		_pushFreeEntity(poolIndex, entityId);
+
+		return RC_OK;
+	}
+
+	void CEntitiesPool::Reset()
+	{
+		for (const TEntitiesPoolStatistics& currStatistics : GetStatistics())
+		{
+			LOG_MESSAGE(Wrench::StringUtils::Format("[EntitiesPool] Prefab: \"{0}\", prewarmed: {1}, high-water mark: {2}",
+				currStatistics.mPrefabId, currStatistics.mPrewarmedCount, currStatistics.mHighWaterMark));
+		}
+
+		mPools.clear();
+		mPoolsIndices.clear();
+		mEntitiesInfo.clear();
+	}
+
+	bool CEntitiesPool::IsPooled(TEntityId entityId) const
+	{
+		return mEntitiesInfo.find(entityId) != mEntitiesInfo.cend();
+	}
+
+	std::vector<TEntitiesPoolStatistics> CEntitiesPool::GetStatistics() const
+	{
+		std::vector<TEntitiesPoolStatistics> statistics;
+
+		for (const TPrefabPool& currPool : mPools)
+		{
+			TEntitiesPoolStatistics currStatistics;
+			currStatistics.mPrefabId = currPool.mPrefabId;
+			currStatistics.mPrewarmedCount = currPool.mPrewarmedCount;
+			currStatistics.mActiveCount = currPool.mActiveCount;
+			currStatistics.mFreeCount = static_cast<U32>(currPool.mFreeEntities.size());
+			currStatistics.mHighWaterMark = currPool.mHighWaterMark;
+
+			statistics.push_back(currStatistics);
+		}
+
+		return statistics;
+	}
+
+	E_RESULT_CODE CEntitiesPool::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (const TOnEntityRemovedEvent* pEntityRemovedEvent = dynamic_cast<const TOnEntityRemovedEvent*>(pEvent))
+		{
+			auto it = mEntitiesInfo.find(pEntityRemovedEvent->mRemovedEntityId);
+			if (mEntitiesInfo.cend() == it)
+			{
+				return RC_OK;
+			}
+
+			TPrefabPool& pool = mPools[it->second.mPoolIndex];
+
+			if (it->second.mIsActive)
+			{
+				--pool.mActiveCount;
+			}
+			else
+			{
+				_removeFreeEntity(it->second.mPoolIndex, it->first);
+			}
+
+			mEntitiesInfo.erase(it);
+
+			return RC_OK;
+		}
+
+		if (dynamic_cast<const TGameLevelLoadedEvent*>(pEvent))
+		{
+			Reset();
+			_prewarmPools();
+
+			return RC_OK;
+		}
+
+		return RC_FAIL;
+	}
+
+	TEventListenerId CEntitiesPool::GetListenerId() const
+	{
+		return TEventListenerId(GetTypeId());
+	}
+
+	IScene* CEntitiesPool::_getCurrLevelScene() const
+	{
+		auto sceneResult = mpSceneManager->GetScene(_getCurrLevelSceneId());
+		if (sceneResult.HasError())
+		{
+			return nullptr;
+		}
+
+		return sceneResult.Get();
+	}
+
+	TSceneId CEntitiesPool::_getCurrLevelSceneId() const
+	{
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
+		return pGameInfo ? pGameInfo->mCurrLoadedGameId : TSceneId::Invalid;
+	}
+
+	U32 CEntitiesPool::_getOrCreatePoolIndex(const std::string& prefabId)
+	{
+		auto it = mPoolsIndices.find(prefabId);
+		if (mPoolsIndices.cend() != it)
+		{
+			return it->second;
+		}
+
+		const U32 poolIndex = static_cast<U32>(mPools.size());
+
+		TPrefabPool pool;
+		pool.mPrefabId = prefabId;
+
+		auto parkingIt = mParkingOffsets.find(prefabId);
+		if (mParkingOffsets.cend() != parkingIt)
+		{
+			pool.mIsParked = true;
+			pool.mParkingOffset = parkingIt->second;
+		}
+
+		mPools.emplace_back(pool);
+		mPoolsIndices.emplace(prefabId, poolIndex);
+
+		return poolIndex;
+	}
+
+	void CEntitiesPool::_pushFreeEntity(U32 poolIndex, TEntityId entityId)
+	{
+		auto& freeEntities = mPools[poolIndex].mFreeEntities;
+
+		mEntitiesInfo[entityId] = { poolIndex, static_cast<U32>(freeEntities.size()), false };
+		freeEntities.push_back(entityId);
+	}
+
+	void CEntitiesPool::_removeFreeEntity(U32 poolIndex, TEntityId entityId)
+	{
+		auto& freeEntities = mPools[poolIndex].mFreeEntities;
+
+		TPooledEntityInfo& info = mEntitiesInfo[entityId];
+		TDE2_ASSERT(!info.mIsActive && freeEntities[info.mFreeSlotIndex] == entityId);
+
+		/// \note Swap with the last one to keep the removal O(1)
+		const TEntityId lastEntityId = freeEntities.back();
+
+		freeEntities[info.mFreeSlotIndex] = lastEntityId;
+		mEntitiesInfo[lastEntityId].mFreeSlotIndex = info.mFreeSlotIndex;
+
+		freeEntities.pop_back();
+
+		info.mIsActive = true;
+	}
+
+	CEntity* CEntitiesPool::_acquireFreeEntity(U32 poolIndex)
+	{
+		TPrefabPool& pool = mPools[poolIndex];
+
+		while (!pool.mFreeEntities.empty())
+		{
+			const TEntityId entityId = pool.mFreeEntities.back();
+			_removeFreeEntity(poolIndex, entityId);
+
+			/// \note Entities could be destroyed without notifications together with a scene, such ones are skipped
+			CEntity* pEntity = mpWorld->FindEntity(entityId);
+			if (!pEntity)
+			{
+				mEntitiesInfo.erase(entityId);
+				continue;
+			}
+
+			E_RESULT_CODE result = _unparkEntity(poolIndex, entityId);
+			TDE2_ASSERT(RC_OK == result);
+
+			return pEntity;
+		}
+
+		return nullptr;
+	}
+
+	void CEntitiesPool::_markEntityActive(U32 poolIndex, TEntityId entityId)
+	{
+		TPrefabPool& pool = mPools[poolIndex];
+
+		mEntitiesInfo[entityId] = { poolIndex, 0, true };
+
+		pool.mHighWaterMark = std::max(pool.mHighWaterMark, ++pool.mActiveCount);
+	}
+
+	E_RESULT_CODE CEntitiesPool::_parkEntity(U32 poolIndex, TEntityId entityId)
+	{
+		const TPrefabPool& pool = mPools[poolIndex];
+
+		if (!pool.mIsParked)
+		{
+			return SetEntityActive(mpWorld.Get(), entityId, false);
+		}
+
+		CEntity* pEntity = mpWorld->FindEntity(entityId);
+		if (!pEntity)
+		{
+			return RC_FAIL;
+		}
+
+		/// \note Engine's systems still process the entity, so it's moved out of the level where it's neither visible nor hit
+		if (CTransform* pTransform = pEntity->GetComponent<CTransform>())
+		{
+			pTransform->SetPosition(pTransform->GetPosition() + pool.mParkingOffset);
+		}
+
+		SetEntityEnabled(entityId, false);
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CEntitiesPool::_unparkEntity(U32 poolIndex, TEntityId entityId)
+	{
+		const TPrefabPool& pool = mPools[poolIndex];
+
+		if (!pool.mIsParked)
+		{
+			return SetEntityActive(mpWorld.Get(), entityId, true);
+		}
+
+		CEntity* pEntity = mpWorld->FindEntity(entityId);
+		if (!pEntity)
+		{
+			return RC_FAIL;
+		}
+
+		if (CTransform* pTransform = pEntity->GetComponent<CTransform>())
+		{
+			pTransform->SetPosition(pTransform->GetPosition() - pool.mParkingOffset);
+		}
+
+		SetEntityEnabled(entityId, true);
+
+		return RC_OK;
+	}
+
+	void CEntitiesPool::_prewarmPools()
+	{
+		std::unordered_map<std::string, U32> poolsSizes = mPrewarmRequests;
+
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
+
+		if (CLevelSettings* pLevelSettings = pGameInfo ? FindLevelSettings(mpSceneManager, pGameInfo->mCurrLoadedGameId) : nullptr)
+		{
+			for (const TPrefabPoolSettings& currPoolSettings : pLevelSettings->mPoolsSettings)
+			{
+				U32& size = poolsSizes[currPoolSettings.mPrefabId];
+				size = std::max(size, currPoolSettings.mSize);
+			}
+		}
+
+		for (auto&& currPoolSize : poolsSizes)
+		{
+			E_RESULT_CODE result = Prewarm(currPoolSize.first, currPoolSize.second);
+			TDE2_ASSERT(RC_OK == result);
+		}
+	}
+
+
+	TDE2_API CEntitiesPool* CreateEntitiesPool(TPtr<ISceneManager> pSceneManager, TPtr<IEventManager> pEventManager, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CEntitiesPool, CEntitiesPool, result, pSceneManager, pEventManager);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "../include/CEntityCommandBuffer.h"
+#include <algorithm>
+#include <iterator>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CEntityCommandBuffer::CEntityCommandBuffer() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CEntityCommandBuffer::Init(TPtr<IWorld> pWorld, TPtr<CEntitiesPool> pEntitiesPool)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pWorld || !pEntitiesPool)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpWorld = pWorld;
+		mpEntitiesPool = pEntitiesPool;
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	TCommandStreamId CEntityCommandBuffer::CreateStream()
+	{
+		mStreams.emplace_back(new TCommandStream());
+		return static_cast<TCommandStreamId>(mStreams.size() - 1);
+	}
+
+	void CEntityCommandBuffer::Destroy(TCommandStreamId streamId, TEntityId entityId)
+	{
+		_record(streamId, { E_ENTITY_COMMAND_TYPE::DESTROY, entityId, TEntityId::Invalid, TypeId::Invalid, 0 });
+	}
+
+	void CEntityCommandBuffer::AddComponent(TCommandStreamId streamId, TEntityId entityId, TypeId componentTypeId)
+	{
+		_record(streamId, { E_ENTITY_COMMAND_TYPE::ADD_COMPONENT, entityId, TEntityId::Invalid, componentTypeId, 0 });
+	}
+
+	void CEntityCommandBuffer::RemoveComponent(TCommandStreamId streamId, TEntityId entityId, TypeId componentTypeId)
+	{
+		_record(streamId, { E_ENTITY_COMMAND_TYPE::REMOVE_COMPONENT, entityId, TEntityId::Invalid, componentTypeId, 0 });
+	}
+
+	void CEntityCommandBuffer::Reparent(TCommandStreamId streamId, TEntityId parentEntityId, TEntityId childEntityId)
+	{
+		_record(streamId, { E_ENTITY_COMMAND_TYPE::REPARENT, childEntityId, parentEntityId, TypeId::Invalid, 0 });
+	}
+
+	void CEntityCommandBuffer::SpawnPrefab(TCommandStreamId streamId, const std::string& prefabId, TEntityId parentEntityId)
+	{
+		TCommandStream* pStream = _getStream(streamId);
+		if (!pStream)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(pStream->mMutex);
+
+		pStream->mCommands.push_back({ E_ENTITY_COMMAND_TYPE::SPAWN_PREFAB, TEntityId::Invalid, parentEntityId, TypeId::Invalid, static_cast<U32>(pStream->mPrefabsIds.size()) });
+		pStream->mPrefabsIds.push_back(prefabId);
+	}
+
+	E_RESULT_CODE CEntityCommandBuffer::Playback()
+	{
+		/// \note Streams are merged in order of their creation. Indices of prefabs are shifted into the merged table
+		for (auto&& pCurrStream : mStreams)
+		{
+			std::lock_guard<std::mutex> lock(pCurrStream->mMutex);
+
+			const U32 prefabsOffset = static_cast<U32>(mPendingPrefabsIds.size());
+
+			for (TEntityCommand& currCommand : pCurrStream->mCommands)
+			{
+				currCommand.mPrefabIndex += prefabsOffset;
+			}
+
+			mPendingCommands.insert(mPendingCommands.end(), pCurrStream->mCommands.cbegin(), pCurrStream->mCommands.cend());
+			mPendingPrefabsIds.insert(mPendingPrefabsIds.end(), std::make_move_iterator(pCurrStream->mPrefabsIds.begin()), std::make_move_iterator(pCurrStream->mPrefabsIds.end()));
+
+			pCurrStream->mCommands.clear();
+			pCurrStream->mPrefabsIds.clear();
+		}
+
+		if (mPendingCommands.empty())
+		{
+			return RC_OK;
+		}
+
+		mDestroyedEntities.clear();
+
+		for (const TEntityCommand& currCommand : mPendingCommands)
+		{
+			if (E_ENTITY_COMMAND_TYPE::DESTROY == currCommand.mType)
+			{
+				mDestroyedEntities.push_back(currCommand.mEntityId);
+			}
+		}
+
+		/// \note Several systems could destroy the same entity within a frame, e.g. a brick that is hit by a ball and a projectile
+		std::sort(mDestroyedEntities.begin(), mDestroyedEntities.end());
+		mDestroyedEntities.erase(std::unique(mDestroyedEntities.begin(), mDestroyedEntities.end()), mDestroyedEntities.end());
+
+		auto isDestroyed = [this](TEntityId entityId)
+		{
+			return std::binary_search(mDestroyedEntities.cbegin(), mDestroyedEntities.cend(), entityId);
+		};
+
+		E_RESULT_CODE result = RC_OK;
+
+		for (const TEntityCommand& currCommand : mPendingCommands)
+		{
+			if (E_ENTITY_COMMAND_TYPE::DESTROY == currCommand.mType || isDestroyed(currCommand.mEntityId) || isDestroyed(currCommand.mParentEntityId))
+			{
+				continue;
+			}
+
+			result = result | _execute(currCommand);
+		}
+
+		for (TEntityId currEntityId : mDestroyedEntities)
+		{
+			result = result | mpEntitiesPool->Release(currEntityId);
+		}
+
+		mPendingCommands.clear();
+		mPendingPrefabsIds.clear();
+
+		return result;
+	}
+
+	bool CEntityCommandBuffer::IsEmpty() const
+	{
+		for (auto&& pCurrStream : mStreams)
+		{
+			std::lock_guard<std::mutex> lock(pCurrStream->mMutex);
+
+			if (!pCurrStream->mCommands.empty())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void CEntityCommandBuffer::_record(TCommandStreamId streamId, const TEntityCommand& command)
+	{
+		TCommandStream* pStream = _getStream(streamId);
+		if (!pStream)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(pStream->mMutex);
+		pStream->mCommands.push_back(command);
+	}
+
+	CEntityCommandBuffer::TCommandStream* CEntityCommandBuffer::_getStream(TCommandStreamId streamId) const
+	{
+		const USIZE index = static_cast<USIZE>(streamId);
+		TDE2_ASSERT(index < mStreams.size());
+
+		return (index < mStreams.size()) ? mStreams[index].get() : nullptr;
+	}
+
+	E_RESULT_CODE CEntityCommandBuffer::_execute(const TEntityCommand& command)
+	{
+		switch (command.mType)
+		{
+			case E_ENTITY_COMMAND_TYPE::ADD_COMPONENT:
+				if (CEntity* pEntity = mpWorld->FindEntity(command.mEntityId))
+				{
+					return pEntity->AddComponent(command.mComponentTypeId) ? RC_OK : RC_FAIL;
+				}
+				return RC_OK;
+
+			case E_ENTITY_COMMAND_TYPE::REMOVE_COMPONENT:
+				if (CEntity* pEntity = mpWorld->FindEntity(command.mEntityId))
+				{
+					return pEntity->RemoveComponent(command.mComponentTypeId);
+				}
+				return RC_OK;
+
+			case E_ENTITY_COMMAND_TYPE::REPARENT:
+				return GroupEntities(mpWorld.Get(), command.mParentEntityId, command.mEntityId);
+
+			case E_ENTITY_COMMAND_TYPE::SPAWN_PREFAB:
+				if (CEntity* pEntity = mpEntitiesPool->Acquire(mPendingPrefabsIds[command.mPrefabIndex]))
+				{
+					return (TEntityId::Invalid == command.mParentEntityId) ? RC_OK : GroupEntities(mpWorld.Get(), command.mParentEntityId, pEntity->GetId());
+				}
+				return RC_FAIL;
+
+			default:
+				TDE2_UNREACHABLE();
+				break;
+		}
+
+		return RC_FAIL;
+	}
+
+
+	TDE2_API CEntityCommandBuffer* CreateEntityCommandBuffer(TPtr<IWorld> pWorld, TPtr<CEntitiesPool> pEntitiesPool, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CEntityCommandBuffer, CEntityCommandBuffer, result, pWorld, pEntitiesPool);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "../include/CEntityHandles.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	static inline TEntityHandle MakeEntityHandle(U32 index, U32 generation)
+	{
+		return static_cast<TEntityHandle>((static_cast<U64>(generation) << 32) | static_cast<U64>(index));
+	}
+
+	static inline U32 GetHandleIndex(TEntityHandle handle)
+	{
+		return static_cast<U32>(static_cast<U64>(handle) & 0xFFFFFFFF);
+	}
+
+	static inline U32 GetHandleGeneration(TEntityHandle handle)
+	{
+		return static_cast<U32>(static_cast<U64>(handle) >> 32);
+	}
+
+
+	CEntityHandlesTable& CEntityHandlesTable::Get()
+	{
+		static CEntityHandlesTable instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CEntityHandlesTable::Init(TPtr<IWorld> pWorld, TPtr<IEventManager> pEventManager)
+	{
+		if (mpEventManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pWorld || !pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | pEventManager->Subscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mpWorld = pWorld;
+		mpEventManager = pEventManager;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CEntityHandlesTable::Free()
+	{
+		if (!mpEventManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | mpEventManager->Unsubscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		_reset();
+
+		mpWorld = nullptr;
+		mpEventManager = nullptr;
+
+		return result;
+	}
+
+	TEntityHandle CEntityHandlesTable::Resolve(TEntityId entityId)
+	{
+		if (!mpWorld || TEntityId::Invalid == entityId)
+		{
+			return TEntityHandle::Invalid;
+		}
+
+		auto it = mSlotsIndices.find(entityId);
+		if (mSlotsIndices.cend() != it)
+		{
+			return MakeEntityHandle(it->second, mSlots[it->second].mGeneration);
+		}
+
+		CEntity* pEntity = mpWorld->FindEntity(entityId);
+		if (!pEntity)
+		{
+			return TEntityHandle::Invalid;
+		}
+
+		U32 slotIndex = static_cast<U32>(mSlots.size());
+
+		if (mFreeSlots.empty())
+		{
+			mSlots.emplace_back();
+		}
+		else
+		{
+			slotIndex = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+
+		TEntitySlot& slot = mSlots[slotIndex];
+		slot.mEntityId = entityId;
+		slot.mIsDirty = true;
+
+		mSlotsIndices.emplace(entityId, slotIndex);
+
+		return MakeEntityHandle(slotIndex, slot.mGeneration);
+	}
+
+	CEntity* CEntityHandlesTable::GetEntity(TEntityHandle handle)
+	{
+		TEntitySlot* pSlot = _getSlot(handle);
+		return pSlot ? pSlot->mpEntity : nullptr;
+	}
+
+	const std::vector<IComponent*>& CEntityHandlesTable::GetComponents(TEntityHandle handle)
+	{
+		static const std::vector<IComponent*> emptyComponents;
+
+		TEntitySlot* pSlot = _getSlot(handle);
+		return pSlot ? pSlot->mComponents : emptyComponents;
+	}
+
+	E_RESULT_CODE CEntityHandlesTable::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (const TOnComponentCreatedEvent* pComponentCreatedEvent = dynamic_cast<const TOnComponentCreatedEvent*>(pEvent))
+		{
+			auto it = mSlotsIndices.find(pComponentCreatedEvent->mEntityId);
+			if (mSlotsIndices.cend() != it)
+			{
+				mSlots[it->second].mIsDirty = true;
+			}
+
+			return RC_OK;
+		}
+
+		if (const TOnComponentRemovedEvent* pComponentRemovedEvent = dynamic_cast<const TOnComponentRemovedEvent*>(pEvent))
+		{
+			auto it = mSlotsIndices.find(pComponentRemovedEvent->mEntityId);
+			if (mSlotsIndices.cend() != it)
+			{
+				mSlots[it->second].mIsDirty = true;
+			}
+
+			return RC_OK;
+		}
+
+		if (const TOnEntityRemovedEvent* pEntityRemovedEvent = dynamic_cast<const TOnEntityRemovedEvent*>(pEvent))
+		{
+			_releaseSlot(pEntityRemovedEvent->mRemovedEntityId);
+			return RC_OK;
+		}
+
+		return RC_FAIL;
+	}
+
+	TEventListenerId CEntityHandlesTable::GetListenerId() const
+	{
+		return TEventListenerId(TDE2_TYPE_ID(CEntityHandlesTable));
+	}
+
+	U32 CEntityHandlesTable::_registerColumn(TypeId componentTypeId, TComponentCaster caster)
+	{
+		auto it = mColumns.find(componentTypeId);
+		if (mColumns.cend() != it)
+		{
+			return it->second.mIndex;
+		}
+
+		const U32 columnIndex = static_cast<U32>(mColumns.size());
+		mColumns.emplace(componentTypeId, TComponentColumn { columnIndex, caster });
+
+		return columnIndex;
+	}
+
+	CEntityHandlesTable::TEntitySlot* CEntityHandlesTable::_getSlot(TEntityHandle handle)
+	{
+		const U32 slotIndex = GetHandleIndex(handle);
+
+		if (TEntityHandle::Invalid == handle || slotIndex >= mSlots.size())
+		{
+			return nullptr;
+		}
+
+		TEntitySlot& slot = mSlots[slotIndex];
+		if (slot.mGeneration != GetHandleGeneration(handle) || TEntityId::Invalid == slot.mEntityId)
+		{
+			return nullptr;
+		}
+
+		if (slot.mIsDirty)
+		{
+			_fillSlot(slot);
+		}
+
+		return &slot;
+	}
+
+	void CEntityHandlesTable::_fillSlot(TEntitySlot& slot)
+	{
+		slot.mpEntity = mpWorld->FindEntity(slot.mEntityId);
+		slot.mComponents = slot.mpEntity ? slot.mpEntity->GetComponents() : std::vector<IComponent*>();
+		slot.mColumns.assign(mColumns.size(), nullptr);
+
+		for (IComponent* pCurrComponent : slot.mComponents)
+		{
+			auto it = mColumns.find(pCurrComponent->GetComponentTypeId());
+			if (mColumns.cend() != it)
+			{
+				slot.mColumns[it->second.mIndex] = it->second.mCaster(pCurrComponent);
+			}
+		}
+
+		slot.mIsDirty = false;
+	}
+
+	void CEntityHandlesTable::_releaseSlot(TEntityId entityId)
+	{
+		auto it = mSlotsIndices.find(entityId);
+		if (mSlotsIndices.cend() == it)
+		{
+			return;
+		}
+
+		TEntitySlot& slot = mSlots[it->second];
+
+		slot.mEntityId = TEntityId::Invalid;
+		slot.mpEntity = nullptr;
+		slot.mComponents.clear();
+		slot.mColumns.clear();
+		slot.mIsDirty = true;
+
+		++slot.mGeneration; /// \note All handles that were given before become stale
+
+		mFreeSlots.push_back(it->second);
+		mSlotsIndices.erase(it);
+	}
+
+	void CEntityHandlesTable::_reset()
+	{
+		mFreeSlots.clear();
+		mSlotsIndices.clear();
+
+		/// \note Slots are kept with bumped generations, so handles that survived Free don't alias new entities
+		for (U32 i = 0; i < static_cast<U32>(mSlots.size()); i++)
+		{
+			TEntitySlot& currSlot = mSlots[i];
+
+			currSlot.mEntityId = TEntityId::Invalid;
+			currSlot.mpEntity = nullptr;
+			currSlot.mComponents.clear();
+			currSlot.mColumns.clear();
+			currSlot.mIsDirty = true;
+
+			++currSlot.mGeneration;
+
+			mFreeSlots.push_back(i);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "../include/CEventChannels.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CEventChannels& CEventChannels::Get()
+	{
+		static CEventChannels instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CEventChannels::Free()
+	{
+		mChannels.clear();
+
+		std::lock_guard<std::mutex> lock(mThreadQueuesMutex);
+
+		for (auto& pCurrQueue : mThreadQueues)
+		{
+			pCurrQueue->mRecords.clear();
+			pCurrQueue->mBuffers.clear();
+		}
+
+		return RC_OK;
+	}
+
+	void CEventChannels::Flush()
+	{
+		bool hasHandledEvents = false;
+
+		do
+		{
+			{
+				std::lock_guard<std::mutex> lock(mThreadQueuesMutex);
+
+				mFlushedQueues.clear();
+
+				for (auto& pCurrQueue : mThreadQueues)
+				{
+					mFlushedQueues.push_back(pCurrQueue.get());
+				}
+			}
+
+			/// \note The lock isn't held here, because a handler could post an event from a thread without a queue yet
+			hasHandledEvents = false;
+
+			for (USIZE i = 0; i < mFlushedQueues.size(); i++)
+			{
+				hasHandledEvents = _flushQueue(*mFlushedQueues[i]) || hasHandledEvents;
+			}
+		}
+		while (hasHandledEvents); /// \note Handlers could post into queues that have been already flushed
+	}
+
+	U32 CEventChannels::_allocateChannelIndex()
+	{
+		static std::atomic<U32> channelsCounter { 0 };
+		return channelsCounter++;
+	}
+
+	CEventChannels::TThreadQueue& CEventChannels::_getThreadQueue()
+	{
+		static thread_local TThreadQueue* pThreadQueue = nullptr;
+
+		if (!pThreadQueue)
+		{
+			std::lock_guard<std::mutex> lock(mThreadQueuesMutex);
+
+			mThreadQueues.emplace_back(std::make_unique<TThreadQueue>());
+			pThreadQueue = mThreadQueues.back().get();
+		}
+
+		return *pThreadQueue;
+	}
+
+	bool CEventChannels::_flushQueue(TThreadQueue& queue)
+	{
+		if (queue.mRecords.empty())
+		{
+			return false;
+		}
+
+		/// \note The size is read on every iteration, events that are posted by handlers on this thread are handled too
+		for (USIZE i = 0; i < queue.mRecords.size(); i++)
+		{
+			const TPostedEventRecord record = queue.mRecords[i];
+			queue.mBuffers[record.mChannelIndex]->Dispatch(*this, record.mEventIndex);
+		}
+
+		queue.mRecords.clear();
+
+		for (auto& pCurrBuffer : queue.mBuffers)
+		{
+			if (pCurrBuffer)
+			{
+				pCurrBuffer->Clear();
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
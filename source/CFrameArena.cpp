@@ -0,0 +1,191 @@
+#include "../include/CFrameArena.h"
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	constexpr USIZE CFrameArena::DefaultCapacity;
+	constexpr USIZE CFrameArena::ThreadChunkSize;
+
+
+	struct TFrameArenaCursor
+	{
+		U8* mpCurrPtr = nullptr;
+		U8* mpEndPtr = nullptr;
+		U32 mFrameIndex = 0;
+	};
+
+
+	static thread_local TFrameArenaCursor ThreadCursor;
+
+
+	CFrameArena& CFrameArena::Get()
+	{
+		static CFrameArena instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CFrameArena::Init(USIZE capacity)
+	{
+		if (mCapacity)
+		{
+			return RC_FAIL;
+		}
+
+		if (capacity < ThreadChunkSize)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		for (TFrameBuffer& currBuffer : mBuffers)
+		{
+			currBuffer.mpMemory.reset(new (std::nothrow) U8[capacity]);
+			if (!currBuffer.mpMemory)
+			{
+				return RC_OUT_OF_MEMORY;
+			}
+
+			currBuffer.mUsedSize = 0;
+		}
+
+		mCapacity = capacity;
+		++mFrameIndex;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CFrameArena::Free()
+	{
+		if (!mCapacity)
+		{
+			return RC_OK;
+		}
+
+		mCapacity = 0;
+		++mFrameIndex;
+
+		for (TFrameBuffer& currBuffer : mBuffers)
+		{
+			currBuffer.mpMemory.reset();
+			currBuffer.mUsedSize = 0;
+		}
+
+		return RC_OK;
+	}
+
+	void* CFrameArena::Allocate(USIZE size, USIZE alignment)
+	{
+		if (!mCapacity || !size)
+		{
+			return nullptr;
+		}
+
+		TFrameArenaCursor& cursor = ThreadCursor;
+
+		const U32 frameIndex = mFrameIndex.load(std::memory_order_acquire);
+
+		/// \note The chunk belongs to a buffer which was reset since then
+		if (cursor.mFrameIndex != frameIndex)
+		{
+			cursor = TFrameArenaCursor { nullptr, nullptr, frameIndex };
+		}
+
+		U8* pAlignedPtr = cursor.mpCurrPtr ? reinterpret_cast<U8*>((reinterpret_cast<uintptr_t>(cursor.mpCurrPtr) + alignment - 1) & ~(alignment - 1)) : nullptr;
+
+		if (!pAlignedPtr || pAlignedPtr + size > cursor.mpEndPtr)
+		{
+			const USIZE chunkSize = std::max(ThreadChunkSize, size + alignment);
+
+			U8* pChunk = _acquireChunk(chunkSize);
+			if (!pChunk)
+			{
+				++mOverflowsCount;
+				return nullptr;
+			}
+
+			cursor.mpCurrPtr = pChunk;
+			cursor.mpEndPtr = pChunk + chunkSize;
+
+			pAlignedPtr = reinterpret_cast<U8*>((reinterpret_cast<uintptr_t>(pChunk) + alignment - 1) & ~(alignment - 1));
+		}
+
+		cursor.mpCurrPtr = pAlignedPtr + size;
+
+		/// \note Blocks are never freed separately, so they're counted only towards the allocation rate
+		CAllocationProfiler::Get().OnAllocate(mProfilerAllocatorId, nullptr, size);
+
+		return pAlignedPtr;
+	}
+
+	void CFrameArena::EndFrame()
+	{
+		if (!mCapacity)
+		{
+			return;
+		}
+
+		const U32 frameIndex = mFrameIndex.load();
+
+		mLastFrameUsedSize = std::min(mBuffers[frameIndex & 1].mUsedSize.load(), mCapacity);
+		mPeakUsedSize = std::max(mPeakUsedSize, mLastFrameUsedSize);
+		mLastFrameOverflowsCount = mOverflowsCount.exchange(0);
+
+		/// \note The next buffer contains the data of the previous frame, which isn't needed anymore
+		mBuffers[(frameIndex + 1) & 1].mUsedSize = 0;
+
+		mFrameIndex.store(frameIndex + 1, std::memory_order_release);
+	}
+
+	bool CFrameArena::Owns(const void* pPtr) const
+	{
+		const U8* pBytePtr = static_cast<const U8*>(pPtr);
+
+		for (const TFrameBuffer& currBuffer : mBuffers)
+		{
+			const U8* pMemory = currBuffer.mpMemory.get();
+
+			if (pMemory && pBytePtr >= pMemory && pBytePtr < pMemory + mCapacity)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	USIZE CFrameArena::GetLastFrameUsedSize() const
+	{
+		return mLastFrameUsedSize;
+	}
+
+	USIZE CFrameArena::GetPeakUsedSize() const
+	{
+		return mPeakUsedSize;
+	}
+
+	U32 CFrameArena::GetLastFrameOverflowsCount() const
+	{
+		return mLastFrameOverflowsCount;
+	}
+
+	USIZE CFrameArena::GetCapacity() const
+	{
+		return mCapacity;
+	}
+
+	U8* CFrameArena::_acquireChunk(USIZE size)
+	{
+		TFrameBuffer& buffer = mBuffers[mFrameIndex.load(std::memory_order_acquire) & 1];
+
+		const USIZE offset = buffer.mUsedSize.fetch_add(size);
+		if (offset + size > mCapacity)
+		{
+			return nullptr; /// \note The counter stays beyond the capacity, so the following requests fail fast too
+		}
+
+		return buffer.mpMemory.get() + offset;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "../include/CGameLevelSnapshot.h"
+#include "../include/CComponentsQueries.h"
+#include <utils/CFileLogger.h>
+#include <unordered_set>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CGameLevelSnapshot& CGameLevelSnapshot::Get()
+	{
+		static CGameLevelSnapshot instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CGameLevelSnapshot::Free()
+	{
+		E_RESULT_CODE result = RC_OK;
+
+		for (TEntitySnapshot& currEntity : mEntities)
+		{
+			for (TComponentSnapshot& currComponent : currEntity.mComponents)
+			{
+				result = result | currComponent.mpComponent->Free();
+			}
+		}
+
+		mEntities.clear();
+		mScenePath.clear();
+		mComponentsFactories.clear();
+
+		return result;
+	}
+
+	E_RESULT_CODE CGameLevelSnapshot::Capture(TPtr<ISceneManager> pSceneManager, TSceneId sceneId)
+	{
+		if (!pSceneManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		auto getSceneResult = pSceneManager->GetScene(sceneId);
+		if (getSceneResult.HasError() || !getSceneResult.Get())
+		{
+			return RC_FAIL;
+		}
+
+		IScene* pScene = getSceneResult.Get();
+		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
+
+		E_RESULT_CODE result = Free();
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		pWorld->ForEachComponentFactory([this](TPtr<IComponentFactory> pFactory)
+		{
+			mComponentsFactories.emplace(pFactory->GetComponentTypeId(), pFactory);
+		});
+
+		const auto& entities = pScene->GetEntities();
+		mEntities.reserve(entities.size());
+
+		for (TEntityId currEntityId : entities)
+		{
+			CEntity* pEntity = pWorld->FindEntity(currEntityId);
+			if (!pEntity)
+			{
+				continue;
+			}
+
+			TEntitySnapshot entitySnapshot { currEntityId, pEntity->GetName(), {} };
+
+			for (IComponent* pComponent : pEntity->GetComponents())
+			{
+				if (pComponent->IsRuntimeOnly())
+				{
+					continue;
+				}
+
+				if (IComponent* pComponentCopy = _copyComponent(pComponent))
+				{
+					entitySnapshot.mComponents.push_back({ pComponent->GetComponentTypeId(), pComponentCopy });
+				}
+			}
+
+			mEntities.emplace_back(std::move(entitySnapshot));
+		}
+
+		mScenePath = pScene->GetScenePath();
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CGameLevelSnapshot::Restore(TPtr<ISceneManager> pSceneManager, TSceneId sceneId)
+	{
+		if (!HasSnapshot(pSceneManager, sceneId))
+		{
+			return RC_FAIL;
+		}
+
+		IScene* pScene = pSceneManager->GetScene(sceneId).Get();
+		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
+
+		std::unordered_set<TEntityId> capturedEntities;
+		capturedEntities.reserve(mEntities.size());
+
+		for (const TEntitySnapshot& currEntity : mEntities)
+		{
+			capturedEntities.emplace(currEntity.mEntityId);
+		}
+
+		E_RESULT_CODE result = RC_OK;
+
+		/// \note Destroy everything that was spawned during the play, the entities pool is notified with TOnEntityRemovedEvent
+		const std::vector<TEntityId> entities = pScene->GetEntities();
+
+		for (TEntityId currEntityId : entities)
+		{
+			if (capturedEntities.find(currEntityId) == capturedEntities.cend() && pWorld->FindEntity(currEntityId))
+			{
+				result = result | pScene->RemoveEntity(currEntityId);
+			}
+		}
+
+		USIZE reusedEntitiesCount = 0;
+
+		for (const TEntitySnapshot& currEntity : mEntities)
+		{
+			bool isReused = false;
+
+			result = result | _restoreEntity(pWorld.Get(), pScene, currEntity, isReused);
+			reusedEntitiesCount += isReused;
+		}
+
+		LOG_MESSAGE(Wrench::StringUtils::Format("[CGameLevelSnapshot] The level \"{0}\" is restored, reused entities: {1}/{2}",
+			mScenePath, reusedEntitiesCount, mEntities.size()));
+
+		return result;
+	}
+
+	bool CGameLevelSnapshot::HasSnapshot(TPtr<ISceneManager> pSceneManager, TSceneId sceneId) const
+	{
+		if (!pSceneManager || mScenePath.empty())
+		{
+			return false;
+		}
+
+		auto getSceneResult = pSceneManager->GetScene(sceneId);
+		return getSceneResult.IsOk() && getSceneResult.Get() && (getSceneResult.Get()->GetScenePath() == mScenePath);
+	}
+
+	IComponent* CGameLevelSnapshot::_copyComponent(const IComponent* pComponent)
+	{
+		auto it = mComponentsFactories.find(pComponent->GetComponentTypeId());
+		if (mComponentsFactories.cend() == it)
+		{
+			return nullptr;
+		}
+
+		IComponent* pComponentCopy = it->second->CreateDefault();
+		if (!pComponentCopy)
+		{
+			return nullptr;
+		}
+
+		if (RC_OK != pComponent->Clone(pComponentCopy))
+		{
+			LOG_WARNING(Wrench::StringUtils::Format("[CGameLevelSnapshot] Couldn't copy a component of type {0}", pComponent->GetTypeName()));
+
+			pComponentCopy->Free();
+			return nullptr;
+		}
+
+		return pComponentCopy;
+	}
+
+	E_RESULT_CODE CGameLevelSnapshot::_restoreEntity(IWorld* pWorld, IScene* pScene, const TEntitySnapshot& entitySnapshot, bool& isReused)
+	{
+		CEntity* pEntity = pWorld->FindEntity(entitySnapshot.mEntityId);
+		isReused = (nullptr != pEntity);
+
+		if (!pEntity)
+		{
+			pEntity = pScene->CreateEntityWithUUID(entitySnapshot.mEntityId);
+			if (!pEntity)
+			{
+				return RC_FAIL;
+			}
+
+			pEntity->SetName(entitySnapshot.mName);
+		}
+
+		auto isCaptured = [&entitySnapshot](TypeId typeId)
+		{
+			return std::find_if(entitySnapshot.mComponents.cbegin(), entitySnapshot.mComponents.cend(), [typeId](const TComponentSnapshot& component)
+			{
+				return component.mTypeId == typeId;
+			}) != entitySnapshot.mComponents.cend();
+		};
+
+		E_RESULT_CODE result = RC_OK;
+
+		/// \note Components which were added during the play are removed
+		for (IComponent* pComponent : pEntity->GetComponents())
+		{
+			if (!pComponent->IsRuntimeOnly() && !isCaptured(pComponent->GetComponentTypeId()))
+			{
+				result = result | pEntity->RemoveComponent(pComponent->GetComponentTypeId());
+			}
+		}
+
+		const std::vector<IComponent*> components = pEntity->GetComponents();
+
+		for (const TComponentSnapshot& currComponent : entitySnapshot.mComponents)
+		{
+			auto it = std::find_if(components.cbegin(), components.cend(), [&currComponent](const IComponent* pComponent)
+			{
+				return pComponent->GetComponentTypeId() == currComponent.mTypeId;
+			});
+
+			IComponent* pComponent = (components.cend() != it) ? *it : pEntity->AddComponent(currComponent.mTypeId);
+			if (!pComponent)
+			{
+				result = result | RC_FAIL;
+				continue;
+			}
+
+			result = result | currComponent.mpComponent->Clone(pComponent);
+
+			/// \note Values are changed in place, so queries don't get any ECS event about that
+			MarkComponentChanged(entitySnapshot.mEntityId, currComponent.mTypeId);
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
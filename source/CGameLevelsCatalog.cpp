@@ -0,0 +1,143 @@
+#include "../include/CGameLevelsCatalog.h"
+#include "../include/Components.h"
+#include "../include/components/CGameInfo.h"
+#include "../include/CWorldSingletons.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	static const std::string GameLevelsCollectionPath = "ProjectResources/GameLevelsCollection.asset";
+
+
+	CGameLevelsCatalog& CGameLevelsCatalog::Get()
+	{
+		static CGameLevelsCatalog instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CGameLevelsCatalog::Init(TPtr<ISceneManager> pSceneManager, TPtr<IResourceManager> pResourceManager, TPtr<IEventManager> pEventManager)
+	{
+		if (mpEventManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pSceneManager || !pResourceManager || !pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpLevelsCollection = GetLevelsCollection(pResourceManager);
+		if (!mpLevelsCollection)
+		{
+			return RC_FAIL;
+		}
+
+		E_RESULT_CODE result = pEventManager->Subscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+		if (RC_OK != result)
+		{
+			mpLevelsCollection = nullptr;
+			return result;
+		}
+
+		mpEventManager = pEventManager;
+		mCurrLevelIndex = mInvalidLevelIndex;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CGameLevelsCatalog::Free()
+	{
+		if (!mpEventManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = mpEventManager->Unsubscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+
+		mpEventManager = nullptr;
+		mpLevelsCollection = nullptr;
+		mCurrLevelIndex = mInvalidLevelIndex;
+
+		return result;
+	}
+
+	TPtr<CGameLevelsCollection> CGameLevelsCatalog::GetLevelsCollection(TPtr<IResourceManager> pResourceManager)
+	{
+		if (mpLevelsCollection)
+		{
+			return mpLevelsCollection;
+		}
+
+		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
+		if (TResourceId::Invalid == gameLevelsCollectionHandle)
+		{
+			return nullptr;
+		}
+
+		return pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
+	}
+
+	TResult<USIZE> CGameLevelsCatalog::GetCurrLevelIndex(TPtr<ISceneManager> pSceneManager, TPtr<IResourceManager> pResourceManager)
+	{
+		if (mpEventManager && mInvalidLevelIndex != mCurrLevelIndex)
+		{
+			return Wrench::TOkValue<USIZE>(mCurrLevelIndex);
+		}
+
+		auto resolveResult = _resolveCurrLevelIndex(pSceneManager, GetLevelsCollection(pResourceManager));
+		if (resolveResult.HasError())
+		{
+			return resolveResult;
+		}
+
+		if (mpEventManager)
+		{
+			mCurrLevelIndex = resolveResult.Get();
+		}
+
+		return resolveResult;
+	}
+
+	E_RESULT_CODE CGameLevelsCatalog::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (dynamic_cast<const TGameLevelLoadedEvent*>(pEvent))
+		{
+			/// \note The index is resolved lazily, so the order of listeners of the event doesn't matter
+			mCurrLevelIndex = mInvalidLevelIndex;
+			return RC_OK;
+		}
+
+		return RC_FAIL;
+	}
+
+	TEventListenerId CGameLevelsCatalog::GetListenerId() const
+	{
+		return TEventListenerId(TDE2_TYPE_ID(CGameLevelsCatalog));
+	}
+
+	TResult<USIZE> CGameLevelsCatalog::_resolveCurrLevelIndex(TPtr<ISceneManager> pSceneManager, TPtr<CGameLevelsCollection> pLevelsCollection) const
+	{
+		if (!pLevelsCollection)
+		{
+			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
+		}
+
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pSceneManager->GetWorld());
+		if (!pGameInfo)
+		{
+			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
+		}
+
+		auto getSceneResult = pSceneManager->GetScene(pGameInfo->mCurrLoadedGameId);
+		if (getSceneResult.HasError() || !getSceneResult.Get())
+		{
+			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
+		}
+
+		return pLevelsCollection->FindLevelIndex(getSceneResult.Get()->GetScenePath());
+	}
+}
\ No newline at end of file
@@ -37,6 +37,8 @@ namespace Game
 	E_RESULT_CODE CGameLevelsCollection::Reset()
 	{
 		mGameLevels.clear();
+		mLevelsIndices.clear();
+
 		return RC_OK;
 	}
 
@@ -78,6 +80,7 @@ namespace Game
 		}
 
 		mGameLevels.clear();
+		mLevelsIndices.clear();
 
 		pReader->BeginGroup(TGameLevelsCollectionArchiveKeys::mCollectionKey);
 		{
@@ -86,6 +89,7 @@ namespace Game
 				pReader->BeginGroup(Wrench::StringUtils::GetEmptyStr());
 				{
 					mGameLevels.emplace_back(pReader->GetString(TGameLevelsCollectionArchiveKeys::mLevelPathKey));
+					mLevelsIndices.emplace(mGameLevels.back(), mGameLevels.size() - 1);
 				}
 				pReader->EndGroup();
 			}
@@ -97,13 +101,13 @@ namespace Game
 
 	TDE2_API TDEngine2::TResult<TDEngine2::USIZE> CGameLevelsCollection::FindLevelIndex(const std::string& levelPath) const
 	{
-		auto it = std::find(mGameLevels.cbegin(), mGameLevels.cend(), levelPath);
-		if (it == mGameLevels.cend())
+		auto it = mLevelsIndices.find(levelPath);
+		if (it == mLevelsIndices.cend())
 		{
 			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
 		}
 
-		return Wrench::TOkValue<USIZE>(std::distance(mGameLevels.cbegin(), it));
+		return Wrench::TOkValue<USIZE>(it->second);
 	}
 
 	TDEngine2::TResult<std::string> CGameLevelsCollection::GetLevelPathByIndex(TDEngine2::USIZE index) const
@@ -0,0 +1,225 @@
+#include "../include/CGameLevelsPrefetcher.h"
+#include "../include/CGameLevelsCatalog.h"
+#include "../include/Components.h"
+#include "../include/Utilities.h"
+#include "../include/CSceneStreamer.h"
+#include <utils/CFileLogger.h>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CGameLevelsPrefetcher& CGameLevelsPrefetcher::Get()
+	{
+		static CGameLevelsPrefetcher instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CGameLevelsPrefetcher::Init(TPtr<ISceneManager> pSceneManager, TPtr<IResourceManager> pResourceManager, TPtr<IEventManager> pEventManager)
+	{
+		if (mpEventManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pSceneManager || !pResourceManager || !pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = pEventManager->Subscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mpSceneManager = pSceneManager;
+		mpResourceManager = pResourceManager;
+		mpEventManager = pEventManager;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CGameLevelsPrefetcher::Free()
+	{
+		if (!mpEventManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = mpEventManager->Unsubscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+
+		_discardLevel();
+
+		mpSceneManager = nullptr;
+		mpResourceManager = nullptr;
+		mpEventManager = nullptr;
+
+		return result;
+	}
+
+	E_RESULT_CODE CGameLevelsPrefetcher::Prefetch(const std::string& levelPath)
+	{
+		if (!mpSceneManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (levelPath.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		if (E_PREFETCH_STATE::NONE != mState && levelPath == mLevelPath)
+		{
+			return RC_OK;
+		}
+
+		_discardLevel();
+
+		mState = E_PREFETCH_STATE::LOADING;
+		mLevelPath = levelPath;
+
+		mpSceneManager->LoadSceneAsync(levelPath, [this, requestIndex = mRequestIndex](const TResult<TSceneId>& sceneId)
+		{
+			_onLevelLoaded(requestIndex, sceneId);
+		});
+
+		return RC_OK;
+	}
+
+	TResult<TSceneId> CGameLevelsPrefetcher::TakePrefetchedLevel(const std::string& levelPath)
+	{
+		if (levelPath != mLevelPath || E_PREFETCH_STATE::STAGED != mState)
+		{
+			if (levelPath == mLevelPath)
+			{
+				_discardLevel(); /// \note The level will be loaded in a regular way, so the pending request isn't needed anymore
+			}
+
+			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
+		}
+
+		TPtr<IWorld> pWorld = mpSceneManager->GetWorld();
+
+		for (TEntityId currEntityId : mDeactivatedEntities)
+		{
+			E_RESULT_CODE result = SetEntityActive(pWorld.Get(), currEntityId, true);
+			TDE2_ASSERT(RC_OK == result);
+		}
+
+		const TSceneId sceneId = mSceneId;
+
+		mDeactivatedEntities.clear();
+		mSceneId = TSceneId::Invalid;
+		mLevelPath.clear();
+		mState = E_PREFETCH_STATE::NONE;
+
+		return Wrench::TOkValue<TSceneId>(sceneId);
+	}
+
+	E_RESULT_CODE CGameLevelsPrefetcher::OnEvent(const TBaseEvent* pEvent)
+	{
+		if (!dynamic_cast<const TGameLevelLoadedEvent*>(pEvent))
+		{
+			return RC_FAIL;
+		}
+
+		if (!IsNextGameLevelExists(mpSceneManager, mpResourceManager, 1))
+		{
+			return RC_OK;
+		}
+
+		auto pLevelsCollection = CGameLevelsCatalog::Get().GetLevelsCollection(mpResourceManager);
+		auto nextLevelPathResult = pLevelsCollection->GetLevelPathByIndex(GetCurrLevelIndex(mpSceneManager, mpResourceManager).Get() + 1);
+
+		return nextLevelPathResult.IsOk() ? Prefetch(nextLevelPathResult.Get()) : RC_OK;
+	}
+
+	TEventListenerId CGameLevelsPrefetcher::GetListenerId() const
+	{
+		return TEventListenerId(TDE2_TYPE_ID(CGameLevelsPrefetcher));
+	}
+
+	void CGameLevelsPrefetcher::_onLevelLoaded(U32 requestIndex, const TResult<TSceneId>& sceneId)
+	{
+		if (sceneId.HasError())
+		{
+			if (requestIndex == mRequestIndex)
+			{
+				LOG_WARNING(Wrench::StringUtils::Format("[CGameLevelsPrefetcher] Couldn't prefetch the level \"{0}\"", mLevelPath));
+
+				mLevelPath.clear();
+				mState = E_PREFETCH_STATE::NONE;
+			}
+
+			return;
+		}
+
+		if (requestIndex != mRequestIndex || !mpSceneManager)
+		{
+			if (mpSceneManager)
+			{
+				E_RESULT_CODE result = CSceneStreamer::Get().UnloadScene(sceneId.Get()); /// \note The request was cancelled while the scene had been loading
+				TDE2_ASSERT(RC_OK == result);
+			}
+
+			return;
+		}
+
+		auto getSceneResult = mpSceneManager->GetScene(sceneId.Get());
+		if (getSceneResult.HasError())
+		{
+			mLevelPath.clear();
+			mState = E_PREFETCH_STATE::NONE;
+
+			return;
+		}
+
+		TPtr<IWorld> pWorld = mpSceneManager->GetWorld();
+
+		/// \note Only roots are deactivated, their children are disabled together with them
+		for (TEntityId currEntityId : getSceneResult.Get()->GetEntities())
+		{
+			CEntity* pEntity = pWorld->FindEntity(currEntityId);
+			if (!pEntity || pEntity->HasComponent<CDeactivatedComponent>())
+			{
+				continue;
+			}
+
+			CTransform* pTransform = pEntity->GetComponent<CTransform>();
+			if (pTransform && TEntityId::Invalid != pTransform->GetParent())
+			{
+				continue;
+			}
+
+			if (RC_OK == SetEntityActive(pWorld.Get(), currEntityId, false))
+			{
+				mDeactivatedEntities.push_back(currEntityId);
+			}
+		}
+
+		mSceneId = sceneId.Get();
+		mState = E_PREFETCH_STATE::STAGED;
+
+		LOG_MESSAGE(Wrench::StringUtils::Format("[CGameLevelsPrefetcher] The level \"{0}\" is staged", mLevelPath));
+	}
+
+	void CGameLevelsPrefetcher::_discardLevel()
+	{
+		++mRequestIndex;
+
+		if (E_PREFETCH_STATE::STAGED == mState)
+		{
+			E_RESULT_CODE result = CSceneStreamer::Get().UnloadScene(mSceneId);
+			TDE2_ASSERT(RC_OK == result);
+		}
+
+		mDeactivatedEntities.clear();
+		mSceneId = TSceneId::Invalid;
+		mLevelPath.clear();
+		mState = E_PREFETCH_STATE::NONE;
+	}
+}
\ No newline at end of file
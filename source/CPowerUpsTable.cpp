@@ -0,0 +1,214 @@
+#include "../include/CPowerUpsTable.h"
+
+
+using namespace TDEngine2;
+
+namespace Game
+{
+	struct TPowerUpsTableArchiveKeys
+	{
+		static const std::string mEntriesKey;
+		static const std::string mTypeIdKey;
+		static const std::string mWeightKey;
+		static const std::string mPrefabIdKey;
+		static const std::string mPrewarmCountKey;
+	};
+
+	const std::string TPowerUpsTableArchiveKeys::mEntriesKey = "power_ups";
+	const std::string TPowerUpsTableArchiveKeys::mTypeIdKey = "type_id";
+	const std::string TPowerUpsTableArchiveKeys::mWeightKey = "weight";
+	const std::string TPowerUpsTableArchiveKeys::mPrefabIdKey = "prefab_id";
+	const std::string TPowerUpsTableArchiveKeys::mPrewarmCountKey = "prewarm_count";
+
+
+	CPowerUpsTable::CPowerUpsTable() :
+		CBaseResource()
+	{
+	}
+
+	E_RESULT_CODE CPowerUpsTable::Init(IResourceManager* pResourceManager, const std::string& name)
+	{
+		E_RESULT_CODE result = _init(pResourceManager, name);
+
+		if (result != RC_OK)
+		{
+			return result;
+		}
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CPowerUpsTable::Reset()
+	{
+		mEntries.clear();
+		mProbabilities.clear();
+		mAliases.clear();
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CPowerUpsTable::Save(IArchiveWriter* pWriter)
+	{
+		if (!pWriter)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		pWriter->BeginGroup("meta");
+		{
+			pWriter->SetString("resource_type", "power_ups_table");
+			pWriter->SetUInt16("version_tag", mVersionTag);
+		}
+		pWriter->EndGroup();
+
+		pWriter->BeginGroup(TPowerUpsTableArchiveKeys::mEntriesKey, true);
+		{
+			for (const TPowerUpTableEntry& currEntry : mEntries)
+			{
+				pWriter->BeginGroup(Wrench::StringUtils::GetEmptyStr());
+				{
+					pWriter->SetUInt32(TPowerUpsTableArchiveKeys::mTypeIdKey, static_cast<U32>(currEntry.mPowerUpTypeId));
+					pWriter->SetFloat(TPowerUpsTableArchiveKeys::mWeightKey, currEntry.mWeight);
+					pWriter->SetString(TPowerUpsTableArchiveKeys::mPrefabIdKey, currEntry.mPrefabId);
+					pWriter->SetUInt32(TPowerUpsTableArchiveKeys::mPrewarmCountKey, currEntry.mPrewarmCount);
+				}
+				pWriter->EndGroup();
+			}
+		}
+		pWriter->EndGroup();
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CPowerUpsTable::Load(IArchiveReader* pReader)
+	{
+		if (!pReader)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mEntries.clear();
+
+		pReader->BeginGroup(TPowerUpsTableArchiveKeys::mEntriesKey);
+		{
+			while (pReader->HasNextItem())
+			{
+				pReader->BeginGroup(Wrench::StringUtils::GetEmptyStr());
+				{
+					TPowerUpTableEntry entry;
+					entry.mPowerUpTypeId = static_cast<TypeId>(pReader->GetUInt32(TPowerUpsTableArchiveKeys::mTypeIdKey));
+					entry.mWeight = CMathUtils::Max(0.0f, pReader->GetFloat(TPowerUpsTableArchiveKeys::mWeightKey));
+					entry.mPrefabId = pReader->GetString(TPowerUpsTableArchiveKeys::mPrefabIdKey);
+					entry.mPrewarmCount = pReader->GetUInt32(TPowerUpsTableArchiveKeys::mPrewarmCountKey, 1);
+
+					mEntries.emplace_back(entry);
+				}
+				pReader->EndGroup();
+			}
+		}
+		pReader->EndGroup();
+
+		_buildAliasTable();
+
+		return RC_OK;
+	}
+
+	const TPowerUpTableEntry* CPowerUpsTable::Sample(F32 uniformValue) const
+	{
+		if (mEntries.empty())
+		{
+			return nullptr;
+		}
+
+		const F32 scaledValue = CMathUtils::Clamp(0.0f, 1.0f, uniformValue) * static_cast<F32>(mEntries.size());
+
+		const U32 column = std::min<U32>(static_cast<U32>(scaledValue), static_cast<U32>(mEntries.size() - 1));
+		const F32 fraction = scaledValue - static_cast<F32>(column);
+
+		return &mEntries[(fraction < mProbabilities[column]) ? column : mAliases[column]];
+	}
+
+	const std::vector<TPowerUpTableEntry>& CPowerUpsTable::GetEntries() const
+	{
+		return mEntries;
+	}
+
+	const TPtr<IResourceLoader> CPowerUpsTable::_getResourceLoader()
+	{
+		return mpResourceManager->GetResourceLoader<CPowerUpsTable>();
+	}
+
+	void CPowerUpsTable::_buildAliasTable()
+	{
+		const U32 entriesCount = static_cast<U32>(mEntries.size());
+
+		mProbabilities.assign(entriesCount, 1.0f);
+		mAliases.resize(entriesCount);
+
+		F32 weightsSum = 0.0f;
+
+		for (U32 i = 0; i < entriesCount; i++)
+		{
+			weightsSum += mEntries[i].mWeight;
+			mAliases[i] = i;
+		}
+
+		if (weightsSum < FloatEpsilon)
+		{
+			return; /// \note All weights are zeros, so the distribution becomes the uniform one
+		}
+
+		/// \note Vose's method: columns which are under the average are topped up with ones which are above it
+		std::vector<F32> scaledWeights(entriesCount);
+		std::vector<U32> smallColumns;
+		std::vector<U32> largeColumns;
+
+		for (U32 i = 0; i < entriesCount; i++)
+		{
+			scaledWeights[i] = mEntries[i].mWeight * static_cast<F32>(entriesCount) / weightsSum;
+			(scaledWeights[i] < 1.0f ? smallColumns : largeColumns).push_back(i);
+		}
+
+		while (!smallColumns.empty() && !largeColumns.empty())
+		{
+			const U32 smallIndex = smallColumns.back();
+			smallColumns.pop_back();
+
+			const U32 largeIndex = largeColumns.back();
+
+			mProbabilities[smallIndex] = scaledWeights[smallIndex];
+			mAliases[smallIndex] = largeIndex;
+
+			scaledWeights[largeIndex] -= 1.0f - scaledWeights[smallIndex];
+
+			if (scaledWeights[largeIndex] < 1.0f)
+			{
+				largeColumns.pop_back();
+				smallColumns.push_back(largeIndex);
+			}
+		}
+
+		/// \note The rest columns are full up to rounding errors
+		for (U32 index : smallColumns)
+		{
+			mProbabilities[index] = 1.0f;
+		}
+
+		for (U32 index : largeColumns)
+		{
+			mProbabilities[index] = 1.0f;
+		}
+	}
+
+
+	TDE2_API CPowerUpsTable* CreatePowerUpsTable(IResourceManager* pResourceManager, const std::string& name, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CPowerUpsTable, CPowerUpsTable, result, pResourceManager, name);
+	}
+
+
+	TDE2_DEFINE_DEFAULT_RESOURCE_LOADER(PowerUpsTable)
+	TDE2_DEFINE_DEFAULT_RESOURCE_FACTORY(PowerUpsTable)
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "../include/CPrefabTemplates.h"
+#include "../include/CSceneArenas.h"
+#include <utils/CFileLogger.h>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	constexpr U32 CPrefabTemplatesCache::InvalidParentIndex;
+
+
+	CPrefabTemplatesCache& CPrefabTemplatesCache::Get()
+	{
+		static CPrefabTemplatesCache instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CPrefabTemplatesCache::Free()
+	{
+		E_RESULT_CODE result = RC_OK;
+
+		for (auto&& currTemplate : mTemplates)
+		{
+			for (TComponentPrototype& currComponent : currTemplate.second.mComponents)
+			{
+				result = result | currComponent.mpComponent->Free();
+			}
+		}
+
+		mTemplates.clear();
+		mComponentsFactories.clear();
+		mInstanceEntities.clear();
+
+		return result;
+	}
+
+	E_RESULT_CODE CPrefabTemplatesCache::SpawnBatch(IWorld* pWorld, IScene* pScene, const std::string& prefabId, U32 count,
+		const std::vector<TVector3>& positions, std::vector<CEntity*>& spawnedEntities)
+	{
+		if (!pWorld || !pScene || prefabId.empty() || (!positions.empty() && positions.size() != count))
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		const TPrefabTemplate* pTemplate = _getOrCompileTemplate(pWorld, pScene, prefabId);
+		if (!pTemplate)
+		{
+			return RC_FAIL;
+		}
+
+		/// \note An instance of an empty template has no root to return
+		if (pTemplate->mEntities.empty() || mInstanceEntities.empty())
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CPrefabTemplatesCache] The template of prefab {0} contains no entities", prefabId));
+			return RC_FAIL;
+		}
+
+		spawnedEntities.reserve(spawnedEntities.size() + count);
+
+		E_RESULT_CODE result = RC_OK;
+
+		for (U32 i = 0; i < count; i++)
+		{
+			result = result | _instantiate(pWorld, pScene, *pTemplate, positions.empty() ? nullptr : &positions[i]);
+
+			CEntity* pRootEntity = mInstanceEntities.front();
+			if (!pRootEntity)
+			{
+				break;
+			}
+
+			spawnedEntities.push_back(pRootEntity);
+		}
+
+		return result;
+	}
+
+	bool CPrefabTemplatesCache::HasTemplate(const std::string& prefabId) const
+	{
+		return mTemplates.find(prefabId) != mTemplates.cend();
+	}
+
+	const CPrefabTemplatesCache::TPrefabTemplate* CPrefabTemplatesCache::_getOrCompileTemplate(IWorld* pWorld, IScene* pScene, const std::string& prefabId)
+	{
+		auto it = mTemplates.find(prefabId);
+		if (mTemplates.cend() != it)
+		{
+			return &it->second;
+		}
+
+		if (mComponentsFactories.empty())
+		{
+			pWorld->ForEachComponentFactory([this](TPtr<IComponentFactory> pFactory)
+			{
+				mComponentsFactories.emplace(pFactory->GetComponentTypeId(), pFactory);
+			});
+		}
+
+		/// \note Prototypes outlive the scene, so neither they nor the source instance are placed into its arena
+		TSceneArenaScope arenaScope(TSceneId::Invalid);
+
+		/// \note The prefab is spawned once with the usual way, its instance is the source of the template
+		CEntity* pRootEntity = pScene->Spawn(prefabId);
+		if (!pRootEntity)
+		{
+			return nullptr;
+		}
+
+		TPrefabTemplate prefabTemplate;
+		std::vector<TEntityId> sourceEntities;
+
+		std::vector<std::pair<TEntityId, U32>> entitiesToVisit { { pRootEntity->GetId(), InvalidParentIndex } };
+
+		while (!entitiesToVisit.empty())
+		{
+			const TEntityId currEntityId = entitiesToVisit.back().first;
+			const U32 parentIndex = entitiesToVisit.back().second;
+
+			entitiesToVisit.pop_back();
+
+			CEntity* pEntity = pWorld->FindEntity(currEntityId);
+			CTransform* pTransform = pEntity ? pEntity->GetComponent<CTransform>() : nullptr;
+
+			if (!pTransform)
+			{
+				continue;
+			}
+
+			const U32 entityIndex = static_cast<U32>(prefabTemplate.mEntities.size());
+
+			TTemplateEntity templateEntity { pEntity->GetName(), parentIndex, static_cast<U32>(prefabTemplate.mComponents.size()), 0,
+				pTransform->GetPosition(), pTransform->GetRotation(), pTransform->GetScale() };
+
+			for (IComponent* pComponent : pEntity->GetComponents())
+			{
+				if (pComponent->IsRuntimeOnly() || CTransform::GetTypeId() == pComponent->GetComponentTypeId())
+				{
+					continue;
+				}
+
+				if (IComponent* pComponentCopy = _copyComponent(pComponent))
+				{
+					prefabTemplate.mComponents.push_back({ pComponent->GetComponentTypeId(), pComponentCopy });
+					++templateEntity.mComponentsCount;
+				}
+			}
+
+			prefabTemplate.mEntities.emplace_back(std::move(templateEntity));
+			sourceEntities.push_back(currEntityId);
+
+			/// \note Children are pushed in reverse, so they are visited in their original order
+			const std::vector<TEntityId>& children = pTransform->GetChildren();
+
+			for (auto childIt = children.crbegin(); childIt != children.crend(); ++childIt)
+			{
+				entitiesToVisit.push_back({ *childIt, entityIndex });
+			}
+		}
+
+		for (auto sourceIt = sourceEntities.crbegin(); sourceIt != sourceEntities.crend(); ++sourceIt)
+		{
+			E_RESULT_CODE result = pScene->RemoveEntity(*sourceIt);
+			TDE2_ASSERT(RC_OK == result);
+		}
+
+		LOG_MESSAGE(Wrench::StringUtils::Format("[CPrefabTemplatesCache] The prefab \"{0}\" is compiled, entities: {1}, components: {2}",
+			prefabId, prefabTemplate.mEntities.size(), prefabTemplate.mComponents.size()));
+
+		mInstanceEntities.resize(std::max(mInstanceEntities.size(), prefabTemplate.mEntities.size()));
+
+		return &mTemplates.emplace(prefabId, std::move(prefabTemplate)).first->second;
+	}
+
+	IComponent* CPrefabTemplatesCache::_copyComponent(const IComponent* pComponent)
+	{
+		auto it = mComponentsFactories.find(pComponent->GetComponentTypeId());
+		if (mComponentsFactories.cend() == it)
+		{
+			return nullptr;
+		}
+
+		IComponent* pComponentCopy = it->second->CreateDefault();
+		if (!pComponentCopy)
+		{
+			return nullptr;
+		}
+
+		if (RC_OK != pComponent->Clone(pComponentCopy))
+		{
+			LOG_WARNING(Wrench::StringUtils::Format("[CPrefabTemplatesCache] Couldn't copy a component of type {0}", pComponent->GetTypeName()));
+
+			pComponentCopy->Free();
+			return nullptr;
+		}
+
+		return pComponentCopy;
+	}
+
+	E_RESULT_CODE CPrefabTemplatesCache::_instantiate(IWorld* pWorld, IScene* pScene, const TPrefabTemplate& prefabTemplate, const TVector3* pRootPosition)
+	{
+		E_RESULT_CODE result = RC_OK;
+
+		std::fill(mInstanceEntities.begin(), mInstanceEntities.end(), nullptr);
+
+		for (USIZE i = 0; i < prefabTemplate.mEntities.size(); i++)
+		{
+			const TTemplateEntity& currEntity = prefabTemplate.mEntities[i];
+
+			CEntity* pEntity = pScene->CreateEntity(currEntity.mName);
+			if (!pEntity)
+			{
+				return RC_FAIL;
+			}
+
+			mInstanceEntities[i] = pEntity;
+
+			if (CTransform* pTransform = pEntity->GetComponent<CTransform>())
+			{
+				pTransform->SetPosition((!i && pRootPosition) ? *pRootPosition : currEntity.mPosition);
+				pTransform->SetRotation(currEntity.mRotation);
+				pTransform->SetScale(currEntity.mScale);
+			}
+
+			if (InvalidParentIndex != currEntity.mParentIndex)
+			{
+				result = result | GroupEntities(pWorld, mInstanceEntities[currEntity.mParentIndex]->GetId(), pEntity->GetId());
+			}
+
+			const U32 lastComponentIndex = currEntity.mFirstComponentIndex + currEntity.mComponentsCount;
+
+			for (U32 k = currEntity.mFirstComponentIndex; k < lastComponentIndex; k++)
+			{
+				const TComponentPrototype& currPrototype = prefabTemplate.mComponents[k];
+
+				IComponent* pComponent = pEntity->AddComponent(currPrototype.mTypeId);
+				if (!pComponent)
+				{
+					result = result | RC_FAIL;
+					continue;
+				}
+
+				result = result | currPrototype.mpComponent->Clone(pComponent);
+			}
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "../include/CSceneArenas.h"
+#include <utils/CFileLogger.h>
+#include <cstring>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	constexpr USIZE CSceneArenas::HeaderSize;
+	constexpr USIZE CSceneArenas::DefaultPageSize;
+	constexpr U32 CSceneArenas::InvalidArenaId;
+
+
+	thread_local TSceneId TSceneArenaScope::mCurrSceneId = TSceneId::Invalid;
+
+
+	static inline USIZE AlignArenaSize(USIZE size)
+	{
+		return (size + CSceneArenas::HeaderSize - 1) & ~(CSceneArenas::HeaderSize - 1);
+	}
+
+
+	CSceneArenas& CSceneArenas::Get()
+	{
+		static CSceneArenas instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CSceneArenas::Free()
+	{
+		std::vector<TSceneId> scenes;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			for (auto&& currSceneArena : mSceneArenas)
+			{
+				scenes.push_back(currSceneArena.first);
+			}
+		}
+
+		E_RESULT_CODE result = RC_OK;
+
+		for (TSceneId currSceneId : scenes)
+		{
+			result = result | ReleaseScene(currSceneId);
+		}
+
+		return result;
+	}
+
+	E_RESULT_CODE CSceneArenas::ReleaseScene(TSceneId sceneId)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto sceneIt = mSceneArenas.find(sceneId);
+		if (mSceneArenas.cend() == sceneIt)
+		{
+			return RC_OK; /// \note Nothing was allocated for the scene
+		}
+
+		auto arenaIt = mArenas.find(sceneIt->second);
+		mSceneArenas.erase(sceneIt);
+
+		if (mArenas.end() == arenaIt)
+		{
+			return RC_FAIL;
+		}
+
+		TArena& arena = arenaIt->second;
+		arena.mIsReleased = true;
+
+		LOG_MESSAGE(Wrench::StringUtils::Format("[CSceneArenas] The arena of scene {0} is released, reserved: {1} bytes, used: {2} bytes, live objects: {3}",
+			static_cast<U32>(sceneId), arena.mReservedMemorySize, arena.mUsedMemorySize, arena.mLiveObjectsCount));
+
+		if (!arena.mLiveObjectsCount)
+		{
+			_destroyArena(arenaIt);
+		}
+
+		return RC_OK;
+	}
+
+	void* CSceneArenas::Allocate(USIZE size, IAllocator* pFallbackAllocator)
+	{
+		const TSceneId sceneId = TSceneArenaScope::mCurrSceneId;
+
+		U8* pBlock = nullptr;
+		U32 arenaId = InvalidArenaId;
+
+		if (TSceneId::Invalid != sceneId)
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			arenaId = _getOrCreateArena(sceneId);
+			pBlock = static_cast<U8*>(_allocateFromArena(mArenas[arenaId], size));
+		}
+		else if (pFallbackAllocator)
+		{
+			pBlock = static_cast<U8*>(pFallbackAllocator->Allocate(size + HeaderSize, static_cast<U8>(HeaderSize)));
+		}
+
+		if (!pBlock)
+		{
+			return nullptr;
+		}
+
+		std::memcpy(pBlock, &arenaId, sizeof(arenaId));
+
+		CAllocationProfiler::Get().OnAllocate(mProfilerAllocatorId, pBlock + HeaderSize, size);
+
+		if (mAllocationsListener)
+		{
+			mAllocationsListener(pBlock + HeaderSize, size, true);
+		}
+
+		return pBlock + HeaderSize;
+	}
+
+	void CSceneArenas::Deallocate(void* pObjectPtr, IAllocator* pFallbackAllocator)
+	{
+		if (!pObjectPtr)
+		{
+			return;
+		}
+
+		CAllocationProfiler::Get().OnDeallocate(mProfilerAllocatorId, pObjectPtr);
+
+		if (mAllocationsListener)
+		{
+			mAllocationsListener(pObjectPtr, 0, false);
+		}
+
+		U8* pBlock = static_cast<U8*>(pObjectPtr) - HeaderSize;
+
+		U32 arenaId = InvalidArenaId;
+		std::memcpy(&arenaId, pBlock, sizeof(arenaId));
+
+		if (InvalidArenaId == arenaId)
+		{
+			if (pFallbackAllocator)
+			{
+				pFallbackAllocator->Deallocate(pBlock);
+			}
+
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto arenaIt = mArenas.find(arenaId);
+		if (mArenas.end() == arenaIt)
+		{
+			TDE2_ASSERT(false);
+			return;
+		}
+
+		TArena& arena = arenaIt->second;
+		TDE2_ASSERT(arena.mLiveObjectsCount);
+
+		/// \note The memory isn't reused until the whole arena is returned
+		if (!--arena.mLiveObjectsCount && arena.mIsReleased)
+		{
+			_destroyArena(arenaIt);
+		}
+	}
+
+	std::vector<TSceneArenaStatistics> CSceneArenas::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		std::vector<TSceneArenaStatistics> statistics;
+		statistics.reserve(mArenas.size());
+
+		for (auto&& currArena : mArenas)
+		{
+			const TArena& arena = currArena.second;
+			statistics.push_back({ arena.mSceneId, arena.mReservedMemorySize, arena.mUsedMemorySize, arena.mLiveObjectsCount, arena.mIsReleased });
+		}
+
+		return statistics;
+	}
+
+	E_RESULT_CODE CSceneArenas::SetPageSize(USIZE pageSize)
+	{
+		if (pageSize < 2 * HeaderSize)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mPageSize = AlignArenaSize(pageSize);
+
+		return RC_OK;
+	}
+
+	void CSceneArenas::SetAllocationsListener(const TAllocationsListener& listener)
+	{
+		mAllocationsListener = listener;
+	}
+
+	U32 CSceneArenas::_getOrCreateArena(TSceneId sceneId)
+	{
+		auto it = mSceneArenas.find(sceneId);
+		if (mSceneArenas.cend() != it)
+		{
+			return it->second;
+		}
+
+		const U32 arenaId = mNextArenaId++;
+
+		TArena& arena = mArenas[arenaId];
+		arena.mSceneId = sceneId;
+
+		mSceneArenas.emplace(sceneId, arenaId);
+
+		return arenaId;
+	}
+
+	void* CSceneArenas::_allocateFromArena(TArena& arena, USIZE size)
+	{
+		const USIZE blockSize = HeaderSize + AlignArenaSize(size);
+
+		/// \note Too large objects get their own page, the current one is kept for the next allocations
+		if (blockSize > mPageSize)
+		{
+			U8* pPage = new (std::nothrow) U8[blockSize];
+			if (!pPage)
+			{
+				return nullptr;
+			}
+
+			arena.mPages.insert(arena.mPages.empty() ? arena.mPages.end() : arena.mPages.end() - 1, pPage);
+			arena.mReservedMemorySize += blockSize;
+			arena.mUsedMemorySize += blockSize;
+			++arena.mLiveObjectsCount;
+
+			return pPage;
+		}
+
+		if (arena.mPages.empty() || arena.mCurrPageOffset + blockSize > arena.mCurrPageSize)
+		{
+			U8* pPage = new (std::nothrow) U8[mPageSize];
+			if (!pPage)
+			{
+				return nullptr;
+			}
+
+			arena.mPages.push_back(pPage);
+			arena.mCurrPageOffset = 0;
+			arena.mCurrPageSize = mPageSize;
+			arena.mReservedMemorySize += mPageSize;
+		}
+
+		U8* pBlock = arena.mPages.back() + arena.mCurrPageOffset;
+
+		arena.mCurrPageOffset += blockSize;
+		arena.mUsedMemorySize += blockSize;
+		++arena.mLiveObjectsCount;
+
+		return pBlock;
+	}
+
+	void CSceneArenas::_destroyArena(TArenasTable::iterator arenaIt)
+	{
+		for (U8* pCurrPage : arenaIt->second.mPages)
+		{
+			delete[] pCurrPage;
+		}
+
+		mArenas.erase(arenaIt);
+	}
+
+
+	TSceneArenaScope::TSceneArenaScope(TSceneId sceneId) :
+		mPrevSceneId(mCurrSceneId)
+	{
+		mCurrSceneId = sceneId;
+	}
+
+	TSceneArenaScope::~TSceneArenaScope()
+	{
+		mCurrSceneId = mPrevSceneId;
+	}
+}
\ No newline at end of file
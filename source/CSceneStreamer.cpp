@@ -0,0 +1,248 @@
+#include "../include/CSceneStreamer.h"
+#include "../include/CSceneArenas.h"
+#include <chrono>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	typedef std::chrono::steady_clock TStreamingClock;
+
+
+	constexpr U32 CSceneStreamer::DefaultFrameBudget;
+
+
+	CSceneStreamer& CSceneStreamer::Get()
+	{
+		static CSceneStreamer instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CSceneStreamer::Init(TPtr<ISceneManager> pSceneManager, U32 frameBudget)
+	{
+		if (mpSceneManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pSceneManager || !frameBudget)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpSceneManager = pSceneManager;
+		mFrameBudget = frameBudget;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CSceneStreamer::Free()
+	{
+		if (!mpSceneManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+
+		/// \note There are no next frames to spread the work over, so the manager destroys the rest of entities
+		for (const TTeardownJob& currJob : mJobs)
+		{
+			result = result | mpSceneManager->UnloadScene(currJob.mSceneId);
+			result = result | CSceneArenas::Get().ReleaseScene(currJob.mSceneId);
+		}
+
+		mJobs.clear();
+
+		_onIdle();
+
+		mpSceneManager = nullptr;
+
+		return result;
+	}
+
+	E_RESULT_CODE CSceneStreamer::UnloadScene(TSceneId sceneId)
+	{
+		if (!mpSceneManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (TSceneId::Invalid == sceneId || MainScene == sceneId)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		auto it = std::find_if(mJobs.cbegin(), mJobs.cend(), [sceneId](const TTeardownJob& job) { return job.mSceneId == sceneId; });
+		if (mJobs.cend() != it)
+		{
+			return RC_OK;
+		}
+
+		auto getSceneResult = mpSceneManager->GetScene(sceneId);
+		if (getSceneResult.HasError())
+		{
+			return getSceneResult.GetError();
+		}
+
+		auto pScene = getSceneResult.Get();
+		if (!pScene)
+		{
+			return RC_FAIL;
+		}
+
+		TTeardownJob job { sceneId, pScene->GetEntities(), 0 };
+
+		/// \note Entities are created from parents to children, so the reversed order removes leaves first
+		std::reverse(job.mEntities.begin(), job.mEntities.end());
+
+		_deactivateRoots(mpSceneManager->GetWorld().Get(), job.mEntities);
+
+		mEnqueuedEntitiesCount += job.mEntities.size();
+		mJobs.emplace_back(std::move(job));
+
+		return RC_OK;
+	}
+
+	void CSceneStreamer::Update()
+	{
+		if (mJobs.empty())
+		{
+			return;
+		}
+
+		const TStreamingClock::time_point startTime = TStreamingClock::now();
+		const std::chrono::microseconds budget(mFrameBudget);
+
+		TPtr<IWorld> pWorld = mpSceneManager->GetWorld();
+
+		bool hasRemovedEntities = false;
+
+		while (!mJobs.empty())
+		{
+			TTeardownJob& currJob = mJobs.front();
+
+			auto getSceneResult = mpSceneManager->GetScene(currJob.mSceneId);
+			auto pScene = getSceneResult.IsOk() ? getSceneResult.Get() : nullptr;
+
+			while (pScene && currJob.mNextEntityIndex < currJob.mEntities.size())
+			{
+				if (hasRemovedEntities && TStreamingClock::now() - startTime >= budget)
+				{
+					return;
+				}
+
+				const TEntityId currEntityId = currJob.mEntities[currJob.mNextEntityIndex++];
+				++mRemovedEntitiesCount;
+
+				/// \note The entity could be already destroyed by the gameplay code
+				if (!pWorld->FindEntity(currEntityId))
+				{
+					continue;
+				}
+
+				E_RESULT_CODE result = pScene->RemoveEntity(currEntityId);
+				TDE2_ASSERT(RC_OK == result);
+
+				hasRemovedEntities = true;
+			}
+
+			if (pScene)
+			{
+				E_RESULT_CODE result = mpSceneManager->UnloadScene(currJob.mSceneId); /// \note The scene is empty, so it's cheap
+				TDE2_ASSERT(RC_OK == result);
+
+				result = CSceneArenas::Get().ReleaseScene(currJob.mSceneId);
+				TDE2_ASSERT(RC_OK == result);
+			}
+
+			mRemovedEntitiesCount += currJob.mEntities.size() - currJob.mNextEntityIndex;
+			mJobs.pop_front();
+		}
+
+		_onIdle();
+	}
+
+	void CSceneStreamer::NotifyWhenIdle(const std::function<void()>& callback)
+	{
+		if (!callback)
+		{
+			return;
+		}
+
+		if (mJobs.empty())
+		{
+			callback();
+			return;
+		}
+
+		mIdleCallbacks.push_back(callback);
+	}
+
+	E_RESULT_CODE CSceneStreamer::SetFrameBudget(U32 microseconds)
+	{
+		if (!microseconds)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mFrameBudget = microseconds;
+
+		return RC_OK;
+	}
+
+	U32 CSceneStreamer::GetFrameBudget() const
+	{
+		return mFrameBudget;
+	}
+
+	bool CSceneStreamer::IsIdle() const
+	{
+		return mJobs.empty();
+	}
+
+	F32 CSceneStreamer::GetProgress() const
+	{
+		return mEnqueuedEntitiesCount ? static_cast<F32>(mRemovedEntitiesCount) / static_cast<F32>(mEnqueuedEntitiesCount) : 1.0f;
+	}
+
+	void CSceneStreamer::_deactivateRoots(IWorld* pWorld, const std::vector<TEntityId>& entities)
+	{
+		/// \note Only roots are deactivated, their children are disabled together with them
+		for (TEntityId currEntityId : entities)
+		{
+			CEntity* pEntity = pWorld->FindEntity(currEntityId);
+			if (!pEntity || pEntity->HasComponent<CDeactivatedComponent>())
+			{
+				continue;
+			}
+
+			CTransform* pTransform = pEntity->GetComponent<CTransform>();
+			if (pTransform && TEntityId::Invalid != pTransform->GetParent())
+			{
+				continue;
+			}
+
+			E_RESULT_CODE result = SetEntityActive(pWorld, currEntityId, false);
+			TDE2_ASSERT(RC_OK == result);
+		}
+	}
+
+	void CSceneStreamer::_onIdle()
+	{
+		mEnqueuedEntitiesCount = 0;
+		mRemovedEntitiesCount = 0;
+
+		/// \note A callback could enqueue another scene or wait for the streamer again
+		std::vector<std::function<void()>> callbacks;
+		callbacks.swap(mIdleCallbacks);
+
+		for (const std::function<void()>& currCallback : callbacks)
+		{
+			currCallback();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,555 @@
+#include "../include/CTLSFAllocator.h"
+#include <algorithm>
+#include <cstring>
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	constexpr USIZE CTLSFAllocator::SmallObjectMaxSize;
+	constexpr U32 CTLSFAllocator::MaxThreadCachesCount;
+	constexpr USIZE CTLSFAllocator::MinBlockSize;
+
+
+	static std::atomic<U32> NextThreadCacheSlot { 0 };
+
+
+	static inline U32 FindLastSetBit(U64 value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse64(&index, value);
+		return static_cast<U32>(index);
+#else
+		return 63 - static_cast<U32>(__builtin_clzll(value));
+#endif
+	}
+
+	static inline U32 FindFirstSetBit(U64 value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return static_cast<U32>(index);
+#else
+		return static_cast<U32>(__builtin_ctzll(value));
+#endif
+	}
+
+	static inline USIZE AlignUp(USIZE value, USIZE alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+
+	CTLSFAllocator::CTLSFAllocator() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CTLSFAllocator::Init(TSizeType pageSize)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (pageSize < SmallBlockSize)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mPageSize = AlignUp(pageSize, AlignSize);
+		mProfilerAllocatorId = CAllocationProfiler::Get().RegisterAllocator("tlsf");
+
+		mpThreadCaches.reset(new (std::nothrow) TThreadCache[MaxThreadCachesCount]());
+		if (!mpThreadCaches)
+		{
+			return RC_OUT_OF_MEMORY;
+		}
+
+		E_RESULT_CODE result = Clear();
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	void* CTLSFAllocator::Allocate(TSizeType size, U8 alignment)
+	{
+		if (!size || (alignment & (alignment - 1)))
+		{
+			return nullptr;
+		}
+
+		if (size <= SmallObjectMaxSize && alignment <= AlignSize)
+		{
+			if (TThreadCache* pCache = _getThreadCache())
+			{
+				void* pPtr = _allocateSmall(*pCache, size);
+
+				if (pPtr)
+				{
+					CAllocationProfiler::Get().OnAllocate(mProfilerAllocatorId, pPtr, size);
+				}
+
+				return pPtr;
+			}
+		}
+
+		void* pPtr = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			pPtr = _allocateBlock(size, alignment);
+		}
+
+		if (pPtr)
+		{
+			mUsedMemorySize += reinterpret_cast<const TBlockHeader*>(static_cast<U8*>(pPtr) - HeaderSize)->mSize;
+			++mAllocationsCount;
+
+			CAllocationProfiler::Get().OnAllocate(mProfilerAllocatorId, pPtr, size);
+		}
+
+		return pPtr;
+	}
+
+	E_RESULT_CODE CTLSFAllocator::Deallocate(void* pObjectPtr)
+	{
+		if (!pObjectPtr)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		CAllocationProfiler::Get().OnDeallocate(mProfilerAllocatorId, pObjectPtr);
+
+		TBlockHeader* pBlock = reinterpret_cast<TBlockHeader*>(static_cast<U8*>(pObjectPtr) - HeaderSize);
+		const USIZE blockSize = pBlock->mSize;
+
+		TDE2_ASSERT(!(blockSize & 1));
+
+		mUsedMemorySize -= blockSize;
+		--mAllocationsCount;
+
+		if (blockSize <= SmallObjectMaxSize)
+		{
+			if (TThreadCache* pCache = _getThreadCache())
+			{
+				const U32 classIndex = static_cast<U32>(blockSize >> AlignSizeLog2) - 1;
+
+				pBlock->mpNextFreeBlock = pCache->mpBlocks[classIndex];
+				pCache->mpBlocks[classIndex] = pBlock;
+
+				if (++pCache->mBlocksCount[classIndex] > MaxCachedBlocksCount)
+				{
+					_flushCache(*pCache, classIndex, MaxCachedBlocksCount / 2);
+				}
+
+				return RC_OK;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		_freeBlock(pBlock);
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CTLSFAllocator::Clear()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mPages.clear();
+
+		mTotalMemorySize = 0;
+		mUsedMemorySize = 0;
+		mAllocationsCount = 0;
+
+		mFirstLevelBitmap = 0;
+		std::fill(std::begin(mSecondLevelBitmaps), std::end(mSecondLevelBitmaps), 0);
+		std::memset(mpFreeBlocks, 0, sizeof(mpFreeBlocks));
+
+		if (mpThreadCaches)
+		{
+			std::fill(mpThreadCaches.get(), mpThreadCaches.get() + MaxThreadCachesCount, TThreadCache {});
+		}
+
+		return RC_OK;
+	}
+
+#if TDE2_EDITORS_ENABLED
+
+	void CTLSFAllocator::SetBlockDebugName(const std::string& blockId)
+	{
+		mName = blockId;
+	}
+
+#endif
+
+	IAllocator::TSizeType CTLSFAllocator::GetTotalMemorySize() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mTotalMemorySize;
+	}
+
+	IAllocator::TSizeType CTLSFAllocator::GetUsedMemorySize() const
+	{
+		return mUsedMemorySize;
+	}
+
+	U32 CTLSFAllocator::GetAllocationsCount() const
+	{
+		return mAllocationsCount;
+	}
+
+	E_RESULT_CODE CTLSFAllocator::_onFreeInternal()
+	{
+		return Clear();
+	}
+
+	void* CTLSFAllocator::_allocateBlock(USIZE size, USIZE alignment)
+	{
+		const USIZE blockSize = std::max(AlignUp(size, AlignSize), MinBlockSize);
+
+		/// \note Stricter alignment is reached by cutting a free block of the gap's size from the beginning
+		const USIZE maxGapSize = (alignment > AlignSize) ? (alignment + HeaderSize + MinBlockSize) : 0;
+
+		TBlockHeader* pBlock = _findFreeBlock(blockSize + maxGapSize);
+		if (!pBlock)
+		{
+			if (RC_OK != _addPage(blockSize + maxGapSize))
+			{
+				return nullptr;
+			}
+
+			pBlock = _findFreeBlock(blockSize + maxGapSize);
+			if (!pBlock)
+			{
+				TDE2_ASSERT(false);
+				return nullptr;
+			}
+		}
+
+		_removeFreeBlock(pBlock);
+
+		const uintptr_t payloadAddress = reinterpret_cast<uintptr_t>(pBlock) + HeaderSize;
+
+		if (maxGapSize && (payloadAddress & (alignment - 1)))
+		{
+			const uintptr_t alignedAddress = AlignUp(payloadAddress + HeaderSize + MinBlockSize, alignment);
+			pBlock = _trimLeadingGap(pBlock, alignedAddress - payloadAddress);
+		}
+
+		_splitBlock(pBlock, blockSize);
+
+		pBlock->mSize &= ~static_cast<USIZE>(1);
+
+		return reinterpret_cast<U8*>(pBlock) + HeaderSize;
+	}
+
+	void CTLSFAllocator::_freeBlock(TBlockHeader* pBlock)
+	{
+		pBlock->mSize |= 1;
+
+		TBlockHeader* pPrevBlock = pBlock->mpPrevPhysBlock;
+		if (pPrevBlock && (pPrevBlock->mSize & 1))
+		{
+			_removeFreeBlock(pPrevBlock);
+
+			pPrevBlock->mSize += HeaderSize + (pBlock->mSize & ~static_cast<USIZE>(1));
+			pBlock = pPrevBlock;
+		}
+
+		TBlockHeader* pNextBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pBlock) + HeaderSize + (pBlock->mSize & ~static_cast<USIZE>(1)));
+		if (pNextBlock->mSize & 1)
+		{
+			_removeFreeBlock(pNextBlock);
+
+			pBlock->mSize += HeaderSize + (pNextBlock->mSize & ~static_cast<USIZE>(1));
+			pNextBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pBlock) + HeaderSize + (pBlock->mSize & ~static_cast<USIZE>(1)));
+		}
+
+		pNextBlock->mpPrevPhysBlock = pBlock;
+
+		_insertFreeBlock(pBlock);
+	}
+
+	CTLSFAllocator::TBlockHeader* CTLSFAllocator::_findFreeBlock(USIZE size)
+	{
+		U32 firstLevel = 0;
+		U32 secondLevel = 0;
+
+		_getListIndices(_roundUpToListSize(size), firstLevel, secondLevel);
+
+		if (firstLevel >= FirstLevelsCount)
+		{
+			return nullptr;
+		}
+
+		U32 secondLevelBitmap = mSecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+
+		if (!secondLevelBitmap)
+		{
+			const U64 firstLevelBitmap = (firstLevel + 1 < 64) ? (mFirstLevelBitmap & (~static_cast<U64>(0) << (firstLevel + 1))) : 0;
+			if (!firstLevelBitmap)
+			{
+				return nullptr;
+			}
+
+			firstLevel = FindFirstSetBit(firstLevelBitmap);
+			secondLevelBitmap = mSecondLevelBitmaps[firstLevel];
+		}
+
+		return mpFreeBlocks[firstLevel][FindFirstSetBit(secondLevelBitmap)];
+	}
+
+	E_RESULT_CODE CTLSFAllocator::_addPage(USIZE minBlockSize)
+	{
+		/// \note The first block should be found by _findFreeBlock with the same size
+		const USIZE pageSize = std::max(mPageSize, AlignUp(_roundUpToListSize(minBlockSize), AlignSize) + 2 * HeaderSize);
+
+		std::unique_ptr<U8[]> pPage(new (std::nothrow) U8[pageSize]);
+		if (!pPage)
+		{
+			return RC_OUT_OF_MEMORY;
+		}
+
+		TBlockHeader* pBlock = reinterpret_cast<TBlockHeader*>(pPage.get());
+		pBlock->mpPrevPhysBlock = nullptr;
+		pBlock->mSize = (pageSize - 2 * HeaderSize) | 1;
+
+		/// \note The empty used block at the end stops merging with memory beyond the page
+		TBlockHeader* pSentinelBlock = reinterpret_cast<TBlockHeader*>(pPage.get() + pageSize - HeaderSize);
+		pSentinelBlock->mpPrevPhysBlock = pBlock;
+		pSentinelBlock->mSize = 0;
+
+		_insertFreeBlock(pBlock);
+
+		mPages.emplace_back(std::move(pPage));
+		mTotalMemorySize += pageSize;
+
+		return RC_OK;
+	}
+
+	void CTLSFAllocator::_insertFreeBlock(TBlockHeader* pBlock)
+	{
+		U32 firstLevel = 0;
+		U32 secondLevel = 0;
+
+		_getListIndices(pBlock->mSize & ~static_cast<USIZE>(1), firstLevel, secondLevel);
+
+		TBlockHeader*& pHead = mpFreeBlocks[firstLevel][secondLevel];
+
+		pBlock->mpNextFreeBlock = pHead;
+		pBlock->mpPrevFreeBlock = nullptr;
+
+		if (pHead)
+		{
+			pHead->mpPrevFreeBlock = pBlock;
+		}
+
+		pHead = pBlock;
+
+		mFirstLevelBitmap |= static_cast<U64>(1) << firstLevel;
+		mSecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+	}
+
+	void CTLSFAllocator::_removeFreeBlock(TBlockHeader* pBlock)
+	{
+		U32 firstLevel = 0;
+		U32 secondLevel = 0;
+
+		_getListIndices(pBlock->mSize & ~static_cast<USIZE>(1), firstLevel, secondLevel);
+
+		if (pBlock->mpNextFreeBlock)
+		{
+			pBlock->mpNextFreeBlock->mpPrevFreeBlock = pBlock->mpPrevFreeBlock;
+		}
+
+		if (pBlock->mpPrevFreeBlock)
+		{
+			pBlock->mpPrevFreeBlock->mpNextFreeBlock = pBlock->mpNextFreeBlock;
+			return;
+		}
+
+		TBlockHeader*& pHead = mpFreeBlocks[firstLevel][secondLevel];
+		pHead = pBlock->mpNextFreeBlock;
+
+		if (pHead)
+		{
+			return;
+		}
+
+		mSecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+
+		if (!mSecondLevelBitmaps[firstLevel])
+		{
+			mFirstLevelBitmap &= ~(static_cast<U64>(1) << firstLevel);
+		}
+	}
+
+	CTLSFAllocator::TBlockHeader* CTLSFAllocator::_splitBlock(TBlockHeader* pBlock, USIZE size)
+	{
+		const USIZE blockSize = pBlock->mSize & ~static_cast<USIZE>(1);
+
+		if (blockSize < size + HeaderSize + MinBlockSize)
+		{
+			return nullptr; /// \note The rest is too small for a block, it stays within this one
+		}
+
+		TBlockHeader* pRestBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pBlock) + HeaderSize + size);
+		pRestBlock->mpPrevPhysBlock = pBlock;
+		pRestBlock->mSize = (blockSize - size - HeaderSize) | 1;
+
+		TBlockHeader* pNextBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pRestBlock) + HeaderSize + (pRestBlock->mSize & ~static_cast<USIZE>(1)));
+		pNextBlock->mpPrevPhysBlock = pRestBlock;
+
+		pBlock->mSize = size | (pBlock->mSize & 1);
+
+		/// \note The next block was a neighbour of a free one, so it's a used one and the rest isn't merged
+		_insertFreeBlock(pRestBlock);
+
+		return pRestBlock;
+	}
+
+	CTLSFAllocator::TBlockHeader* CTLSFAllocator::_trimLeadingGap(TBlockHeader* pBlock, USIZE gapSize)
+	{
+		const USIZE blockSize = pBlock->mSize & ~static_cast<USIZE>(1);
+
+		TBlockHeader* pAlignedBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pBlock) + gapSize);
+		pAlignedBlock->mpPrevPhysBlock = pBlock;
+		pAlignedBlock->mSize = (blockSize - gapSize) | 1;
+
+		TBlockHeader* pNextBlock = reinterpret_cast<TBlockHeader*>(reinterpret_cast<U8*>(pAlignedBlock) + HeaderSize + blockSize - gapSize);
+		pNextBlock->mpPrevPhysBlock = pAlignedBlock;
+
+		pBlock->mSize = (gapSize - HeaderSize) | 1;
+		_insertFreeBlock(pBlock);
+
+		return pAlignedBlock;
+	}
+
+	void* CTLSFAllocator::_allocateSmall(TThreadCache& cache, USIZE size)
+	{
+		const USIZE blockSize = std::max(AlignUp(size, AlignSize), MinBlockSize);
+		const U32 classIndex = static_cast<U32>(blockSize >> AlignSizeLog2) - 1;
+
+		if (!cache.mpBlocks[classIndex])
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			for (U32 i = 0; i < CacheRefillCount; i++)
+			{
+				void* pPtr = _allocateBlock(blockSize, AlignSize);
+				if (!pPtr)
+				{
+					break;
+				}
+
+				/// \note A block could be larger than it's requested, if the rest is too small to be split
+				TBlockHeader* pBlock = reinterpret_cast<TBlockHeader*>(static_cast<U8*>(pPtr) - HeaderSize);
+				if (pBlock->mSize != blockSize)
+				{
+					_freeBlock(pBlock);
+					continue;
+				}
+
+				pBlock->mpNextFreeBlock = cache.mpBlocks[classIndex];
+				cache.mpBlocks[classIndex] = pBlock;
+
+				++cache.mBlocksCount[classIndex];
+			}
+
+			if (!cache.mpBlocks[classIndex])
+			{
+				void* pPtr = _allocateBlock(blockSize, AlignSize);
+				if (pPtr)
+				{
+					mUsedMemorySize += reinterpret_cast<const TBlockHeader*>(static_cast<U8*>(pPtr) - HeaderSize)->mSize;
+					++mAllocationsCount;
+				}
+
+				return pPtr;
+			}
+		}
+
+		TBlockHeader* pBlock = cache.mpBlocks[classIndex];
+
+		cache.mpBlocks[classIndex] = pBlock->mpNextFreeBlock;
+		--cache.mBlocksCount[classIndex];
+
+		mUsedMemorySize += blockSize;
+		++mAllocationsCount;
+
+		return reinterpret_cast<U8*>(pBlock) + HeaderSize;
+	}
+
+	void CTLSFAllocator::_flushCache(TThreadCache& cache, U32 classIndex, U32 keptBlocksCount)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		while (cache.mBlocksCount[classIndex] > keptBlocksCount)
+		{
+			TBlockHeader* pBlock = cache.mpBlocks[classIndex];
+
+			cache.mpBlocks[classIndex] = pBlock->mpNextFreeBlock;
+			--cache.mBlocksCount[classIndex];
+
+			_freeBlock(pBlock);
+		}
+	}
+
+	CTLSFAllocator::TThreadCache* CTLSFAllocator::_getThreadCache()
+	{
+		static thread_local const U32 threadCacheSlot = NextThreadCacheSlot++;
+
+		if (!mpThreadCaches || threadCacheSlot >= MaxThreadCachesCount)
+		{
+			return nullptr;
+		}
+
+		return &mpThreadCaches[threadCacheSlot];
+	}
+
+	void CTLSFAllocator::_getListIndices(USIZE size, U32& firstLevel, U32& secondLevel)
+	{
+		if (size < SmallBlockSize)
+		{
+			firstLevel = 0;
+			secondLevel = static_cast<U32>(size >> AlignSizeLog2);
+
+			return;
+		}
+
+		const U32 lastSetBit = FindLastSetBit(size);
+
+		firstLevel = lastSetBit - (FirstLevelShift - 1);
+		secondLevel = static_cast<U32>(size >> (lastSetBit - SecondLevelsCountLog2)) ^ SecondLevelsCount;
+	}
+
+	USIZE CTLSFAllocator::_roundUpToListSize(USIZE size)
+	{
+		if (size < SmallBlockSize)
+		{
+			return size;
+		}
+
+		return size + (static_cast<USIZE>(1) << (FindLastSetBit(size) - SecondLevelsCountLog2)) - 1;
+	}
+
+
+	TDE2_API IAllocator* CreateTLSFAllocator(USIZE pageSize, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(IAllocator, CTLSFAllocator, result, pageSize);
+	}
+}
\ No newline at end of file
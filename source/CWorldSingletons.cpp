@@ -0,0 +1,131 @@
+#include "../include/CWorldSingletons.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CWorldSingletonsCache& CWorldSingletonsCache::Get()
+	{
+		static CWorldSingletonsCache instance;
+		return instance;
+	}
+
+	E_RESULT_CODE CWorldSingletonsCache::Init(TPtr<IEventManager> pEventManager)
+	{
+		if (mpEventManager)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pEventManager)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | pEventManager->Subscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | pEventManager->Subscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
+
+		/// \note Slots could be filled before the subscription, so they can't be trusted
+		_invalidateSlots(TypeId::Invalid);
+
+		mpEventManager = pEventManager;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CWorldSingletonsCache::Free()
+	{
+		if (!mpEventManager)
+		{
+			return RC_OK;
+		}
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | mpEventManager->Unsubscribe(TOnComponentCreatedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnComponentRemovedEvent::GetTypeId(), this);
+		result = result | mpEventManager->Unsubscribe(TOnEntityRemovedEvent::GetTypeId(), this);
+
+		mpEventManager = nullptr;
+
+		_invalidateSlots(TypeId::Invalid);
+
+		return result;
+	}
+
+	E_RESULT_CODE CWorldSingletonsCache::OnEvent(const TBaseEvent* pEvent)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (const TOnComponentCreatedEvent* pComponentCreatedEvent = dynamic_cast<const TOnComponentCreatedEvent*>(pEvent))
+		{
+			_invalidateSlots(pComponentCreatedEvent->mCreatedComponentTypeId);
+			return RC_OK;
+		}
+
+		if (const TOnComponentRemovedEvent* pComponentRemovedEvent = dynamic_cast<const TOnComponentRemovedEvent*>(pEvent))
+		{
+			for (const TypeId currTypeId : pComponentRemovedEvent->mRemovedComponentsTypeId)
+			{
+				_invalidateSlots(currTypeId);
+			}
+
+			return RC_OK;
+		}
+
+		if (const TOnEntityRemovedEvent* pEntityRemovedEvent = dynamic_cast<const TOnEntityRemovedEvent*>(pEvent))
+		{
+			for (TSingletonSlot& currSlot : mSlots)
+			{
+				if (currSlot.mEntityId == pEntityRemovedEvent->mRemovedEntityId)
+				{
+					currSlot.mpComponent = nullptr;
+				}
+			}
+
+			return RC_OK;
+		}
+
+		return RC_FAIL;
+	}
+
+	TEventListenerId CWorldSingletonsCache::GetListenerId() const
+	{
+		return TEventListenerId(TDE2_TYPE_ID(CWorldSingletonsCache));
+	}
+
+	U32 CWorldSingletonsCache::_allocateSlotIndex()
+	{
+		static U32 slotsCounter = 0;
+		return slotsCounter++;
+	}
+
+	CWorldSingletonsCache::TSingletonSlot& CWorldSingletonsCache::_getSlot(U32 slotIndex)
+	{
+		if (slotIndex >= mSlots.size())
+		{
+			mSlots.resize(slotIndex + 1);
+		}
+
+		return mSlots[slotIndex];
+	}
+
+	void CWorldSingletonsCache::_invalidateSlots(TypeId typeId)
+	{
+		for (TSingletonSlot& currSlot : mSlots)
+		{
+			if (TypeId::Invalid == typeId || currSlot.mTypeId == typeId)
+			{
+				currSlot.mpComponent = nullptr;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "../include/GameModes.h"
 #include "../include/components/CGameInfo.h"
+#include "../include/CWorldSingletons.h"
+#include "../include/CEventChannels.h"
+#include "../include/CSceneStreamer.h"
 #include "../include/Components.h"
 #include "../include/Utilities.h"
 
@@ -19,7 +22,7 @@ namespace Game
 		auto pSceneManager = mParams.mpSceneManager;
 		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
 
-		CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 		if (!pGameInfo)
 		{
 			TDE2_ASSERT(false);
@@ -158,10 +161,21 @@ namespace Game
 	{
 		LOG_MESSAGE(Wrench::StringUtils::Format("[BaseGameMode] Invoke OnEnter, mode: \"{0}\"", mName));
 
-		E_RESULT_CODE result = mParams.mpEventManager->Subscribe(TDEngine2::TLivesChangedEvent::GetTypeId(), this);
-		TDE2_ASSERT(RC_OK == result);
+		if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mParams.mpSceneManager->GetWorld()))
+		{
+			pGameInfo->mIsGameplayActive = true;
+		}
 
-		result = mParams.mpEventManager->Subscribe(TDEngine2::TRestartLevelEvent::GetTypeId(), this);
+		mLivesChangedSubscriptionId = CEventChannels::Get().Subscribe<TLivesChangedEvent>([this](const TLivesChangedEvent& event)
+		{
+			if (event.mPlayerLives <= 0)
+			{
+				E_RESULT_CODE result = RC_OK;
+				mpOwner->SwitchMode(TPtr<IGameMode>(CreateLevelFinishedGameMode(mpOwner, mParams, result))); /// \todo Add defeat/victory flag passage
+			}
+		});
+
+		E_RESULT_CODE result = mParams.mpEventManager->Subscribe(TDEngine2::TRestartLevelEvent::GetTypeId(), this);
 		TDE2_ASSERT(RC_OK == result);
 
 		/// \note Load player's paddle and main UI
@@ -170,23 +184,22 @@ namespace Game
 		{
 			mPlayerSceneId = sceneId.Get();
 
-			auto&& pEventManager = mParams.mpEventManager;
 			auto pWorld = mParams.mpSceneManager->GetWorld();
 
-			if (CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>())
+			if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld))
 			{
 				{
 					TScoreChangedEvent scoreChangedEvent;
 					scoreChangedEvent.mNewPlayerScore = pGameInfo->mPlayerScore;
 
-					pEventManager->Notify(&scoreChangedEvent);
+					NotifyEvent(scoreChangedEvent);
 				}
 
 				{
 					TLivesChangedEvent livesChangedEvent;
 					livesChangedEvent.mPlayerLives = pGameInfo->mPlayerLives;
 
-					pEventManager->Notify(&livesChangedEvent);
+					NotifyEvent(livesChangedEvent);
 				}
 			}
 		});
@@ -196,9 +209,16 @@ namespace Game
 	{
 		LOG_MESSAGE(Wrench::StringUtils::Format("[BaseGameMode] Invoke OnExit, mode: \"{0}\"", mName));
 
-		E_RESULT_CODE result = mParams.mpEventManager->Unsubscribe(TDEngine2::TLivesChangedEvent::GetTypeId(), this);
+		if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mParams.mpSceneManager->GetWorld()))
+		{
+			pGameInfo->mIsGameplayActive = false;
+		}
+
+		E_RESULT_CODE result = CEventChannels::Get().Unsubscribe<TLivesChangedEvent>(mLivesChangedSubscriptionId);
 		TDE2_ASSERT(RC_OK == result);
 
+		mLivesChangedSubscriptionId = TEventSubscriptionId::Invalid;
+
 		result = mParams.mpEventManager->Unsubscribe(TDEngine2::TRestartLevelEvent::GetTypeId(), this);
 		TDE2_ASSERT(RC_OK == result);
 
@@ -218,16 +238,6 @@ namespace Game
 	
 	E_RESULT_CODE CCoreGameMode::OnEvent(const TBaseEvent* pEvent)
 	{
-		if (const TLivesChangedEvent* pLivesChangedEvent = dynamic_cast<const TLivesChangedEvent*>(pEvent))
-		{
-			E_RESULT_CODE result = RC_OK;
-
-			if (pLivesChangedEvent->mPlayerLives <= 0)
-			{
-				mpOwner->SwitchMode(TPtr<IGameMode>(CreateLevelFinishedGameMode(mpOwner, mParams, result))); /// \todo Add defeat/victory flag passage
-			}
-		}
-		
 		if (const TRestartLevelEvent* pRestartLevelEvent = dynamic_cast<const TRestartLevelEvent*>(pEvent))
 		{
 			mpOwner->PopMode(); // Remove pause game mode
@@ -514,6 +524,42 @@ namespace Game
 
 		/// \todo Replace hardcoded value later
 		SpawnModeWindow("LoadingWindow", true); /// \note Spawn a Loading window's prefab		
+
+		TPtr<IWorld> pWorld = mParams.mpSceneManager->GetWorld();
+
+		/// \note Gameplay systems are stopped while levels are switched, the screen could be pushed over the core mode
+		if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld))
+		{
+			mWasGameplayActive = pGameInfo->mIsGameplayActive;
+			pGameInfo->mIsGameplayActive = false;
+		}
+
+		std::vector<TEntityId> entitiesToVisit { mWindowHierarchyRootEntityId };
+
+		while (!entitiesToVisit.empty())
+		{
+			CEntity* pEntity = pWorld->FindEntity(entitiesToVisit.back());
+			entitiesToVisit.pop_back();
+
+			if (!pEntity)
+			{
+				continue;
+			}
+
+			if ("ProgressLabel" == pEntity->GetName() && pEntity->HasComponent<CLabel>())
+			{
+				mProgressLabelEntityId = pEntity->GetId();
+				break;
+			}
+
+			if (CTransform* pTransform = pEntity->GetComponent<CTransform>())
+			{
+				const std::vector<TEntityId>& children = pTransform->GetChildren();
+				entitiesToVisit.insert(entitiesToVisit.end(), children.cbegin(), children.cend());
+			}
+		}
+
+		_updateProgressLabel();
 	}
 
 	void CLoadingGameMode::OnExit()
@@ -522,6 +568,11 @@ namespace Game
 
 		/// \note Remove the Loading window
 		RemoveModeWindow();
+
+		if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mParams.mpSceneManager->GetWorld()))
+		{
+			pGameInfo->mIsGameplayActive = mWasGameplayActive;
+		}
 	}
 
 	void CLoadingGameMode::Update(F32 dt)
@@ -533,6 +584,33 @@ namespace Game
 			mpOwner->SwitchMode(TPtr<IGameMode>(CreateCoreGameMode(mpOwner, mParams, result)));
 		}*/
 
+		_updateProgressLabel();
+	}
+
+	void CLoadingGameMode::_updateProgressLabel()
+	{
+		const CSceneStreamer& sceneStreamer = CSceneStreamer::Get();
+
+		/// \note The progress is one of the previous level's teardown, the label keeps its last value while nothing is torn down
+		if (sceneStreamer.IsIdle())
+		{
+			return;
+		}
+
+		const F32 progress = sceneStreamer.GetProgress();
+
+		if (std::abs(progress - mProgress) < 0.01f)
+		{
+			return;
+		}
+
+		mProgress = progress;
+
+		CEntity* pLabelEntity = mParams.mpSceneManager->GetWorld()->FindEntity(mProgressLabelEntityId);
+		if (CLabel* pLabel = pLabelEntity ? pLabelEntity->GetComponent<CLabel>() : nullptr)
+		{
+			pLabel->SetText(Wrench::StringUtils::Format("{0}%", static_cast<U32>(progress * 100.0f)));
+		}
 	}
 
 
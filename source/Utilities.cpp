@@ -1,8 +1,13 @@
 #include "../include/Utilities.h"
 #include "../include/components/CGameInfo.h"
+#include "../include/CWorldSingletons.h"
 #include "../include/components/CLevelSettings.h"
 #include "../include/Components.h"
-#include "../include/CGameLevelsCollection.h"
+#include "../include/CGameLevelsCatalog.h"
+#include "../include/CGameLevelsPrefetcher.h"
+#include "../include/CGameLevelSnapshot.h"
+#include "../include/CSceneStreamer.h"
+#include "../include/CPowerUpsTable.h"
 #include "../include/GameModes.h"
 #include <utils/CFileLogger.h>
 
@@ -11,7 +16,75 @@ using namespace TDEngine2;
 
 namespace Game
 {
-	static const std::string GameLevelsCollectionPath = "ProjectResources/GameLevelsCollection.asset";
+	CLevelSettings* FindLevelSettings(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TSceneId sceneId)
+	{
+		auto getSceneResult = pSceneManager->GetScene(sceneId);
+		if (getSceneResult.HasError() || !getSceneResult.Get())
+		{
+			return nullptr;
+		}
+
+		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
+
+		for (TEntityId currEntityId : getSceneResult.Get()->GetEntities())
+		{
+			CEntity* pEntity = pWorld->FindEntity(currEntityId);
+
+			if (CLevelSettings* pLevelSettings = pEntity ? pEntity->GetComponent<CLevelSettings>() : nullptr)
+			{
+				return pLevelSettings;
+			}
+		}
+
+		return nullptr;
+	}
+
+
+	bool IsGameplayRunning(IWorld* pWorld)
+	{
+		const CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
+		return pGameInfo && pGameInfo->mIsGameplayActive && pWorld->GetTimeScaleFactor() > 0.0f;
+	}
+
+
+	/*!
+		\brief The function makes the scene the current game level, unloads the previous one and notifies all listeners
+	*/
+
+	static void OnGameLevelLoaded(TPtr<ISceneManager> pSceneManager, TPtr<IEventManager> pEventManager, TSceneId sceneId)
+	{
+		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
+
+		if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld))
+		{
+			const TSceneId prevLoadedSceneId = pGameInfo->mCurrLoadedGameId;
+			pGameInfo->mCurrLoadedGameId = sceneId;
+
+			if (TSceneId::Invalid != prevLoadedSceneId && prevLoadedSceneId != pGameInfo->mCurrLoadedGameId)
+			{
+				/// \note The previously loaded level disappears right away, its entities are destroyed during next frames
+				E_RESULT_CODE result = CSceneStreamer::Get().UnloadScene(prevLoadedSceneId);
+				TDE2_ASSERT(RC_OK == result);
+			}
+
+			if (CLevelSettings* pSettingsData = FindLevelSettings(pSceneManager, sceneId))
+			{
+				pGameInfo->mHorizontalConstraints = pSettingsData->mHorizontalConstraints;
+				pGameInfo->mVerticalConstraints = pSettingsData->mVerticalConstraints;
+			}
+			else
+			{
+				TDE2_ASSERT("[LoadGameLevel] LevelSettings component wasn't found in the level");
+			}
+		}
+
+		/// \note The snapshot is taken before listeners of the event spawn anything, e.g. prewarmed entities of the pool
+		E_RESULT_CODE result = CGameLevelSnapshot::Get().Capture(pSceneManager, sceneId);
+		TDE2_ASSERT(RC_OK == result);
+
+		TGameLevelLoadedEvent gameLevelLoadedEvent;
+		pEventManager->Notify(&gameLevelLoadedEvent);
+	}
 
 
 	TDE2_API void LoadGameLevel(
@@ -21,26 +94,25 @@ namespace Game
 		TDEngine2::TPtr<TDEngine2::IGameModesManager> pGameModesManager,
 		TDEngine2::USIZE levelIndex)
 	{
-		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
-
-		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
-		if (TResourceId::Invalid == gameLevelsCollectionHandle)
+		auto pLevelsCollection = CGameLevelsCatalog::Get().GetLevelsCollection(pResourceManager);
+		if (!pLevelsCollection)
 		{
 			TDE2_ASSERT(false);
 			return;
 		}
 
-		auto pLevelsCollection = pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
-		if (!pLevelsCollection)
+		auto findLevelResult = pLevelsCollection->GetLevelPathByIndex(levelIndex);
+		if (findLevelResult.HasError())
 		{
 			TDE2_ASSERT(false);
 			return;
 		}
 
-		auto findLevelResult = pLevelsCollection->GetLevelPathByIndex(levelIndex);
-		if (findLevelResult.HasError())
+		/// \note The level was loaded in the background, so its entities are just activated within the current frame
+		auto takePrefetchedLevelResult = CGameLevelsPrefetcher::Get().TakePrefetchedLevel(findLevelResult.Get());
+		if (takePrefetchedLevelResult.IsOk())
 		{
-			TDE2_ASSERT(false);
+			OnGameLevelLoaded(pSceneManager, pEventManager, takePrefetchedLevelResult.Get());
 			return;
 		}
 
@@ -58,42 +130,18 @@ namespace Game
 		}
 
 		/// \note Load a new one
-		pSceneManager->LoadSceneAsync(findLevelResult.Get(), [pSceneManager, pWorld, pEventManager, pGameModesManager](const TResult<TSceneId>& sceneId)
+		pSceneManager->LoadSceneAsync(findLevelResult.Get(), [pSceneManager, pEventManager, pGameModesManager](const TResult<TSceneId>& sceneId)
 		{
-			CEntity* pLevelSettingsEntity = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CLevelSettings>());
+			OnGameLevelLoaded(pSceneManager, pEventManager, sceneId.Get());
 
-			if (CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>())
+			/// \note Disable the loading screen when the previous level is torn down
+			if (pGameModesManager)
 			{
-				const TSceneId prevLoadedSceneId = pGameInfo->mCurrLoadedGameId;
-				pGameInfo->mCurrLoadedGameId = sceneId.Get();
-
-				if (TSceneId::Invalid != prevLoadedSceneId && prevLoadedSceneId != pGameInfo->mCurrLoadedGameId)
+				CSceneStreamer::Get().NotifyWhenIdle([pGameModesManager]
 				{
-					E_RESULT_CODE result = pSceneManager->UnloadScene(prevLoadedSceneId); /// \note Unload the previously loaded level
+					E_RESULT_CODE result = pGameModesManager->PopMode();
 					TDE2_ASSERT(RC_OK == result);
-				}
-
-				if (pLevelSettingsEntity)
-				{
-					CLevelSettings* pSettingsData = pLevelSettingsEntity->GetComponent<CLevelSettings>();
-					
-					pGameInfo->mHorizontalConstraints = pSettingsData->mHorizontalConstraints;
-					pGameInfo->mVerticalConstraints = pSettingsData->mVerticalConstraints;
-				}
-				else
-				{
-					TDE2_ASSERT("[LoadGameLevel] LevelSettings component wasn't found in the level");
-				}
-			}
-
-			TGameLevelLoadedEvent gameLevelLoadedEvent;
-			pEventManager->Notify(&gameLevelLoadedEvent);
-
-			/// \note Disable the loading screen 
-			if (pGameModesManager)
-			{
-				E_RESULT_CODE result = pGameModesManager->PopMode();
-				TDE2_ASSERT(RC_OK == result);
+				});
 			}
 		});
 	}
@@ -101,64 +149,16 @@ namespace Game
 
 	TResult<USIZE> GetCurrLevelIndex(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager)
 	{
-		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
-
-		CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>();
-		if (!pGameInfo)
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
-
-		auto getSceneResult = pSceneManager->GetScene(pGameInfo->mCurrLoadedGameId);
-		if (getSceneResult.HasError())
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
-
-		auto pScene = getSceneResult.Get();
-		if (!pScene)
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
-
-		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
-		if (TResourceId::Invalid == gameLevelsCollectionHandle)
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
-
-		auto pLevelsCollection = pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
-		if (!pLevelsCollection)
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
-
-		auto findLevelResult = pLevelsCollection->FindLevelIndex(pScene->GetScenePath());
-		if (findLevelResult.HasError())
-		{
-			TDE2_ASSERT(false);
-			return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
-		}
+		auto findLevelResult = CGameLevelsCatalog::Get().GetCurrLevelIndex(pSceneManager, pResourceManager);
+		TDE2_ASSERT(findLevelResult.IsOk());
 
-		return Wrench::TOkValue<USIZE>(findLevelResult.Get());
+		return findLevelResult;
 	}
 
 
 	bool IsNextGameLevelExists(TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager, I32 offset)
 	{
-		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
-		if (TResourceId::Invalid == gameLevelsCollectionHandle)
-		{
-			TDE2_ASSERT(false);
-			return false;
-		}
-
-		auto pLevelsCollection = pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
+		auto pLevelsCollection = CGameLevelsCatalog::Get().GetLevelsCollection(pResourceManager);
 		if (!pLevelsCollection)
 		{
 			TDE2_ASSERT(false);
@@ -206,13 +206,7 @@ namespace Game
 		TDEngine2::TPtr<TDEngine2::IResourceManager> pResourceManager,
 		TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager)
 	{
-		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
-		if (TResourceId::Invalid == gameLevelsCollectionHandle)
-		{
-			TDE2_ASSERT(false);
-		}
-
-		auto pLevelsCollection = pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
+		auto pLevelsCollection = CGameLevelsCatalog::Get().GetLevelsCollection(pResourceManager);
 		if (!pLevelsCollection)
 		{
 			TDE2_ASSERT(false);
@@ -298,24 +292,28 @@ namespace Game
 	{
 		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
 
-		const TResourceId gameLevelsCollectionHandle = pResourceManager->Load<CGameLevelsCollection>(GameLevelsCollectionPath);
-		if (TResourceId::Invalid == gameLevelsCollectionHandle)
+		auto pLevelsCollection = CGameLevelsCatalog::Get().GetLevelsCollection(pResourceManager);
+		if (!pLevelsCollection)
 		{
 			TDE2_ASSERT(false);
 			return;
 		}
 
-		auto pLevelsCollection = pResourceManager->GetResource<CGameLevelsCollection>(gameLevelsCollectionHandle);
-		if (!pLevelsCollection)
+		auto findLevelResult = pLevelsCollection->GetLevelPathByIndex(levelIndex);
+		if (findLevelResult.HasError())
 		{
 			TDE2_ASSERT(false);
 			return;
 		}
 
-		auto findLevelResult = pLevelsCollection->GetLevelPathByIndex(levelIndex);
-		if (findLevelResult.HasError())
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
+
+		/// \note Rewind the level in place if it wasn't changed since the first loading
+		if (pGameInfo && RC_OK == CGameLevelSnapshot::Get().Restore(pSceneManager, pGameInfo->mCurrLoadedGameId))
 		{
-			TDE2_ASSERT(false);
+			TGameLevelLoadedEvent gameLevelLoadedEvent;
+			pEventManager->Notify(&gameLevelLoadedEvent);
+
 			return;
 		}
 
@@ -332,28 +330,27 @@ namespace Game
 			TDE2_ASSERT(RC_OK == result);
 		}
 
-		if (CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>())
+		if (pGameInfo)
 		{
-			E_RESULT_CODE result = pSceneManager->UnloadScene(pGameInfo->mCurrLoadedGameId); /// \note Unload the previously loaded level
+			E_RESULT_CODE result = CSceneStreamer::Get().UnloadScene(pGameInfo->mCurrLoadedGameId); /// \note Unload the previously loaded level while the new one is loading
 			TDE2_ASSERT(RC_OK == result);
+
+			pGameInfo->mCurrLoadedGameId = TSceneId::Invalid;
 		}
 
 		/// \note Load a new one
-		pSceneManager->LoadSceneAsync(findLevelResult.Get(), [pSceneManager, pWorld, pEventManager, pGameModesManager](const TResult<TSceneId>& sceneId)
+		pSceneManager->LoadSceneAsync(findLevelResult.Get(), [pSceneManager, pEventManager, pGameModesManager](const TResult<TSceneId>& sceneId)
 		{
-			if (CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>())
-			{
-				pGameInfo->mCurrLoadedGameId = sceneId.Get();
-			}
+			OnGameLevelLoaded(pSceneManager, pEventManager, sceneId.Get());
 
-			TGameLevelLoadedEvent gameLevelLoadedEvent;
-			pEventManager->Notify(&gameLevelLoadedEvent);
-
-			/// \note Disable the loading screen 
+			/// \note Disable the loading screen when the previous level is torn down
 			if (pGameModesManager)
 			{
-				E_RESULT_CODE result = pGameModesManager->PopMode();
-				TDE2_ASSERT(RC_OK == result);
+				CSceneStreamer::Get().NotifyWhenIdle([pGameModesManager]
+				{
+					E_RESULT_CODE result = pGameModesManager->PopMode();
+					TDE2_ASSERT(RC_OK == result);
+				});
 			}
 		});
 	}
@@ -367,7 +364,7 @@ namespace Game
 	{
 		TPtr<IWorld> pWorld = pSceneManager->GetWorld();
 
-		CGameInfo* pGameInfo = pWorld->FindEntity(pWorld->FindEntityWithUniqueComponent<CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 		if (!pGameInfo)
 		{
 			TDE2_ASSERT(false);
@@ -406,6 +403,9 @@ namespace Game
 		pResourceManager->RegisterFactory(CreateGameLevelsCollectionFactory(pResourceManager.Get(), result));
 		pResourceManager->RegisterLoader(CreateGameLevelsCollectionLoader(pResourceManager.Get(), pFileSystem.Get(), result));
 
+		pResourceManager->RegisterFactory(CreatePowerUpsTableFactory(pResourceManager.Get(), result));
+		pResourceManager->RegisterLoader(CreatePowerUpsTableLoader(pResourceManager.Get(), pFileSystem.Get(), result));
+
 		return result;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "../../include/bench/CAllocatorsBenchmark.h"
+#include "../../include/CSceneArenas.h"
+#include "../../include/CTLSFAllocator.h"
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	typedef std::chrono::high_resolution_clock TBenchClock;
+
+
+	CAllocationTraceRecorder& CAllocationTraceRecorder::Get()
+	{
+		static CAllocationTraceRecorder instance;
+		return instance;
+	}
+
+	void CAllocationTraceRecorder::Start()
+	{
+		CSceneArenas::Get().SetAllocationsListener([this](const void* pPtr, USIZE size, bool isAllocation)
+		{
+			_onAllocationEvent(pPtr, size, isAllocation);
+		});
+	}
+
+	void CAllocationTraceRecorder::Stop()
+	{
+		CSceneArenas::Get().SetAllocationsListener(nullptr);
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		mLiveAllocations.clear();
+	}
+
+	const std::vector<TAllocationTraceEvent>& CAllocationTraceRecorder::GetEvents() const
+	{
+		return mEvents;
+	}
+
+	void CAllocationTraceRecorder::_onAllocationEvent(const void* pPtr, USIZE size, bool isAllocation)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		if (isAllocation)
+		{
+			mLiveAllocations[pPtr] = mAllocationsCount;
+			mEvents.push_back({ mAllocationsCount++, static_cast<U32>(size), true });
+
+			return;
+		}
+
+		auto it = mLiveAllocations.find(pPtr);
+		if (mLiveAllocations.cend() == it)
+		{
+			return;
+		}
+
+		mEvents.push_back({ it->second, 0, false });
+		mLiveAllocations.erase(it);
+	}
+
+
+	E_RESULT_CODE SaveAllocationTrace(const std::string& filePath, const std::vector<TAllocationTraceEvent>& events)
+	{
+		std::ofstream outputFile(filePath, std::ios::out | std::ios::trunc);
+		if (!outputFile.is_open())
+		{
+			return RC_FILE_NOT_FOUND;
+		}
+
+		for (const TAllocationTraceEvent& currEvent : events)
+		{
+			if (currEvent.mIsAllocation)
+			{
+				outputFile << "a " << currEvent.mAllocationIndex << " " << currEvent.mSize << "\n";
+				continue;
+			}
+
+			outputFile << "f " << currEvent.mAllocationIndex << "\n";
+		}
+
+		return outputFile.good() ? RC_OK : RC_FAIL;
+	}
+
+	TResult<std::vector<TAllocationTraceEvent>> LoadAllocationTrace(const std::string& filePath)
+	{
+		std::ifstream inputFile(filePath);
+		if (!inputFile.is_open())
+		{
+			return Wrench::TErrValue<E_RESULT_CODE>(RC_FILE_NOT_FOUND);
+		}
+
+		std::vector<TAllocationTraceEvent> events;
+
+		C8 eventType = 0;
+
+		while (inputFile >> eventType)
+		{
+			TAllocationTraceEvent currEvent { 0, 0, 'a' == eventType };
+
+			inputFile >> currEvent.mAllocationIndex;
+
+			if (currEvent.mIsAllocation)
+			{
+				inputFile >> currEvent.mSize;
+			}
+
+			if (inputFile.fail() || ('a' != eventType && 'f' != eventType))
+			{
+				return Wrench::TErrValue<E_RESULT_CODE>(RC_FAIL);
+			}
+
+			events.push_back(currEvent);
+		}
+
+		return Wrench::TOkValue<std::vector<TAllocationTraceEvent>>(events);
+	}
+
+
+	/*!
+		\brief The function replays events of the trace, only the replay itself is measured
+
+		\return A time in microseconds
+	*/
+
+	template <typename TAllocateFunctor, typename TDeallocateFunctor>
+	static F64 ReplayTrace(const std::vector<TAllocationTraceEvent>& events, std::vector<void*>& blocks, bool hasDeallocations,
+		const TAllocateFunctor& allocate, const TDeallocateFunctor& deallocate)
+	{
+		std::fill(blocks.begin(), blocks.end(), nullptr);
+
+		const auto startTime = TBenchClock::now();
+
+		for (const TAllocationTraceEvent& currEvent : events)
+		{
+			if (currEvent.mIsAllocation)
+			{
+				blocks[currEvent.mAllocationIndex] = allocate(currEvent.mAllocationIndex, currEvent.mSize);
+				continue;
+			}
+
+			if (hasDeallocations && blocks[currEvent.mAllocationIndex])
+			{
+				deallocate(currEvent.mAllocationIndex, blocks[currEvent.mAllocationIndex]);
+				blocks[currEvent.mAllocationIndex] = nullptr;
+			}
+		}
+
+		const F64 time = std::chrono::duration<F64, std::micro>(TBenchClock::now() - startTime).count();
+
+		for (USIZE i = 0; i < blocks.size() && hasDeallocations; i++)
+		{
+			if (blocks[i])
+			{
+				deallocate(static_cast<U32>(i), blocks[i]);
+			}
+		}
+
+		return time;
+	}
+
+
+	/*!
+		\brief The function returns a copy of the trace without malformed events, so the replay can index blocks by them.
+		An allocation is skipped if it's empty, its index is reused or greater than a number of events (indices are dense),
+		a deallocation is skipped if its block isn't alive
+	*/
+
+	static std::vector<TAllocationTraceEvent> ValidateTrace(const std::vector<TAllocationTraceEvent>& events)
+	{
+		enum class E_BLOCK_STATE : U8 { UNUSED, ALIVE, FREED };
+
+		std::vector<E_BLOCK_STATE> blocksStates;
+		std::vector<TAllocationTraceEvent> validEvents;
+
+		validEvents.reserve(events.size());
+
+		USIZE skippedAllocationsCount = 0;
+		USIZE skippedDeallocationsCount = 0;
+
+		for (const TAllocationTraceEvent& currEvent : events)
+		{
+			const USIZE index = static_cast<USIZE>(currEvent.mAllocationIndex);
+
+			if (currEvent.mIsAllocation)
+			{
+				if (!currEvent.mSize || index >= events.size() || (index < blocksStates.size() && E_BLOCK_STATE::UNUSED != blocksStates[index]))
+				{
+					++skippedAllocationsCount;
+					continue;
+				}
+
+				blocksStates.resize(std::max(blocksStates.size(), index + 1), E_BLOCK_STATE::UNUSED);
+				blocksStates[index] = E_BLOCK_STATE::ALIVE;
+
+				validEvents.push_back(currEvent);
+				continue;
+			}
+
+			if (index >= blocksStates.size() || E_BLOCK_STATE::ALIVE != blocksStates[index])
+			{
+				++skippedDeallocationsCount;
+				continue;
+			}
+
+			blocksStates[index] = E_BLOCK_STATE::FREED;
+			validEvents.push_back(currEvent);
+		}
+
+		if (skippedAllocationsCount || skippedDeallocationsCount)
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[RunAllocatorsBenchmark] The trace is malformed, {0} allocations and {1} deallocations are skipped",
+				skippedAllocationsCount, skippedDeallocationsCount));
+		}
+
+		return validEvents;
+	}
+
+
+	std::vector<TAllocatorBenchmarkResult> RunAllocatorsBenchmark(const std::vector<TAllocationTraceEvent>& traceEvents, U32 iterationsCount)
+	{
+		constexpr U8 Alignment = 16;
+		constexpr USIZE PageSize = 1 << 20;
+
+		const std::vector<TAllocationTraceEvent> events = ValidateTrace(traceEvents);
+
+		std::vector<U32> allocationsSizes;
+
+		for (const TAllocationTraceEvent& currEvent : events)
+		{
+			if (currEvent.mIsAllocation)
+			{
+				allocationsSizes.resize(std::max<USIZE>(allocationsSizes.size(), currEvent.mAllocationIndex + 1), 0);
+				allocationsSizes[currEvent.mAllocationIndex] = currEvent.mSize;
+			}
+		}
+
+		const USIZE allocationsCount = static_cast<USIZE>(std::count_if(events.cbegin(), events.cend(), [](const TAllocationTraceEvent& e) { return e.mIsAllocation; }));
+		const USIZE maxSize = allocationsSizes.empty() ? 0 : *std::max_element(allocationsSizes.cbegin(), allocationsSizes.cend());
+
+		std::vector<void*> blocks(allocationsSizes.size(), nullptr);
+		std::vector<TAllocatorBenchmarkResult> results;
+
+		if (events.empty() || !iterationsCount)
+		{
+			return results;
+		}
+
+		auto addResult = [&results, iterationsCount](const std::string& name, F64 totalTime, USIZE operationsCount, USIZE reservedMemorySize, bool hasDeallocations)
+		{
+			results.push_back({ name, totalTime, 1000.0 * totalTime / static_cast<F64>(std::max<USIZE>(1, operationsCount * iterationsCount)), reservedMemorySize, hasDeallocations });
+		};
+
+		E_RESULT_CODE result = RC_OK;
+
+		/// \note TLSF
+		if (IAllocator* pAllocator = CreateTLSFAllocator(PageSize, result))
+		{
+			F64 totalTime = 0.0;
+
+			for (U32 i = 0; i < iterationsCount; i++)
+			{
+				totalTime += ReplayTrace(events, blocks, true,
+					[pAllocator](U32, U32 size) { return pAllocator->Allocate(size, Alignment); },
+					[pAllocator](U32, void* pPtr) { pAllocator->Deallocate(pPtr); });
+			}
+
+			addResult("tlsf", totalTime, events.size(), pAllocator->GetTotalMemorySize(), true);
+			pAllocator->Free();
+		}
+
+		/// \note A pool per size class, it's the way CPoolMemoryAllocPolicy works
+		{
+			std::vector<IAllocator*> pools((maxSize + Alignment - 1) / Alignment + 1, nullptr);
+
+			for (U32 currSize : allocationsSizes)
+			{
+				IAllocator*& pPool = pools[(currSize + Alignment - 1) / Alignment];
+				if (!pPool && currSize)
+				{
+					const USIZE objectSize = (currSize + Alignment - 1) & ~static_cast<USIZE>(Alignment - 1);
+					pPool = CreatePoolAllocator(objectSize, Alignment, std::max<USIZE>(64 * 1024, 16 * objectSize), result);
+				}
+			}
+
+			F64 totalTime = 0.0;
+
+			for (U32 i = 0; i < iterationsCount; i++)
+			{
+				totalTime += ReplayTrace(events, blocks, true,
+					[&pools](U32, U32 size) { return pools[(size + Alignment - 1) / Alignment]->Allocate(size, Alignment); },
+					[&pools, &allocationsSizes](U32 index, void* pPtr) { pools[(allocationsSizes[index] + Alignment - 1) / Alignment]->Deallocate(pPtr); });
+			}
+
+			USIZE reservedMemorySize = 0;
+
+			for (IAllocator* pCurrPool : pools)
+			{
+				if (pCurrPool)
+				{
+					reservedMemorySize += pCurrPool->GetTotalMemorySize();
+					pCurrPool->Free();
+				}
+			}
+
+			addResult("pools", totalTime, events.size(), reservedMemorySize, true);
+		}
+
+		/// \note CBaseAllocator's implementations can't free separate blocks, so the linear one is a lower bound of allocation's cost
+		if (IAllocator* pAllocator = CreateLinearAllocator(std::max<USIZE>(PageSize, maxSize + Alignment), result))
+		{
+			F64 totalTime = 0.0;
+			USIZE reservedMemorySize = 0;
+
+			for (U32 i = 0; i < iterationsCount; i++)
+			{
+				totalTime += ReplayTrace(events, blocks, false,
+					[pAllocator](U32, U32 size) { return pAllocator->Allocate(size, Alignment); },
+					[](U32, void*) {});
+
+				reservedMemorySize = std::max(reservedMemorySize, pAllocator->GetTotalMemorySize());
+				pAllocator->Clear();
+			}
+
+			addResult("linear", totalTime, allocationsCount, reservedMemorySize, false);
+			pAllocator->Free();
+		}
+
+		/// \note malloc
+		{
+			F64 totalTime = 0.0;
+
+			for (U32 i = 0; i < iterationsCount; i++)
+			{
+				totalTime += ReplayTrace(events, blocks, true,
+					[](U32, U32 size) { return std::malloc(size); },
+					[](U32, void* pPtr) { std::free(pPtr); });
+			}
+
+			addResult("malloc", totalTime, events.size(), 0, true);
+		}
+
+		return results;
+	}
+}
\ No newline at end of file
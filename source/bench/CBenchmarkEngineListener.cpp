@@ -0,0 +1,372 @@
+#include "../../include/bench/CBenchmarkEngineListener.h"
+#include "../../include/bench/CProfiledSystem.h"
+#include "../../include/Components.h"
+#include "../../include/Utilities.h"
+#include "../../include/GameModes.h"
+#include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
+#include "../../include/CGameLevelsPrefetcher.h"
+#include "../../include/components/CBall.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+
+using namespace TDEngine2;
+using namespace Game;
+
+
+namespace Game
+{
+	TBenchmarkSettings GetBenchmarkSettingsFromProgramOptions()
+	{
+		auto pProgramOptions = CProgramOptions::Get();
+
+		TBenchmarkSettings settings;
+
+		settings.mLevelIndex        = static_cast<USIZE>(pProgramOptions->GetValueOrDefault<I32>("level", static_cast<I32>(settings.mLevelIndex)));
+		settings.mFramesCount       = static_cast<U32>(pProgramOptions->GetValueOrDefault<I32>("frames", static_cast<I32>(settings.mFramesCount)));
+		settings.mWarmupFramesCount = static_cast<U32>(pProgramOptions->GetValueOrDefault<I32>("warmup", static_cast<I32>(settings.mWarmupFramesCount)));
+		settings.mFixedDeltaTime    = pProgramOptions->GetValueOrDefault<F32>("dt", settings.mFixedDeltaTime);
+		settings.mOutputFilePath    = pProgramOptions->GetValueOrDefault<std::string>("output", settings.mOutputFilePath);
+		settings.mIsSequentialUpdate = 0 != pProgramOptions->GetValueOrDefault<I32>("sequential", static_cast<I32>(settings.mIsSequentialUpdate));
+		settings.mAllocationTraceFilePath = pProgramOptions->GetValueOrDefault<std::string>("alloc-trace", settings.mAllocationTraceFilePath);
+		settings.mAllocatorsIterations = static_cast<U32>(pProgramOptions->GetValueOrDefault<I32>("alloc-iterations", static_cast<I32>(settings.mAllocatorsIterations)));
+
+		return settings;
+	}
+
+
+	static F64 GetTimestampInMicroseconds()
+	{
+		return std::chrono::duration<F64, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+
+CBenchmarkEngineListener::CBenchmarkEngineListener(const TBenchmarkSettings& settings):
+	CCustomEngineListener(), mSettings(settings)
+{
+	mFrames.reserve(settings.mFramesCount);
+	mIsParallelSystemsUpdateEnabled = !settings.mIsSequentialUpdate;
+
+	/// \note Otherwise a number of fixed steps within a frame depends on the host's speed
+	mSystemsGroupsDeltaTime = settings.mFixedDeltaTime;
+}
+
+E_RESULT_CODE CBenchmarkEngineListener::OnStart()
+{
+	E_RESULT_CODE result = CCustomEngineListener::OnStart();
+	if (RC_OK != result)
+	{
+		return result;
+	}
+
+	/// \note Only a single level is measured, loading of the next one in the background would skew timings
+	result = CGameLevelsPrefetcher::Get().Free();
+	if (RC_OK != result)
+	{
+		return result;
+	}
+
+	if (mSettings.mAllocatorsIterations)
+	{
+		CAllocationTraceRecorder::Get().Start();
+	}
+
+	return mpEngineCoreInstance->GetSubsystem<IEventManager>()->Subscribe(TGameLevelLoadedEvent::GetTypeId(), this);
+}
+
+E_RESULT_CODE CBenchmarkEngineListener::OnUpdate(const float& dt)
+{
+	const F64 currTimestamp = GetTimestampInMicroseconds();
+	const F64 frameTime = (mPrevFrameTimestamp > 0.0) ? (currTimestamp - mPrevFrameTimestamp) : 0.0;
+
+	mPrevFrameTimestamp = currTimestamp;
+
+	if (!mIsLevelLoaded)
+	{
+		return RC_OK;
+	}
+
+	_launchIdleBalls();
+
+	if (mSkippedFramesCount < mSettings.mWarmupFramesCount)
+	{
+		++mSkippedFramesCount;
+
+		for (CProfiledSystem* pSystem : mProfiledSystems)
+		{
+			pSystem->ResetAccumulatedTime();
+		}
+
+		return RC_OK;
+	}
+
+	_recordFrame(dt);
+	mFrames.back().mFrameTime = frameTime;
+
+	if (mFrames.size() < mSettings.mFramesCount)
+	{
+		return RC_OK;
+	}
+
+	_runAllocatorsBenchmark();
+
+	E_RESULT_CODE result = _writeReport();
+	TDE2_ASSERT(RC_OK == result);
+
+	return mpEngineCoreInstance->Quit();
+}
+
+E_RESULT_CODE CBenchmarkEngineListener::OnFree()
+{
+	CAllocationTraceRecorder::Get().Stop();
+
+	mProfiledSystems.clear();
+	mProfiledSystemsGroups.clear();
+
+	return CCustomEngineListener::OnFree();
+}
+
+E_RESULT_CODE CBenchmarkEngineListener::OnEvent(const TBaseEvent* pEvent)
+{
+	if (dynamic_cast<const TGameLevelLoadedEvent*>(pEvent))
+	{
+		mIsLevelLoaded = true;
+		return RC_OK;
+	}
+
+	return CCustomEngineListener::OnEvent(pEvent);
+}
+
+ISystem* CBenchmarkEngineListener::_decorateGameSystem(ISystem* pSystem, const std::string& groupName)
+{
+	E_RESULT_CODE result = RC_OK;
+
+	ISystem* pProfiledSystem = CreateProfiledSystem(pSystem, mSettings.mFixedDeltaTime, result);
+	if (RC_OK != result || !pProfiledSystem)
+	{
+		TDE2_ASSERT(false);
+		return pSystem;
+	}
+
+	mProfiledSystems.push_back(dynamic_cast<CProfiledSystem*>(pProfiledSystem));
+	mProfiledSystemsGroups.push_back(groupName);
+
+	return pProfiledSystem;
+}
+
+void CBenchmarkEngineListener::_loadInitialLevel()
+{
+	auto pGameModesManager = mpEngineCoreInstance->GetSubsystem<IGameModesManager>();
+	auto pEventManager = mpEngineCoreInstance->GetSubsystem<IEventManager>();
+
+	E_RESULT_CODE result = RC_OK;
+	result = result | pGameModesManager->SwitchMode(TPtr<IGameMode>(CreateCoreGameMode(pGameModesManager.Get(),
+		{
+			mpInputContext,
+			mpSceneManager,
+			pEventManager,
+			mpResourceManager
+		}, result)));
+
+	TDE2_ASSERT(RC_OK == result);
+
+	LoadGameLevel(mpSceneManager, mpResourceManager, pEventManager, pGameModesManager, mSettings.mLevelIndex);
+}
+
+void CBenchmarkEngineListener::_launchIdleBalls()
+{
+	if (CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld))
+	{
+		pGameInfo->mIsGodModeEnabled = true; /// \note Keeps the workload stable, balls are never lost
+	}
+
+	for (TEntityId currBallEntityId : mpWorld->FindEntitiesWithComponents<CBall>())
+	{
+		CEntity* pBallEntity = mpWorld->FindEntity(currBallEntityId);
+		if (!pBallEntity)
+		{
+			continue;
+		}
+
+		CBall* pBall = pBallEntity->GetComponent<CBall>();
+		if (!pBall->mIsMoving)
+		{
+			pBall->mNeedUpdateDirection = true;
+		}
+	}
+}
+
+void CBenchmarkEngineListener::_recordFrame(F32 dt)
+{
+	TFrameRecord frame;
+	frame.mFrameTime = 0.0;
+	frame.mEngineDeltaTime = dt;
+	frame.mSystemsTimes.reserve(mProfiledSystems.size());
+	frame.mSystemsUpdatesCounts.reserve(mProfiledSystems.size());
+
+	for (CProfiledSystem* pSystem : mProfiledSystems)
+	{
+		frame.mSystemsTimes.push_back(pSystem->GetAccumulatedTime());
+		frame.mSystemsUpdatesCounts.push_back(pSystem->GetUpdatesCount());
+		pSystem->ResetAccumulatedTime();
+	}
+
+	mFrames.emplace_back(std::move(frame));
+}
+
+void CBenchmarkEngineListener::_runAllocatorsBenchmark()
+{
+	if (!mSettings.mAllocatorsIterations)
+	{
+		return;
+	}
+
+	CAllocationTraceRecorder& recorder = CAllocationTraceRecorder::Get();
+	recorder.Stop();
+
+	std::vector<TAllocationTraceEvent> events = recorder.GetEvents();
+
+	if (!mSettings.mAllocationTraceFilePath.empty())
+	{
+		auto loadTraceResult = LoadAllocationTrace(mSettings.mAllocationTraceFilePath);
+		if (loadTraceResult.IsOk())
+		{
+			events = loadTraceResult.Get();
+		}
+		else if (RC_OK != SaveAllocationTrace(mSettings.mAllocationTraceFilePath, events))
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CBenchmarkEngineListener] Couldn't save the allocation trace into {0}", mSettings.mAllocationTraceFilePath));
+		}
+	}
+
+	mAllocationTraceEventsCount = events.size();
+	mAllocatorsResults = RunAllocatorsBenchmark(events, mSettings.mAllocatorsIterations);
+}
+
+bool CBenchmarkEngineListener::_hasValidSimulationTimings() const
+{
+	static const std::string SimulationGroupName = "SimulationSystemsGroup";
+
+	bool isValid = true;
+
+	for (USIZE i = 0; i < mProfiledSystems.size(); i++)
+	{
+		if (SimulationGroupName != mProfiledSystemsGroups[i])
+		{
+			continue;
+		}
+
+		F64 totalTime = 0.0;
+		USIZE invalidFramesCount = 0;
+
+		for (auto&& currFrame : mFrames)
+		{
+			totalTime += currFrame.mSystemsTimes[i];
+			invalidFramesCount += (1 != currFrame.mSystemsUpdatesCounts[i]) ? 1 : 0;
+		}
+
+		if (invalidFramesCount || (!mFrames.empty() && totalTime <= 0.0))
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CBenchmarkEngineListener] {0} wasn't updated once per frame within {1} frames, its total time is {2} us",
+				mProfiledSystems[i]->GetName(), invalidFramesCount, totalTime));
+
+			isValid = false;
+		}
+	}
+
+	return isValid;
+}
+
+E_RESULT_CODE CBenchmarkEngineListener::_writeReport() const
+{
+	std::ofstream outputFile;
+
+	if (!mSettings.mOutputFilePath.empty())
+	{
+		outputFile.open(mSettings.mOutputFilePath, std::ios::out | std::ios::trunc);
+		if (!outputFile.is_open())
+		{
+			LOG_ERROR(Wrench::StringUtils::Format("[CBenchmarkEngineListener] Couldn't open file {0}", mSettings.mOutputFilePath));
+			return RC_FILE_NOT_FOUND;
+		}
+	}
+
+	std::ostream& stream = outputFile.is_open() ? outputFile : std::cout;
+
+	stream << "{\n";
+	stream << "\t\"level_index\": " << mSettings.mLevelIndex << ",\n";
+	stream << "\t\"fixed_dt\": " << mSettings.mFixedDeltaTime << ",\n";
+	stream << "\t\"sequential_update\": " << (mSettings.mIsSequentialUpdate ? "true" : "false") << ",\n";
+	stream << "\t\"frames_count\": " << mFrames.size() << ",\n";
+	stream << "\t\"simulation_timings_valid\": " << (_hasValidSimulationTimings() ? "true" : "false") << ",\n";
+
+	/// \note Per-system summary
+	stream << "\t\"systems\": [\n";
+
+	for (USIZE i = 0; i < mProfiledSystems.size(); i++)
+	{
+		F64 totalTime = 0.0;
+		F64 maxTime = 0.0;
+
+		for (auto&& currFrame : mFrames)
+		{
+			totalTime += currFrame.mSystemsTimes[i];
+			maxTime = std::max(maxTime, currFrame.mSystemsTimes[i]);
+		}
+
+		stream << "\t\t{ \"name\": \"" << mProfiledSystems[i]->GetName() << "\", "
+			<< "\"group\": \"" << mProfiledSystemsGroups[i] << "\", "
+			<< "\"total_us\": " << totalTime << ", "
+			<< "\"avg_us\": " << (mFrames.empty() ? 0.0 : totalTime / mFrames.size()) << ", "
+			<< "\"max_us\": " << maxTime << " }"
+			<< ((i + 1 < mProfiledSystems.size()) ? ",\n" : "\n");
+	}
+
+	stream << "\t],\n";
+
+	/// \note Per-frame timings, systems' values are written in the same order as in the summary above
+	stream << "\t\"frames\": [\n";
+
+	for (USIZE i = 0; i < mFrames.size(); i++)
+	{
+		auto&& currFrame = mFrames[i];
+
+		stream << "\t\t{ \"frame\": " << i << ", \"engine_dt\": " << currFrame.mEngineDeltaTime << ", \"frame_us\": " << currFrame.mFrameTime << ", \"systems_us\": [";
+
+		for (USIZE j = 0; j < currFrame.mSystemsTimes.size(); j++)
+		{
+			stream << currFrame.mSystemsTimes[j] << ((j + 1 < currFrame.mSystemsTimes.size()) ? ", " : "");
+		}
+
+		stream << "] }" << ((i + 1 < mFrames.size()) ? ",\n" : "\n");
+	}
+
+	stream << "\t],\n";
+
+	/// \note Replays of components' allocation trace
+	stream << "\t\"allocation_trace_events\": " << mAllocationTraceEventsCount << ",\n";
+	stream << "\t\"allocators\": [\n";
+
+	for (USIZE i = 0; i < mAllocatorsResults.size(); i++)
+	{
+		auto&& currResult = mAllocatorsResults[i];
+
+		stream << "\t\t{ \"name\": \"" << currResult.mName << "\", "
+			<< "\"total_us\": " << currResult.mTotalTime << ", "
+			<< "\"avg_op_ns\": " << currResult.mAvgOperationTime << ", "
+			<< "\"reserved_bytes\": " << currResult.mReservedMemorySize << ", "
+			<< "\"has_deallocations\": " << (currResult.mHasDeallocations ? "true" : "false") << " }"
+			<< ((i + 1 < mAllocatorsResults.size()) ? ",\n" : "\n");
+	}
+
+	stream << "\t]\n";
+	stream << "}\n";
+
+	stream.flush();
+
+	return RC_OK;
+}
\ No newline at end of file
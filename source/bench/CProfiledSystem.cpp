@@ -0,0 +1,132 @@
+#include "../../include/bench/CProfiledSystem.h"
+#include <chrono>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	typedef std::chrono::high_resolution_clock TBenchClock;
+
+
+	CProfiledSystem::CProfiledSystem() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CProfiledSystem::Init(ISystem* pSystem, F32 fixedDeltaTime)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pSystem)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpSystem = TPtr<ISystem>(pSystem);
+		mFixedDeltaTime = fixedDeltaTime;
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	void CProfiledSystem::InjectBindings(IWorld* pWorld)
+	{
+		mpSystem->InjectBindings(pWorld);
+	}
+
+	E_RESULT_CODE CProfiledSystem::AddDefferedCommand(const TCommandFunctor& action)
+	{
+		return mpSystem->AddDefferedCommand(action);
+	}
+
+	void CProfiledSystem::ExecuteDefferedCommands()
+	{
+		const auto startTime = TBenchClock::now();
+
+		mpSystem->ExecuteDefferedCommands();
+
+		mAccumulatedTime += std::chrono::duration<F64, std::micro>(TBenchClock::now() - startTime).count();
+	}
+
+	void CProfiledSystem::OnInit(TPtr<IJobManager> pJobManager)
+	{
+		mpSystem->OnInit(pJobManager);
+	}
+
+	void CProfiledSystem::Update(IWorld* pWorld, F32 dt)
+	{
+		const auto startTime = TBenchClock::now();
+
+		mpSystem->Update(pWorld, (mFixedDeltaTime > 0.0f) ? mFixedDeltaTime * pWorld->GetTimeScaleFactor() : dt);
+
+		mAccumulatedTime += std::chrono::duration<F64, std::micro>(TBenchClock::now() - startTime).count();
+		++mUpdatesCount;
+	}
+
+#if TDE2_EDITORS_ENABLED
+
+	void CProfiledSystem::DebugOutput(IDebugUtility* pDebugUtility, F32 dt) const
+	{
+		mpSystem->DebugOutput(pDebugUtility, dt);
+	}
+
+#endif
+
+	void CProfiledSystem::OnDestroy()
+	{
+		mpSystem->OnDestroy();
+	}
+
+	void CProfiledSystem::OnActivated()
+	{
+		mpSystem->OnActivated();
+	}
+
+	void CProfiledSystem::OnDeactivated()
+	{
+		mpSystem->OnDeactivated();
+	}
+
+	bool CProfiledSystem::IsActive() const
+	{
+		return mpSystem->IsActive();
+	}
+
+	const std::string& CProfiledSystem::GetName() const
+	{
+		return mpSystem->GetName();
+	}
+
+	TypeId CProfiledSystem::GetSystemType() const
+	{
+		return mpSystem->GetSystemType();
+	}
+
+	F64 CProfiledSystem::GetAccumulatedTime() const
+	{
+		return mAccumulatedTime;
+	}
+
+	U32 CProfiledSystem::GetUpdatesCount() const
+	{
+		return mUpdatesCount;
+	}
+
+	void CProfiledSystem::ResetAccumulatedTime()
+	{
+		mAccumulatedTime = 0.0;
+		mUpdatesCount = 0;
+	}
+
+
+	TDE2_API ISystem* CreateProfiledSystem(ISystem* pSystem, F32 fixedDeltaTime, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(ISystem, CProfiledSystem, result, pSystem, fixedDeltaTime);
+	}
+}
\ No newline at end of file
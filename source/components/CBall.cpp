@@ -20,6 +20,8 @@ namespace Game
 			return RC_FAIL;
 		}
 
+		mSpeed = pReader->GetFloat("speed", mSpeed);
+		mRadius = pReader->GetFloat("radius", mRadius);
 
 		return RC_OK;
 	}
@@ -35,6 +37,7 @@ namespace Game
 		{
 			pWriter->SetUInt32("type_id", static_cast<U32>(CBall::GetTypeId()));
 			pWriter->SetFloat("speed", mSpeed);
+			pWriter->SetFloat("radius", mRadius);
 
 		}
 		pWriter->EndGroup();
@@ -49,6 +52,7 @@ namespace Game
 			pComponent->mDirection = mDirection;
 			pComponent->mIsMoving = mIsMoving;
 			pComponent->mSpeed = mSpeed;
+			pComponent->mRadius = mRadius;
 
 			return RC_OK;
 		}
@@ -74,6 +78,16 @@ namespace Game
 				imguiContext.FloatField("##Speed", speed, [&component, &speed]() { component.mSpeed = speed; });
 				imguiContext.EndHorizontal();
 			}
+
+			/// \note Radius of the Ball
+			{
+				F32 radius = component.mRadius;
+
+				imguiContext.BeginHorizontal();
+				imguiContext.Label("Radius:");
+				imguiContext.FloatField("##Radius", radius, [&component, &radius]() { component.mRadius = radius; });
+				imguiContext.EndHorizontal();
+			}
 		});
 	}
 
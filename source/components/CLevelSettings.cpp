@@ -48,6 +48,25 @@ namespace Game
 
 		pReader->EndGroup();
 
+		mPoolsSettings.clear();
+
+		pReader->BeginGroup("pools");
+		{
+			while (pReader->HasNextItem())
+			{
+				pReader->BeginGroup(Wrench::StringUtils::GetEmptyStr());
+				{
+					TPrefabPoolSettings poolSettings;
+					poolSettings.mPrefabId = pReader->GetString("prefab_id");
+					poolSettings.mSize = pReader->GetUInt32("size");
+
+					mPoolsSettings.emplace_back(poolSettings);
+				}
+				pReader->EndGroup();
+			}
+		}
+		pReader->EndGroup();
+
 		return RC_OK;
 	}
 
@@ -69,6 +88,20 @@ namespace Game
 			pWriter->BeginGroup("vertical_constraints"); 
 			SaveVector2(pWriter, TVector2(mVerticalConstraints.mLeft, mVerticalConstraints.mRight));
 			pWriter->EndGroup();
+
+			pWriter->BeginGroup("pools", true);
+			{
+				for (const TPrefabPoolSettings& currPoolSettings : mPoolsSettings)
+				{
+					pWriter->BeginGroup(Wrench::StringUtils::GetEmptyStr());
+					{
+						pWriter->SetString("prefab_id", currPoolSettings.mPrefabId);
+						pWriter->SetUInt32("size", currPoolSettings.mSize);
+					}
+					pWriter->EndGroup();
+				}
+			}
+			pWriter->EndGroup();
 		}
 		pWriter->EndGroup();
 
@@ -81,6 +114,7 @@ namespace Game
 		{
 			pComponent->mHorizontalConstraints = mHorizontalConstraints;
 			pComponent->mVerticalConstraints = mVerticalConstraints;
+			pComponent->mPoolsSettings = mPoolsSettings;
 
 			return RC_OK;
 		}
@@ -122,6 +156,22 @@ namespace Game
 				});
 				imguiContext.EndHorizontal();
 			}
+
+			/// \note Sizes of entities pools
+			for (USIZE i = 0; i < component.mPoolsSettings.size(); i++)
+			{
+				TPrefabPoolSettings& currPoolSettings = component.mPoolsSettings[i];
+
+				I32 size = static_cast<I32>(currPoolSettings.mSize);
+
+				imguiContext.BeginHorizontal();
+				imguiContext.Label(Wrench::StringUtils::Format("Pool \"{0}\":", currPoolSettings.mPrefabId));
+				imguiContext.IntField(Wrench::StringUtils::Format("##PoolSize{0}", i), size, [&currPoolSettings, &size]()
+				{
+					currPoolSettings.mSize = static_cast<U32>(std::max<I32>(0, size));
+				});
+				imguiContext.EndHorizontal();
+			}
 		});
 	}
 
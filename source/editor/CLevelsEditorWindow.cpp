@@ -1,6 +1,9 @@
 #include "../../include/editor/CLevelsEditorWindow.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
 #include "../../include/Utilities.h"
+#include "../../include/CFrameArena.h"
+#include "../../include/CAllocationProfiler.h"
 #include <core/IImGUIContext.h>
 #include <scene/ISceneManager.h>
 #include <scene/IScene.h>
@@ -25,6 +28,9 @@ namespace Game
 	};
 
 
+	static const std::string AllocationsFlameGraphFilePath = "Allocations.folded";
+
+
 	class CLevelsListWindow
 	{
 		public:
@@ -64,8 +70,7 @@ namespace Game
 						LoadPrevGameLevel(mpSceneManager, mpResourceManager, mpEventManager, nullptr);
 					}
 
-					auto pGameInfoEntity = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<CGameInfo>());
-					auto sceneResult = mpSceneManager->GetScene(pGameInfoEntity->GetComponent<CGameInfo>()->mCurrLoadedGameId);
+					auto sceneResult = mpSceneManager->GetScene(GetSingleton<CGameInfo>(mpWorld)->mCurrLoadedGameId);
 
 					if (sceneResult.IsOk())
 					{
@@ -95,6 +100,28 @@ namespace Game
 						SaveCurrentGameLevel(mpSceneManager, mpResourceManager);
 					}
 
+					const CFrameArena& frameArena = CFrameArena::Get();
+
+					pImGUIContext->Label(Wrench::StringUtils::Format("Frame arena: {0} / {1} bytes, peak: {2} bytes, overflows: {3}",
+						frameArena.GetLastFrameUsedSize(), frameArena.GetCapacity(), frameArena.GetPeakUsedSize(), frameArena.GetLastFrameOverflowsCount()));
+
+					CAllocationProfiler& allocationProfiler = CAllocationProfiler::Get();
+
+					if (allocationProfiler.IsEnabled())
+					{
+						for (auto&& currAllocatorStatistics : allocationProfiler.GetAllocatorsStatistics())
+						{
+							pImGUIContext->Label(Wrench::StringUtils::Format("{0}: live ~{1} bytes, ~{2} bytes/s",
+								currAllocatorStatistics.mName, currAllocatorStatistics.mLiveSize, static_cast<U64>(currAllocatorStatistics.mAllocationRate)));
+						}
+
+						if (pImGUIContext->Button("Dump allocations flame graph", TVector2(pImGUIContext->GetWindowWidth(), 25.f)))
+						{
+							E_RESULT_CODE result = allocationProfiler.DumpFlameGraph(AllocationsFlameGraphFilePath);
+							TDE2_ASSERT(RC_OK == result);
+						}
+					}
+
 					/// \note Open game items' palette
 					if (mpInputContext->IsKeyPressed(TActionKeyBindings::mLoadPaletteLevel))
 					{
@@ -1,6 +1,9 @@
 #include "../../include/systems/BonusCollectSystems.h"
 #include "../../include/Components.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
+#include "../../include/CComponentsQueries.h"
+#include "../../include/CEventChannels.h"
 #include "../../include/components/CPaddle.h"
 #include "../../include/components/CBall.h"
 
@@ -21,7 +24,7 @@ namespace Game
 
 	void CAddScoreBonusCollectSystem::_onApplyCollectable(const CScoreBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -32,13 +35,18 @@ namespace Game
 		TScoreChangedEvent scoreChangedEvent;
 		scoreChangedEvent.mNewPlayerScore = pGameInfo->mPlayerScore;
 
-		mpEventManager->Notify(&scoreChangedEvent);
+		PostEvent(scoreChangedEvent);
+	}
+
+	void CAddScoreBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CGameInfo>();
 	}
 
 
-	TDE2_API ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateAddScoreBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CAddScoreBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CAddScoreBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -53,7 +61,7 @@ namespace Game
 
 	void CScoreMultiplierBonusCollectSystem::_onApplyCollectable(const CScoreMultiplierBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -69,7 +77,7 @@ namespace Game
 	{
 		CCollectingSystem::_onCollectableEffectFinished();
 
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -78,10 +86,15 @@ namespace Game
 		pGameInfo->mScoreMultiplier = 1;
 	}
 
+	void CScoreMultiplierBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CGameInfo>();
+	}
+
 
-	TDE2_API ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateScoreMultiplierBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CScoreMultiplierBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CScoreMultiplierBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -96,7 +109,7 @@ namespace Game
 
 	void CGodModeBonusCollectSystem::_onApplyCollectable(const CGodModeBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -112,7 +125,7 @@ namespace Game
 	{
 		CCollectingSystem::_onCollectableEffectFinished();
 
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -121,10 +134,15 @@ namespace Game
 		pGameInfo->mIsGodModeEnabled = false;
 	}
 
+	void CGodModeBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CGameInfo>();
+	}
+
 
-	TDE2_API ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateGodModeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CGodModeBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CGodModeBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -153,6 +171,8 @@ namespace Game
 			scale.x *= paddleScale;
 
 			pTransform->SetScale(scale);
+
+			MarkComponentChanged<CTransform>(currEntityId);
 		}
 	}
 
@@ -173,10 +193,15 @@ namespace Game
 		ApplyScaleForPaddles(mpWorld, 1.0f / mPrevScale);
 	}
 
+	void CExpandPaddleBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CTransform>();
+	}
+
 
-	TDE2_API ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateExpandPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CExpandPaddleBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CExpandPaddleBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -206,10 +231,15 @@ namespace Game
 		}
 	}
 
+	void CStickyPaddleBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CPaddle>();
+	}
+
 
-	TDE2_API ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateStickyPaddleBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CStickyPaddleBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CStickyPaddleBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -224,7 +254,7 @@ namespace Game
 
 	void CExtraLifeBonusCollectSystem::_onApplyCollectable(const CExtraLifeBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -233,10 +263,15 @@ namespace Game
 		pGameInfo->mPlayerLives++;
 	}
 
+	void CExtraLifeBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CGameInfo>();
+	}
+
 
-	TDE2_API ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateExtraLifeBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CExtraLifeBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CExtraLifeBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -251,7 +286,7 @@ namespace Game
 
 	void CLaserBonusCollectSystem::_onApplyCollectable(const CLaserBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -267,7 +302,7 @@ namespace Game
 	{
 		CCollectingSystem::_onCollectableEffectFinished();
 
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 		if (!pGameInfo)
 		{
 			return;
@@ -276,10 +311,15 @@ namespace Game
 		pGameInfo->mIsLaserEnabled = false;
 	}
 
+	void CLaserBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		accessInfo.Writes<CGameInfo>();
+	}
+
 
-	TDE2_API ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateLaserBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CLaserBonusCollectSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CLaserBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 
 
@@ -294,29 +334,10 @@ namespace Game
 
 	void CMultipleBallsBonusCollectSystem::_onApplyCollectable(const CMultipleBallsBonus* pCollectable)
 	{
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
-		if (!pGameInfo)
-		{
-			return;
-		}
-
-		auto sceneResult = mpSceneManager->GetScene(pGameInfo->mCurrLoadedGameId);
-		if (sceneResult.HasError())
-		{
-			TDE2_ASSERT(false);
-			return;
-		}
-
-		IScene* pScene = sceneResult.Get();
-		if (!pScene)
-		{
-			TDE2_ASSERT(false);
-			return;
-		}
-
 		const U32 ballsCount = pCollectable->mBallsCount;
 
-		/// \note Instantiate new balls 
+		std::vector<TVector3> positions;
+
 		for (TEntityId currBallEntityId : mpWorld->FindEntitiesWithComponents<CBall>())
 		{
 			CEntity* pEntity = mpWorld->FindEntity(currBallEntityId);
@@ -325,29 +346,37 @@ namespace Game
 				continue;
 			}
 
-			CTransform* pBallTransform = pEntity->GetComponent<CTransform>();
-			const TVector3& ballPosition = pBallTransform->GetPosition();
+			positions.insert(positions.end(), ballsCount, pEntity->GetComponent<CTransform>()->GetPosition());
+		}
 
-			for (U32 i = 0; i < ballsCount; i++)
-			{
-				CEntity* pNewBallEntity = pScene->Spawn("Ball"); /// \todo Replace constant with configurable identifier
-				if (!pNewBallEntity)
-				{
-					continue;
-				}
+		/// \note Instantiate all new balls at once
+		std::vector<CEntity*> newBalls;
 
-				CTransform* pNewBallTransform = pNewBallEntity->GetComponent<CTransform>();
-				pNewBallTransform->SetPosition(ballPosition);
+		E_RESULT_CODE result = mpEntitiesPool->AcquireBatch("Ball", static_cast<U32>(positions.size()), positions, newBalls); /// \todo Replace constant with configurable identifier
+		TDE2_ASSERT(RC_OK == result);
 
-				CBall* pNewBall = pNewBallEntity->GetComponent<CBall>();
-				pNewBall->mNeedUpdateDirection = true;
-			}
+		for (CEntity* pNewBallEntity : newBalls)
+		{
+			/// \note A pooled ball keeps the state it had when it was released
+			CBall* pNewBall = pNewBallEntity->GetComponent<CBall>();
+			pNewBall->mIsMoving = false;
+			pNewBall->mIsStuck = false;
+			pNewBall->mNeedUpdateDirection = true;
 		}
 	}
 
+	void CMultipleBallsBonusCollectSystem::_appendEffectAccessInfo(TSystemAccessInfo& accessInfo) const
+	{
+		/// \note New balls are acquired from the pool right away
+		accessInfo
+			.Writes<CTransform>()
+			.Writes<CBall>()
+			.Writes<CEntitiesPool>();
+	}
+
 
-	TDE2_API ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateMultipleBallsBonusCollectSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntitiesPool> pEntitiesPool, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CMultipleBallsBonusCollectSystem, result, pEventManager, pSceneManager);
+		return CREATE_IMPL(ISystem, CMultipleBallsBonusCollectSystem, result, pEventManager, pCollisionsRouter, pEntitiesPool, pCommandBuffer);
 	}
 }
\ No newline at end of file
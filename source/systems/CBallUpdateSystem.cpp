@@ -1,8 +1,11 @@
 #include "../../include/systems/CBallUpdateSystem.h"
 #include "../../include/Components.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
+#include "../../include/CEventChannels.h"
 #include "../../include/components/CBall.h"
 #include "../../include/components/CPaddle.h"
+#include "../../include/components/CDamageable.h"
 
 
 using namespace TDEngine2;
@@ -10,25 +13,40 @@ using namespace TDEngine2;
 
 namespace Game
 {
+	static constexpr F32 CollisionGridCellSize = 2.0f;
+	static constexpr U32 InvalidObstacleIndex = (std::numeric_limits<U32>::max)();
+	static constexpr F32 ContactOffset = 1e-3f; ///< A ball is placed slightly outside of an obstacle after the contact
+	static constexpr U32 MaxContactsPerStep = 4;
+
+	static constexpr USIZE ObstacleMinColumn = 0;
+	static constexpr USIZE ObstacleMaxColumn = 1;
+	static constexpr USIZE ObstacleLifesColumn = 2;
+	static constexpr USIZE ObstacleEntityColumn = 3;
+	static constexpr USIZE ObstacleHandleColumn = 4;
+
+
 	CBallUpdateSystem::CBallUpdateSystem() :
 		CBaseSystem()
 	{
 	}
 
-	E_RESULT_CODE CBallUpdateSystem::Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext)
+	E_RESULT_CODE CBallUpdateSystem::Init(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext,
+		TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pEventManager || !pInputContext)
+		if (!pEventManager || !pInputContext || !pCommandBuffer)
 		{
 			return RC_INVALID_ARGS;
 		}
 
 		mpEventManager = pEventManager;
 		mpInputContext = pInputContext;
+		mpCommandBuffer = pCommandBuffer;
+		mCommandStreamId = pCommandBuffer->CreateStream();
 
 		mIsInitialized = true;
 
@@ -37,39 +55,39 @@ namespace Game
 
 	void CBallUpdateSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<Game::CBall, TDEngine2::CTransform>();
-		mGameInfoEntityId = pWorld->FindEntityWithUniqueComponent<Game::CGameInfo>();
+		mpSystemContext = GetComponentsQuery<Game::CBall, TDEngine2::CTransform>(pWorld);
+		mpObstaclesContext = GetComponentsQuery<Game::CDamageable, TDEngine2::CTransform>(pWorld);
+
+		mObstaclesMirror.Bind(mpObstaclesContext);
 	}
 
 	void CBallUpdateSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& transforms = std::get<std::vector<CTransform*>>(mSystemContext.mComponentsSlice);
-		auto& balls = std::get<std::vector<CBall*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
 
-		CGameInfo* pGameInfo = pWorld->FindEntity(mGameInfoEntityId)->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; ++i)
+		_updateCollisionGrid();
+
+		for (USIZE i = 0; i < systemContext.mComponentsCount; ++i)
 		{
-			CTransform* pCurrTransform = transforms[i];
-			CBall* pCurrBall = balls[i];
+			CTransform* pCurrTransform = mpSystemContext->GetMutable<CTransform>(i);
+			CBall* pCurrBall = mpSystemContext->GetMutable<CBall>(i);
 
 			if (!pCurrBall->mIsMoving && (mpInputContext->IsKeyPressed(E_KEYCODES::KC_SPACE) && pGameInfo->mPlayerLives > 0 || pCurrBall->mNeedUpdateDirection))
 			{
-				AddDefferedCommand([pWorld, pCurrTransform, pCurrBall]
+				if (TEntityId::Invalid != pCurrTransform->GetParent())
 				{
-					if (TEntityId::Invalid != pCurrTransform->GetParent())
-					{
-						TDEngine2::GroupEntities(pWorld, TEntityId::Invalid, pCurrTransform->GetOwnerId());
-					}
+					mpCommandBuffer->Reparent(mCommandStreamId, TEntityId::Invalid, pCurrTransform->GetOwnerId());
+				}
 
-					/// \todo Add RandVector2
+				/// \todo Add RandVector2
 
-					pCurrBall->mDirection = RandVector3(TVector3(-1.0f, 0.0f, 1.0f), TVector3(1.0f, 0.0f, 1.0f));
-					pCurrBall->mDirection.y = 0.0f;
-					pCurrBall->mDirection = Normalize(pCurrBall->mDirection);
+				pCurrBall->mDirection = RandVector3(TVector3(-1.0f, 0.0f, 1.0f), TVector3(1.0f, 0.0f, 1.0f));
+				pCurrBall->mDirection.y = 0.0f;
+				pCurrBall->mDirection = Normalize(pCurrBall->mDirection);
 
-					pCurrBall->mNeedUpdateDirection = false;
-				});
+				pCurrBall->mNeedUpdateDirection = false;
 
 				pCurrBall->mIsMoving = true;
 				pCurrBall->mIsStuck = false;
@@ -85,7 +103,12 @@ namespace Game
 				continue;
 			}
 
-			pCurrTransform->SetPosition(pCurrTransform->GetPosition() + (pCurrBall->mSpeed * dt) * pCurrBall->mDirection);
+			_moveBall(pCurrTransform, pCurrBall, dt);
+
+			if (!pCurrBall->mIsMoving) /// \note The ball has been stuck to the paddle
+			{
+				continue;
+			}
 
 			/// \note Process bounces
 			{
@@ -109,24 +132,23 @@ namespace Game
 						TLivesChangedEvent livesChangedEvent;
 						livesChangedEvent.mPlayerLives = pGameInfo->mPlayerLives;
 
-						mpEventManager->Notify(&livesChangedEvent);
+						PostEvent(livesChangedEvent);
 					}
 
+					pCurrBall->mIsMoving = false;
+
 					/// \note Remove the extra ball if there is another one
-					if (mSystemContext.mComponentsCount >= 2)
+					if (systemContext.mComponentsCount >= 2)
 					{
-						AddDefferedCommand([pWorld, pCurrTransform]
-						{
-							pWorld->Destroy(pCurrTransform->GetOwnerId());
-						});
-					}
+						mpCommandBuffer->Destroy(mCommandStreamId, pCurrTransform->GetOwnerId());
 
-					pCurrBall->mIsMoving = false;
+						continue;
+					}
 
 					auto paddles = pWorld->FindEntitiesWithComponents<Game::CPaddle>();
 					if (!paddles.empty())
 					{
-						TDEngine2::GroupEntities(pWorld, paddles.front(), pCurrTransform->GetOwnerId());
+						mpCommandBuffer->Reparent(mCommandStreamId, paddles.front(), pCurrTransform->GetOwnerId());
 						continue;
 					}
 				}
@@ -142,9 +164,191 @@ namespace Game
 		}
 	}
 
+	/*!
+		\brief Bricks and the paddle use Cube mesh, so the sizes of their boxes are defined by the scale
+	*/
+
+	static void GetObstacleBounds(const CTransform* pTransform, TVector2& min, TVector2& max)
+	{
+		const TVector3& position = pTransform->GetPosition();
+		const TVector3 halfSizes = 0.5f * pTransform->GetScale();
+
+		min = TVector2(position.x - halfSizes.x, position.z - halfSizes.z);
+		max = TVector2(position.x + halfSizes.x, position.z + halfSizes.z);
+	}
+
+
+	void CBallUpdateSystem::_updateCollisionGrid()
+	{
+		const auto& obstaclesContext = mpObstaclesContext->GetSlice();
+
+		auto& transforms = std::get<std::vector<CTransform*>>(obstaclesContext.mComponentsSlice);
+		auto& damageables = std::get<std::vector<CDamageable*>>(obstaclesContext.mComponentsSlice);
+
+		mChangedObstacles.clear();
+
+		/// \note Most of the obstacles are static bricks, so the grid is rebuilt only when some of them has appeared or gone
+		bool needsRebuild = mObstaclesMirror.Sync([&](USIZE index, TVector2& min, TVector2& max, U32& lifes, TEntityId& entityId, TEntityHandle& entityHandle)
+		{
+			GetObstacleBounds(transforms[index], min, max);
+
+			lifes = damageables[index]->mLifes;
+			entityId = transforms[index]->GetOwnerId();
+
+			/// \note The system is exclusive, so it's updated on the thread which owns CEntityHandlesTable
+			entityHandle = CEntityHandlesTable::Get().Resolve(entityId);
+
+			mChangedObstacles.push_back(index);
+		});
+
+		const TObstaclesMirror::TStore& obstacles = mObstaclesMirror.GetStore();
+
+		if (!needsRebuild)
+		{
+			for (const USIZE currIndex : mChangedObstacles)
+			{
+				U32& obstacleIndex = mObstaclesIndices[currIndex];
+
+				if (!obstacles.Get<ObstacleLifesColumn>(currIndex))
+				{
+					if (InvalidObstacleIndex != obstacleIndex)
+					{
+						mCollisionGrid.DisableObstacle(obstacleIndex);
+						obstacleIndex = InvalidObstacleIndex;
+					}
+
+					continue;
+				}
+
+				/// \note A disabled obstacle has got its lifes back, e.g. after the level's restart
+				if (InvalidObstacleIndex == obstacleIndex)
+				{
+					needsRebuild = true;
+					break;
+				}
+
+				mCollisionGrid.UpdateObstacle(obstacleIndex, obstacles.Get<ObstacleMinColumn>(currIndex), obstacles.Get<ObstacleMaxColumn>(currIndex));
+			}
+
+			if (!needsRebuild)
+			{
+				return;
+			}
+		}
+
+		TDE2_ASSERT(obstacles.GetSize() == obstaclesContext.mComponentsCount);
+
+		mCollisionGrid.Reset(CollisionGridCellSize);
+		mObstaclesDamageables.clear();
+		mObstaclesIndices.assign(obstacles.GetSize(), InvalidObstacleIndex);
+
+		/// \note The mirror is walked chunk by chunk, only damageables of the obstacles are taken from the query, contacts read them
+		for (USIZE chunkIndex = 0, firstIndex = 0; chunkIndex < obstacles.GetChunksCount(); ++chunkIndex)
+		{
+			const TVector2* pMins = obstacles.GetColumn<ObstacleMinColumn>(chunkIndex);
+			const TVector2* pMaxs = obstacles.GetColumn<ObstacleMaxColumn>(chunkIndex);
+			const U32* pLifes = obstacles.GetColumn<ObstacleLifesColumn>(chunkIndex);
+			const TEntityId* pEntities = obstacles.GetColumn<ObstacleEntityColumn>(chunkIndex);
+			const TEntityHandle* pHandles = obstacles.GetColumn<ObstacleHandleColumn>(chunkIndex);
+
+			const USIZE elementsCount = obstacles.GetChunkElementsCount(chunkIndex);
+
+			for (USIZE i = 0; i < elementsCount; ++i)
+			{
+				if (!pLifes[i]) /// \note The entity is waiting for its destruction
+				{
+					continue;
+				}
+
+				TGridObstacle obstacle;
+				obstacle.mEntityId = pEntities[i];
+				obstacle.mEntityHandle = pHandles[i];
+				obstacle.mMin = pMins[i];
+				obstacle.mMax = pMaxs[i];
+
+				mObstaclesIndices[firstIndex + i] = mCollisionGrid.AddObstacle(obstacle);
+				mObstaclesDamageables.push_back(damageables[firstIndex + i]);
+			}
+
+			firstIndex += elementsCount;
+		}
+
+		mCollisionGrid.Build();
+	}
+
+	void CBallUpdateSystem::_moveBall(CTransform* pBallTransform, CBall* pBall, F32 dt)
+	{
+		const F32 radius = pBall->mRadius;
+
+		TVector3 position = pBallTransform->GetPosition();
+		F32 distance = pBall->mSpeed * dt;
+
+		TEntityHandle ballEntityHandle = TEntityHandle::Invalid; ///< Resolved on the first contact, most steps of a ball have none
+
+		for (U32 i = 0; i < MaxContactsPerStep && distance > 0.0f; i++)
+		{
+			const TVector2 origin(position.x, position.z);
+			const TVector2 displacement = distance * TVector2(pBall->mDirection.x, pBall->mDirection.z);
+
+			TSweptCircleHit hit;
+
+			if (!mCollisionGrid.SweepCircle(origin, displacement, radius, hit))
+			{
+				position = position + distance * pBall->mDirection;
+				distance = 0.0f;
+
+				break;
+			}
+
+			const TVector2 contactPoint = origin + hit.mTime * displacement + ContactOffset * hit.mNormal;
+
+			position.x = contactPoint.x;
+			position.z = contactPoint.y;
+
+			distance *= (1.0f - hit.mTime);
+
+			if (CMathUtils::Abs(hit.mNormal.x) > 0.0f)
+			{
+				pBall->mDirection.x = -pBall->mDirection.x;
+			}
+			else
+			{
+				pBall->mDirection.z = -pBall->mDirection.z;
+			}
+
+			pBall->mDirection = Normalize(pBall->mDirection);
+
+			if (TEntityHandle::Invalid == ballEntityHandle)
+			{
+				ballEntityHandle = CEntityHandlesTable::Get().Resolve(pBallTransform->GetOwnerId());
+			}
+
+			TBallCollisionEvent ballCollisionEvent;
+			ballCollisionEvent.mBallEntityId = pBallTransform->GetOwnerId();
+			ballCollisionEvent.mOtherEntityId = hit.mEntityId;
+			ballCollisionEvent.mBallEntityHandle = ballEntityHandle;
+			ballCollisionEvent.mOtherEntityHandle = hit.mEntityHandle;
+			ballCollisionEvent.mContactNormal = TVector3(hit.mNormal.x, 0.0f, hit.mNormal.y);
+
+			NotifyEvent(ballCollisionEvent);
+
+			if (!mObstaclesDamageables[hit.mObstacleIndex]->mLifes)
+			{
+				mCollisionGrid.DisableObstacle(hit.mObstacleIndex);
+			}
+
+			if (!pBall->mIsMoving)
+			{
+				break;
+			}
+		}
+
+		pBallTransform->SetPosition(position);
+	}
+
 
-	TDE2_API ISystem* CreateBallUpdateSystem(TPtr<IEventManager> pEventManager, TPtr<IDesktopInputContext> pInputContext, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateBallUpdateSystem(TPtr<IEventManager> pEventManager, TPtr<IDesktopInputContext> pInputContext, TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CBallUpdateSystem, result, pEventManager, pInputContext);
+		return CREATE_IMPL(ISystem, CBallUpdateSystem, result, pEventManager, pInputContext, pCommandBuffer);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "../../include/systems/CDamageablesUpdateSystem.h"
 #include "../../include/Components.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
+#include "../../include/CComponentsQueries.h"
+#include "../../include/CEventChannels.h"
 
 
 using namespace TDEngine2;
@@ -13,21 +16,38 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CDamageablesUpdateSystem::Init(TPtr<IEventManager> pEventManager)
+	E_RESULT_CODE CDamageablesUpdateSystem::Init(TPtr<IEventManager> pEventManager, TPtr<CCollisionsRouter> pCollisionsRouter, TPtr<CEntityCommandBuffer> pCommandBuffer)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pEventManager)
+		if (!pEventManager || !pCollisionsRouter || !pCommandBuffer)
 		{
 			return RC_INVALID_ARGS;
 		}
 
 		mpEventManager = pEventManager;
+		mpCollisionsRouter = pCollisionsRouter;
+		mpCommandBuffer = pCommandBuffer;
+		mCommandStreamId = pCommandBuffer->CreateStream();
 
-		pEventManager->Subscribe(TOn3DCollisionRegisteredEvent::GetTypeId(), this);
+		/// \note The ball's direction is already reflected by CBallUpdateSystem
+		E_RESULT_CODE result = pCollisionsRouter->RegisterHandler<CBall, CDamageable>([this](CBall*, CDamageable* pDamageable, const TCollisionContactInfo& contactInfo)
+		{
+			_applyDamage(contactInfo, pDamageable);
+		});
+
+		result = result | pCollisionsRouter->RegisterHandler<CProjectile, CDamageable>([this](CProjectile*, CDamageable* pDamageable, const TCollisionContactInfo& contactInfo)
+		{
+			_applyDamage(contactInfo, pDamageable);
+		});
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
 
 		mIsInitialized = true;
 
@@ -43,94 +63,72 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CDamageablesUpdateSystem::OnEvent(const TBaseEvent* pEvent)
+	TSystemAccessInfo CDamageablesUpdateSystem::GetAccessInfo() const
 	{
-		const TOn3DCollisionRegisteredEvent* pCollisionEvent = dynamic_cast<const TOn3DCollisionRegisteredEvent*>(pEvent);
-		if (!pCollisionEvent)
-		{
-			return RC_FAIL;
-		}
+		/// \note Update is empty, the accesses are the ones of CCollisionsRouter's handlers. They are run by the thread that dispatches
+		/// a contact, so the system is ordered against everyone else who touches damageables
+		return TSystemAccessInfo()
+			.Reads<CTransform>()
+			.Writes<CDamageable>()
+			.Writes<CGameInfo>()
+			.Handles<TOn3DCollisionRegisteredEvent>();
+	}
 
-		CEntity* pEntity0 = mpWorld->FindEntity(pCollisionEvent->mEntities[0]);
-		CEntity* pEntity1 = mpWorld->FindEntity(pCollisionEvent->mEntities[1]);
+	void CDamageablesUpdateSystem::_applyDamage(const TCollisionContactInfo& contactInfo, CDamageable* pDamageable)
+	{
+		const TEntityId damageableEntityId = contactInfo.mSecondEntityId;
 
-		if (!pEntity0 || !pEntity1 || TOn3DCollisionRegisteredEvent::E_COLLISION_EVENT_TYPE::ON_ENTER != pCollisionEvent->mType)
+		if (!pDamageable || !pDamageable->mLifes)
 		{
-			return RC_OK;
+			return;
 		}
 
-		CEntity* pDamageableEntity = pEntity0;
+		if (!pDamageable->mIsConstant)
+		{
+			pDamageable->mLifes--;
+			MarkComponentChanged<CDamageable>(damageableEntityId);
+		}
 
-		CDamageable* pDamageable = pDamageableEntity->GetComponent<CDamageable>();
-		if (!pDamageable)
+		if (pDamageable->mLifes)
 		{
-			pDamageable = pEntity1->GetComponent<CDamageable>();
-			pDamageableEntity = pEntity1;
+			return;
 		}
 
-		CBall* pBall = GetValidPtrOrDefault(pEntity0->GetComponent<CBall>(), pEntity1->GetComponent<CBall>());
-		CProjectile* pProjectile = GetValidPtrOrDefault(pEntity0->GetComponent<CProjectile>(), pEntity1->GetComponent<CProjectile>());
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(mpWorld);
 
-		if (pDamageable && (pBall || pProjectile) && pDamageable->mLifes > 0)
+		const F32 probabilityFactor = mRandomUtility.Get(0.0f, 1.0f);
+		if (probabilityFactor < pGameInfo->mBonusesSpawnCommonProbability)
 		{
-			if (pBall)
-			{
-				pBall->mDirection = Reflect(-pBall->mDirection, pCollisionEvent->mContactNormal);
-			}
+			TSpawnNewBonusEvent spawnEvent;
 
-			if (!pDamageable->mIsConstant)
+			if (auto pTransform = GetComponent<CTransform>(contactInfo.mSecondEntityHandle))
 			{
-				pDamageable->mLifes--;
-			}
-
-			if (!pDamageable->mLifes)
-			{
-				CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
-
-				const F32 probabilityFactor = mRandomUtility.Get(0.0f, 1.0f);
-				if (probabilityFactor < pGameInfo->mBonusesSpawnCommonProbability)
-				{
-					TSpawnNewBonusEvent spawnEvent;
+				spawnEvent.mPosition = pTransform->GetPosition();
+				spawnEvent.mSpawnerEntityId = damageableEntityId;
 
-					if (auto pTransform = pDamageableEntity->GetComponent<CTransform>())
-					{
-						spawnEvent.mPosition = pTransform->GetPosition();
-						spawnEvent.mSpawnerEntityId = pDamageableEntity->GetId();
-
-						LOG_MESSAGE(Wrench::StringUtils::Format("[CDamageablesUpdateSystem] A new power up is spawned at {0}", spawnEvent.mPosition.ToString()));
-					}
-
-					mpEventManager->Notify(&spawnEvent);
-				}
+				LOG_MESSAGE(Wrench::StringUtils::Format("[CDamageablesUpdateSystem] A new power up is spawned at {0}", spawnEvent.mPosition.ToString()));
+			}
 
-				/// \note Update the score
-				{
-					pGameInfo->mPlayerScore += pGameInfo->mScoreMultiplier * pDamageable->mRewardScore;
+			PostEvent(spawnEvent);
+		}
 
-					TScoreChangedEvent scoreChangedEvent;
-					scoreChangedEvent.mNewPlayerScore = pGameInfo->mPlayerScore;
+		/// \note Update the score
+		{
+			pGameInfo->mPlayerScore += pGameInfo->mScoreMultiplier * pDamageable->mRewardScore;
 
-					mpEventManager->Notify(&scoreChangedEvent);
-				}
+			TScoreChangedEvent scoreChangedEvent;
+			scoreChangedEvent.mNewPlayerScore = pGameInfo->mPlayerScore;
 
-				AddDefferedCommand([this, id = pDamageableEntity->GetId()]
-				{
-					mpWorld->Destroy(id);
-				});
-			}
+			PostEvent(scoreChangedEvent);
 		}
 
-		return RC_OK;
-	}
-
-	TEventListenerId CDamageablesUpdateSystem::GetListenerId() const
-	{
-		return TEventListenerId(GetTypeId());
+		mpCommandBuffer->Destroy(mCommandStreamId, damageableEntityId);
 	}
 
 
-	TDE2_API ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateDamageablesUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter,
+		TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CDamageablesUpdateSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CDamageablesUpdateSystem, result, pEventManager, pCollisionsRouter, pCommandBuffer);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "../../include/systems/CEntityCommandBufferSystem.h"
+#include "../../include/CEventChannels.h"
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	CEntityCommandBufferSystem::CEntityCommandBufferSystem() :
+		CBaseSystem()
+	{
+	}
+
+	E_RESULT_CODE CEntityCommandBufferSystem::Init(TPtr<CEntityCommandBuffer> pCommandBuffer)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (!pCommandBuffer)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpCommandBuffer = pCommandBuffer;
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	void CEntityCommandBufferSystem::InjectBindings(IWorld* pWorld)
+	{
+	}
+
+	void CEntityCommandBufferSystem::Update(IWorld* pWorld, F32 dt)
+	{
+		/// \note Posted events are handled before the playback, so their handlers still find destroyed entities
+		CEventChannels::Get().Flush();
+
+		if (mpCommandBuffer->IsEmpty())
+		{
+			return;
+		}
+
+		/// \note The system is exclusive, so nothing else is updated concurrently. A deferred command would be executed
+		/// once per frame, after all steps of a FIXED_STEP group
+		E_RESULT_CODE result = mpCommandBuffer->Playback();
+		TDE2_ASSERT(RC_OK == result);
+	}
+
+
+	TDE2_API ISystem* CreateEntityCommandBufferSystem(TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(ISystem, CEntityCommandBufferSystem, result, pCommandBuffer);
+	}
+}
\ No newline at end of file
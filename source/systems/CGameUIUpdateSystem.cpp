@@ -12,26 +12,55 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CGameUIUpdateSystem::Init(TPtr<IEventManager> pEventManager)
+	E_RESULT_CODE CGameUIUpdateSystem::Init(CSystemsGroup* pOwnerGroup)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pEventManager)
+		if (!pOwnerGroup)
 		{
 			return RC_INVALID_ARGS;
 		}
 
-		pEventManager->Subscribe(TScoreChangedEvent::GetTypeId(), this);
-		pEventManager->Subscribe(TLivesChangedEvent::GetTypeId(), this);
+		mpOwnerGroup = pOwnerGroup;
+
+		CEventChannels& eventChannels = CEventChannels::Get();
+
+		/// \note Posted events are delivered at sync points on the thread that updates groups, so the group's flag isn't guarded
+		mScoreChangedSubscriptionId = eventChannels.Subscribe<TScoreChangedEvent>([this](const TScoreChangedEvent& event)
+		{
+			mPlayerScore = event.mNewPlayerScore;
+			mIsScoreChanged = true;
+
+			mpOwnerGroup->RequestUpdate();
+		});
+
+		mLivesChangedSubscriptionId = eventChannels.Subscribe<TLivesChangedEvent>([this](const TLivesChangedEvent& event)
+		{
+			mPlayerLives = event.mPlayerLives;
+			mIsLivesChanged = true;
+
+			mpOwnerGroup->RequestUpdate();
+		});
 
 		mIsInitialized = true;
 
 		return RC_OK;
 	}
 
+	E_RESULT_CODE CGameUIUpdateSystem::_onFreeInternal()
+	{
+		CEventChannels& eventChannels = CEventChannels::Get();
+
+		E_RESULT_CODE result = RC_OK;
+		result = result | eventChannels.Unsubscribe<TScoreChangedEvent>(mScoreChangedSubscriptionId);
+		result = result | eventChannels.Unsubscribe<TLivesChangedEvent>(mLivesChangedSubscriptionId);
+
+		return result;
+	}
+
 	void CGameUIUpdateSystem::InjectBindings(IWorld* pWorld)
 	{
 		mpWorld = pWorld;
@@ -45,47 +74,39 @@ namespace Game
 
 	void CGameUIUpdateSystem::Update(IWorld* pWorld, F32 dt)
 	{
-	}
-
-	E_RESULT_CODE CGameUIUpdateSystem::OnEvent(const TBaseEvent* pEvent)
-	{
-		if (const TScoreChangedEvent* pScoreEvent = dynamic_cast<const TScoreChangedEvent*>(pEvent))
+		if (mIsScoreChanged)
 		{
-			if (auto pScoreEntity = mpWorld->FindEntity(mScoreLabelElementId))
-			{
-				if (auto pLabel = pScoreEntity->GetComponent<CLabel>())
-				{
-					pLabel->SetText(std::to_string(pScoreEvent->mNewPlayerScore));
-				}
-			}
-
-			return RC_OK;
+			_setLabelText(mScoreLabelElementId, std::to_string(mPlayerScore));
+			mIsScoreChanged = false;
 		}
 
-		if (const TLivesChangedEvent* pLivesEvent = dynamic_cast<const TLivesChangedEvent*>(pEvent))
+		if (mIsLivesChanged)
 		{
-			if (auto pLivesEntity = mpWorld->FindEntity(mLivesLabelElementId))
-			{
-				if (auto pLabel = pLivesEntity->GetComponent<CLabel>())
-				{
-					pLabel->SetText(std::to_string(pLivesEvent->mPlayerLives));
-				}
-			}
-
-			return RC_OK;
+			_setLabelText(mLivesLabelElementId, std::to_string(mPlayerLives));
+			mIsLivesChanged = false;
 		}
+	}
 
-		return RC_OK;
+	TSystemAccessInfo CGameUIUpdateSystem::GetAccessInfo() const
+	{
+		return TSystemAccessInfo()
+			.Writes<CLabel>();
 	}
 
-	TEventListenerId CGameUIUpdateSystem::GetListenerId() const
+	void CGameUIUpdateSystem::_setLabelText(TEntityId labelEntityId, const std::string& text)
 	{
-		return TEventListenerId(GetTypeId());
+		if (auto pLabelEntity = mpWorld->FindEntity(labelEntityId))
+		{
+			if (auto pLabel = pLabelEntity->GetComponent<CLabel>())
+			{
+				pLabel->SetText(text);
+			}
+		}
 	}
 
 
-	TDE2_API ISystem* CreateGameUIUpdateSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateGameUIUpdateSystem(CSystemsGroup* pOwnerGroup, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CGameUIUpdateSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CGameUIUpdateSystem, result, pOwnerGroup);
 	}
 }
\ No newline at end of file
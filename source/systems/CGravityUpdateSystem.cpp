@@ -1,6 +1,8 @@
 #include "../../include/systems/CGravityUpdateSystem.h"
 #include "../../include/Components.h"
 #include "../../include/components/CGravitable.h"
+#include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
 
 
 using namespace TDEngine2;
@@ -16,13 +18,22 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CGravityUpdateSystem::Init()
+	E_RESULT_CODE CGravityUpdateSystem::Init(TPtr<CEntitiesPool> pEntitiesPool, TPtr<CEntityCommandBuffer> pCommandBuffer)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
+		if (!pEntitiesPool || !pCommandBuffer)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpEntitiesPool = pEntitiesPool;
+		mpCommandBuffer = pCommandBuffer;
+		mCommandStreamId = pCommandBuffer->CreateStream();
+
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -30,23 +41,44 @@ namespace Game
 
 	void CGravityUpdateSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<CGravitable, CTransform>();
+		mpSystemContext = GetComponentsQuery<CGravitable, CTransform>(pWorld);
 	}
 
 	void CGravityUpdateSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& transforms = std::get<std::vector<CTransform*>>(mSystemContext.mComponentsSlice);
-		auto& gravitable = std::get<std::vector<CGravitable*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
+
+		auto& transforms = std::get<std::vector<CTransform*>>(systemContext.mComponentsSlice);
+		auto& gravitable = std::get<std::vector<CGravitable*>>(systemContext.mComponentsSlice);
+
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
-			transforms[i]->SetPosition(transforms[i]->GetPosition() + (dt * gravitable[i]->mMass) * mGravityDirection);
+			mpSystemContext->GetMutable<CTransform>(i)->SetPosition(transforms[i]->GetPosition() + (dt * gravitable[i]->mMass) * mGravityDirection);
+
+			/// \note Pooled entities that have fallen out of the level are returned back
+			const TEntityId entityId = transforms[i]->GetOwnerId();
+
+			if (pGameInfo && transforms[i]->GetPosition().z < pGameInfo->mVerticalConstraints.mLeft && mpEntitiesPool->IsPooled(entityId))
+			{
+				mpCommandBuffer->Destroy(mCommandStreamId, entityId);
+			}
 		}
 	}
 
+	TSystemAccessInfo CGravityUpdateSystem::GetAccessInfo() const
+	{
+		return TSystemAccessInfo()
+			.Reads<CGravitable>()
+			.Reads<CGameInfo>()
+			.Reads<CEntitiesPool>()
+			.Writes<CTransform>();
+	}
+
 
-	TDE2_API ISystem* CreateGravityUpdateSystem(E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateGravityUpdateSystem(TPtr<CEntitiesPool> pEntitiesPool, TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CGravityUpdateSystem, result);
+		return CREATE_IMPL(ISystem, CGravityUpdateSystem, result, pEntitiesPool, pCommandBuffer);
 	}
 }
\ No newline at end of file
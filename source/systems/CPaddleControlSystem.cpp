@@ -1,6 +1,7 @@
 #include "../../include/systems/CPaddleControlSystem.h"
 #include "../../include/Components.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
 
 
 using namespace TDEngine2;
@@ -8,25 +9,35 @@ using namespace TDEngine2;
 
 namespace Game
 {
+	static const std::string ProjectilePrefabId = "Projectile"; /// \todo Replace this with configurable id
+
+
 	CPaddleControlSystem::CPaddleControlSystem() :
 		CBaseSystem()
 	{
 	}
 
-	E_RESULT_CODE CPaddleControlSystem::Init(TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext, TPtr<ISceneManager> pSceneManager)
+	E_RESULT_CODE CPaddleControlSystem::Init(TDEngine2::TPtr<TDEngine2::IDesktopInputContext> pInputContext, TPtr<CEntitiesPool> pEntitiesPool)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pInputContext || !pSceneManager)
+		if (!pInputContext || !pEntitiesPool)
 		{
 			return RC_INVALID_ARGS;
 		}
 
 		mpInputContext = pInputContext;
-		mpSceneManager = pSceneManager;
+		mpEntitiesPool = pEntitiesPool;
+
+		/// \note Projectiles are fired and returned every few frames, so free ones are kept far below the level instead of being deactivated
+		E_RESULT_CODE result = mpEntitiesPool->SetParkingOffset(ProjectilePrefabId, TVector3(0.0f, -1000.0f, 0.0f));
+		if (RC_OK != result)
+		{
+			return result;
+		}
 
 		mIsInitialized = true;
 
@@ -35,41 +46,19 @@ namespace Game
 
 	void CPaddleControlSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<CPaddle, CTransform>();
+		mpSystemContext = GetComponentsQuery<CPaddle, CTransform>(pWorld);
 
-		mGameInfoEntityId = pWorld->FindEntityWithUniqueComponent<Game::CGameInfo>();
 	}
 
 
-	static void ProcessLaserShot(IWorld* pWorld, TPtr<ISceneManager> pSceneManager, CTransform* pPaddleTransform, CGameInfo* pGameInfo)
+	static void ProcessLaserShot(TPtr<CEntitiesPool> pEntitiesPool, CTransform* pPaddleTransform)
 	{
-		auto sceneResult = pSceneManager->GetScene(pGameInfo->mCurrLoadedGameId);
-		if (sceneResult.HasError())
-		{
-			TDE2_ASSERT(false);
-			return;
-		}
-
-		IScene* pScene = sceneResult.Get();
-		if (!pScene)
-		{
-			TDE2_ASSERT(false);
-			return;
-		}
-
-		auto& projectilesPool = pGameInfo->mpProjectilesPool;
-
 		const TVector3& pos = pPaddleTransform->GetPosition();
 
-		auto spawnProjectile = [&pos, pScene, &projectilesPool](float xOffset)
+		auto spawnProjectile = [&pos, pEntitiesPool](float xOffset)
 		{
-			if (CEntity* pProjectileEntity = projectilesPool.empty() ? pScene->Spawn("Projectile") : projectilesPool.front()) /// \todo Replace this with configurable id
+			if (CEntity* pProjectileEntity = pEntitiesPool->Acquire(ProjectilePrefabId))
 			{
-				if (!projectilesPool.empty())
-				{
-					projectilesPool.pop_front(); /// \note Remove the entity from the pool
-				}
-
 				if (CTransform* pTransform = pProjectileEntity->GetComponent<CTransform>())
 				{
 					pTransform->SetPosition(TVector3(pos.x + xOffset, pTransform->GetPosition().y, pos.z));
@@ -84,14 +73,15 @@ namespace Game
 
 	void CPaddleControlSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& transforms = std::get<std::vector<CTransform*>>(mSystemContext.mComponentsSlice);
-		auto& paddles = std::get<std::vector<CPaddle*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
+
+		auto& paddles = std::get<std::vector<CPaddle*>>(systemContext.mComponentsSlice);
 
-		CGameInfo* pGameInfo = pWorld->FindEntity(mGameInfoEntityId)->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; ++i)
+		for (USIZE i = 0; i < systemContext.mComponentsCount; ++i)
 		{
-			CTransform* pCurrTransform = transforms[i];
+			CTransform* pCurrTransform = mpSystemContext->GetMutable<CTransform>(i);
 			CPaddle* pCurrPaddle = paddles[i];
 
 			const TVector3 delta = pCurrTransform->GetRightVector() * (dt * pCurrPaddle->mSpeed);
@@ -124,14 +114,14 @@ namespace Game
 
 			if (pGameInfo->mIsLaserEnabled && (mpInputContext->IsKeyPressed(E_KEYCODES::KC_SPACE) || mpInputContext->IsMouseButtonPressed(0)))
 			{
-				ProcessLaserShot(pWorld, mpSceneManager, pCurrTransform, pGameInfo);
+				ProcessLaserShot(mpEntitiesPool, pCurrTransform);
 			}
 		}
 	}
 
 
-	TDE2_API ISystem* CreatePaddleControlSystem(TPtr<IDesktopInputContext> pInputContext, TPtr<ISceneManager> pSceneManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreatePaddleControlSystem(TPtr<IDesktopInputContext> pInputContext, TPtr<CEntitiesPool> pEntitiesPool, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CPaddleControlSystem, result, pInputContext, pSceneManager);
+		return CREATE_IMPL(ISystem, CPaddleControlSystem, result, pInputContext, pEntitiesPool);
 	}
 }
\ No newline at end of file
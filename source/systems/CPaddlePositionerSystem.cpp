@@ -33,13 +33,16 @@ namespace Game
 
 	void CPaddlePositionerSystem::InjectBindings(IWorld* pWorld)
 	{
-		mPaddlesContext = pWorld->CreateLocalComponentsSlice<Game::CPaddle, CTransform>();
-		mPositionersContext = pWorld->CreateLocalComponentsSlice<Game::CPlayerPositioner, CTransform>();
+		mpPaddlesContext = GetComponentsQuery<Game::CPaddle, CTransform>(pWorld);
+		mpPositionersContext = GetComponentsQuery<Game::CPlayerPositioner, CTransform>(pWorld);
 		mpWorld = pWorld;
 	}
 
 	void CPaddlePositionerSystem::Update(IWorld* pWorld, F32 dt)
 	{
+		const auto& paddlesContext = mpPaddlesContext->GetSlice();
+		const auto& positionersContext = mpPositionersContext->GetSlice();
+
 		if (!mIsDirty)
 		{
 			return;
@@ -47,8 +50,7 @@ namespace Game
 
 		mIsDirty = false;
 
-		auto& transforms = std::get<std::vector<CTransform*>>(mPaddlesContext.mComponentsSlice);
-		auto& positionerTransform = std::get<std::vector<CTransform*>>(mPositionersContext.mComponentsSlice);
+		auto& positionerTransform = std::get<std::vector<CTransform*>>(positionersContext.mComponentsSlice);
 
 		if (positionerTransform.empty())
 		{
@@ -57,12 +59,21 @@ namespace Game
 
 		const TVector3 paddlePosition = positionerTransform.front()->GetPosition();
 
-		for (USIZE i = 0; i < mPaddlesContext.mComponentsCount; i++)
+		for (USIZE i = 0; i < paddlesContext.mComponentsCount; i++)
 		{
-			transforms[i]->SetPosition(paddlePosition);
+			mpPaddlesContext->GetMutable<CTransform>(i)->SetPosition(paddlePosition);
 		}
 	}
 
+	TSystemAccessInfo CPaddlePositionerSystem::GetAccessInfo() const
+	{
+		return TSystemAccessInfo()
+			.Reads<CPaddle>()
+			.Reads<CPlayerPositioner>()
+			.Writes<CTransform>()
+			.Handles<TGameLevelLoadedEvent>();
+	}
+
 	E_RESULT_CODE CPaddlePositionerSystem::OnEvent(const TBaseEvent* pEvent)
 	{
 		mIsDirty = true;
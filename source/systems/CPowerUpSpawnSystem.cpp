@@ -1,6 +1,5 @@
 #include "../../include/systems/CPowerUpSpawnSystem.h"
 #include "../../include/Components.h"
-#include "../../include/components/CGameInfo.h"
 #include "../../include/components/Bonuses.h"
 #include "../../include/components/CBrick.h"
 #include <vector>
@@ -11,27 +10,46 @@ using namespace TDEngine2;
 
 namespace Game
 {
+	static const std::string PowerUpsTablePath = "ProjectResources/PowerUpsTable.asset";
+
+
 	CPowerUpSpawnSystem::CPowerUpSpawnSystem() :
 		CBaseSystem(), mRandomUtility(static_cast<int>(time(nullptr)))
 	{
 	}
 
-	E_RESULT_CODE CPowerUpSpawnSystem::Init(TPtr<IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager)
+	E_RESULT_CODE CPowerUpSpawnSystem::Init(TPtr<IEventManager> pEventManager, TPtr<IResourceManager> pResourceManager, TPtr<CEntitiesPool> pEntitiesPool)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pEventManager || !pSceneManager)
+		if (!pEventManager || !pResourceManager || !pEntitiesPool)
 		{
 			return RC_INVALID_ARGS;
 		}
 
 		mpEventManager = pEventManager;
-		mpSceneManager = pSceneManager;
+		mpEntitiesPool = pEntitiesPool;
+
+		mpPowerUpsTable = pResourceManager->GetResource<CPowerUpsTable>(pResourceManager->Load<CPowerUpsTable>(PowerUpsTablePath));
+		if (!mpPowerUpsTable)
+		{
+			LOG_WARNING(Wrench::StringUtils::Format("[CPowerUpSpawnSystem] The power ups table \"{0}\" wasn't loaded", PowerUpsTablePath));
+		}
+		else
+		{
+			for (const TPowerUpTableEntry& currEntry : mpPowerUpsTable->GetEntries())
+			{
+				pEntitiesPool->AddPrewarmRequest(currEntry.mPrefabId, currEntry.mPrewarmCount);
+			}
+		}
 
-		pEventManager->Subscribe(TSpawnNewBonusEvent::GetTypeId(), this);
+		mSpawnNewBonusSubscriptionId = CEventChannels::Get().Subscribe<TSpawnNewBonusEvent>([this](const TSpawnNewBonusEvent& spawnEvent)
+		{
+			_onSpawnNewBonus(spawnEvent);
+		});
 
 		mIsInitialized = true;
 
@@ -47,98 +65,66 @@ namespace Game
 	{
 	}
 
+	TSystemAccessInfo CPowerUpSpawnSystem::GetAccessInfo() const
+	{
+		/// \note Power ups are spawned by a handler of posted events which is invoked at sync points only
+		return TSystemAccessInfo();
+	}
 
-	struct TPowerUpConfigEntity
+	E_RESULT_CODE CPowerUpSpawnSystem::_onFreeInternal()
 	{
-		TypeId mPowerUpTypeId;
-		F32 mProbability;
-		std::string mPrefabId;
-	};
+		return CEventChannels::Get().Unsubscribe<TSpawnNewBonusEvent>(mSpawnNewBonusSubscriptionId);
+	}
 
 
-	E_RESULT_CODE CPowerUpSpawnSystem::OnEvent(const TBaseEvent* pEvent)
+	void CPowerUpSpawnSystem::_onSpawnNewBonus(const TSpawnNewBonusEvent& spawnEvent)
 	{
-		const TSpawnNewBonusEvent* pSpawnEvent = dynamic_cast<const TSpawnNewBonusEvent*>(pEvent);
-		if (!pSpawnEvent)
-		{
-			return RC_FAIL;
-		}
-
-		const TVector3& spawnPosition = pSpawnEvent->mPosition;
+		const TVector3& spawnPosition = spawnEvent.mPosition;
 		
-		/// \todo Replace with configurable YAML archive
-		/*static const std::vector<TPowerUpConfigEntity> PowerUpsTable
-		{
-			{ CScoreBonus::GetTypeId(),				0.15f, "PowerUp_AddScore" },
-			{ CScoreMultiplierBonus::GetTypeId(),	0.15f, "PowerUp_Score2X" },
-			{ CExpandPaddleBonus::GetTypeId(),		0.15f, "PowerUp_ExpandPaddle" },
-			{ CGodModeBonus::GetTypeId(),			0.15f, "PowerUp_GodMode" },
-			{ CStickyPaddleBonus::GetTypeId(),		0.15f, "PowerUp_StickyPaddle" },
-			{ CExtraLifeBonus::GetTypeId(),			0.15f, "PowerUp_ExtraLife" },
-			{ CLaserBonus::GetTypeId(),				0.15f, "PowerUp_Laser" },
-			{ CMultipleBallsBonus::GetTypeId(),		0.15f, "PowerUp_MultiplyBallsCount" },
-			{ CTransform::GetTypeId(),				1.0f, "PowerUp" }, /// \note The default one
-		};*/
-
-		CEntity* pEntity = mpWorld->FindEntity(pSpawnEvent->mSpawnerEntityId);
+		CEntity* pEntity = mpWorld->FindEntity(spawnEvent.mSpawnerEntityId);
 		if (!pEntity)
 		{
-			return RC_OK;
+			return;
 		}
 
 		CBrick* pBrick = pEntity->GetComponent<CBrick>();
 		if (!pBrick)
 		{
-			return RC_OK;
-		}
-
-		/// \todo Replace with utility function GetCurrLoadedScene()
-		CGameInfo* pGameInfo = mpWorld->FindEntity(mpWorld->FindEntityWithUniqueComponent<Game::CGameInfo>())->GetComponent<CGameInfo>();
-		if (!pGameInfo)
-		{
-			return RC_OK;
+			return;
 		}
 
-		auto sceneResult = mpSceneManager->GetScene(pGameInfo->mCurrLoadedGameId);
-		if (sceneResult.HasError())
+		if (mRandomUtility.Get(0.0f, 1.0f) < pBrick->mSpawnProbability)
 		{
-			TDE2_ASSERT(false);
-			return RC_OK;
+			return;
 		}
 
-		IScene* pScene = sceneResult.Get();
-		if (!pScene)
-		{
-			TDE2_ASSERT(false);
-			return RC_OK;
-		}
+		const TPowerUpTableEntry* pTableEntry = nullptr;
 
-		if (mRandomUtility.Get(0.0f, 1.0f) < pBrick->mSpawnProbability)
+		if (pBrick->mPowerUpPrefabId.empty())
 		{
-			return RC_OK;
+			pTableEntry = mpPowerUpsTable ? mpPowerUpsTable->Sample(mRandomUtility.Get(0.0f, 1.0f)) : nullptr;
+			if (!pTableEntry)
+			{
+				return;
+			}
 		}
 
 		/// \note Spawn
-		CEntity* pPowerUpEntity = pScene->Spawn(pBrick->mPowerUpPrefabId);
+		CEntity* pPowerUpEntity = mpEntitiesPool->Acquire(pTableEntry ? pTableEntry->mPrefabId : pBrick->mPowerUpPrefabId);
 		if (!pPowerUpEntity)
 		{
-			return RC_OK;
+			return;
 		}
 
+		TDE2_ASSERT(!pTableEntry || pPowerUpEntity->HasComponent(pTableEntry->mPowerUpTypeId));
+
 		CTransform* pPowerUpTransform = pPowerUpEntity->GetComponent<CTransform>();
 		pPowerUpTransform->SetPosition(spawnPosition);
-
-		return RC_OK;
-	}
-
-	TEventListenerId CPowerUpSpawnSystem::GetListenerId() const
-	{
-		return TEventListenerId(GetTypeId());
 	}
 
 
-	TDE2_API ISystem* CreatePowerUpSpawnSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, TDEngine2::TPtr<TDEngine2::ISceneManager> pSceneManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreatePowerUpSpawnSystem(TPtr<IEventManager> pEventManager, TPtr<IResourceManager> pResourceManager, TPtr<CEntitiesPool> pEntitiesPool, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CPowerUpSpawnSystem, result, pEventManager, pSceneManager);
+		return CREATE_IMPL(ISystem, CPowerUpSpawnSystem, result, pEventManager, pResourceManager, pEntitiesPool);
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "../../include/systems/CProjectilesPoolSystem.h"
 #include "../../include/components/CGameInfo.h"
+#include "../../include/CWorldSingletons.h"
 
 
 using namespace TDEngine2;
@@ -12,13 +13,21 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CProjectilesPoolSystem::Init()
+	E_RESULT_CODE CProjectilesPoolSystem::Init(TPtr<CEntityCommandBuffer> pCommandBuffer)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
+		if (!pCommandBuffer)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mpCommandBuffer = pCommandBuffer;
+		mCommandStreamId = pCommandBuffer->CreateStream();
+
 		mIsInitialized = true;
 
 		return RC_OK;
@@ -26,42 +35,43 @@ namespace Game
 
 	void CProjectilesPoolSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<CProjectile, CTransform>();
-		mGameInfoEntityId = pWorld->FindEntityWithUniqueComponent<Game::CGameInfo>();
+		mpSystemContext = GetComponentsQuery<CProjectile, CTransform>(pWorld);
 	}
 
 	void CProjectilesPoolSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& transforms = std::get<std::vector<CTransform*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
+
+		auto& transforms = std::get<std::vector<CTransform*>>(systemContext.mComponentsSlice);
 
-		CGameInfo* pGameInfo = pWorld->FindEntity(mGameInfoEntityId)->GetComponent<CGameInfo>();
+		CGameInfo* pGameInfo = GetSingleton<CGameInfo>(pWorld);
 		if (!pGameInfo)
 		{
 			TDE2_ASSERT(false);
 			return;
 		}
 
-		/// \note Not optimal solution but well enough for a proof of concept
-		auto& projectilesPool = pGameInfo->mpProjectilesPool;
-
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
 			if (transforms[i]->GetPosition().z > pGameInfo->mVerticalConstraints.mRight)
 			{
-				CEntity* pProjectileEntity = pWorld->FindEntity(transforms[i]->GetOwnerId());
-
-				auto it = std::find(projectilesPool.begin(), projectilesPool.end(), pProjectileEntity);
-				if (it == projectilesPool.end())
-				{
-					projectilesPool.push_back(pProjectileEntity); /// \note Return back to the pool if a projectile goes out of a level
-				}
+				/// \note Return back to the pool if a projectile goes out of a level
+				mpCommandBuffer->Destroy(mCommandStreamId, transforms[i]->GetOwnerId());
 			}
 		}
 	}
 
+	TSystemAccessInfo CProjectilesPoolSystem::GetAccessInfo() const
+	{
+		return TSystemAccessInfo()
+			.Reads<CProjectile>()
+			.Reads<CTransform>()
+			.Reads<CGameInfo>();
+	}
+
 
-	TDE2_API ISystem* CreateProjectilesPoolSystem(E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateProjectilesPoolSystem(TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CProjectilesPoolSystem, result);
+		return CREATE_IMPL(ISystem, CProjectilesPoolSystem, result, pCommandBuffer);
 	}
 }
\ No newline at end of file
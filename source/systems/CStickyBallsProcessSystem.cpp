@@ -15,19 +15,31 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CStickyBallsProcessSystem::Init(TPtr<IEventManager> pEventManager)
+	E_RESULT_CODE CStickyBallsProcessSystem::Init(TPtr<CCollisionsRouter> pCollisionsRouter, TPtr<CEntityCommandBuffer> pCommandBuffer)
 	{
 		if (mIsInitialized)
 		{
 			return RC_FAIL;
 		}
 
-		if (!pEventManager)
+		if (!pCollisionsRouter || !pCommandBuffer)
 		{
 			return RC_INVALID_ARGS;
 		}
 
-		pEventManager->Subscribe(TOn3DCollisionRegisteredEvent::GetTypeId(), this);
+		mpCollisionsRouter = pCollisionsRouter;
+		mpCommandBuffer = pCommandBuffer;
+		mCommandStreamId = pCommandBuffer->CreateStream();
+
+		E_RESULT_CODE result = pCollisionsRouter->RegisterHandler<CBall, CPaddle>([this](CBall* pBall, CPaddle* pPaddle, const TCollisionContactInfo& contactInfo)
+		{
+			_onBallHitPaddle(pBall, pPaddle, contactInfo);
+		});
+
+		if (RC_OK != result)
+		{
+			return result;
+		}
 
 		mIsInitialized = true;
 
@@ -43,76 +55,35 @@ namespace Game
 	{
 	}
 
-	E_RESULT_CODE CStickyBallsProcessSystem::OnEvent(const TBaseEvent* pEvent)
+	TSystemAccessInfo CStickyBallsProcessSystem::GetAccessInfo() const
 	{
-		const TOn3DCollisionRegisteredEvent* pCollisionEvent = dynamic_cast<const TOn3DCollisionRegisteredEvent*>(pEvent);
-		if (!pCollisionEvent)
-		{
-			return RC_FAIL;
-		}
-
-		CEntity* pEntity0 = mpWorld->FindEntity(pCollisionEvent->mEntities[0]);
-		CEntity* pEntity1 = mpWorld->FindEntity(pCollisionEvent->mEntities[1]);
-
-		if (!pEntity0 || !pEntity1 || 
-			TOn3DCollisionRegisteredEvent::E_COLLISION_EVENT_TYPE::ON_ENTER != pCollisionEvent->mType ||
-			CMathUtils::Abs(Dot(ForwardVector3, pCollisionEvent->mContactNormal)) < FloatEpsilon)
-		{
-			return RC_OK;
-		}
+		/// \note Update is empty, the accesses are the ones of CCollisionsRouter's handlers. They are run by the thread that dispatches
+		/// a contact, so the system is ordered against everyone else who touches balls and paddles
+		return TSystemAccessInfo()
+			.Writes<CBall>()
+			.Writes<CPaddle>()
+			.Handles<TOn3DCollisionRegisteredEvent>();
+	}
 
-		CPaddle* pPaddle = GetValidPtrOrDefault(pEntity0->GetComponent<CPaddle>(), pEntity1->GetComponent<CPaddle>());
-		if (!pPaddle || !pPaddle->mIsSticky)
+	void CStickyBallsProcessSystem::_onBallHitPaddle(CBall* pBall, CPaddle* pPaddle, const TCollisionContactInfo& contactInfo)
+	{
+		if (!pPaddle->mIsSticky || CMathUtils::Abs(Dot(ForwardVector3, contactInfo.mContactNormal)) < FloatEpsilon)
 		{
-			return RC_OK;
+			return;
 		}
 
 		pPaddle->mIsSticky = false;
 
-		CBall* pBall = pEntity0->GetComponent<CBall>();
-
-		CEntity* pBallEntity = pEntity0;
-		CEntity* pPaddleEntity = pEntity1;
-
-		if (!pBall) 
-		{
-			pBall = pEntity1->GetComponent<CBall>();
-
-			pBallEntity = pEntity1;
-			pPaddleEntity = pEntity0;
-		}
-
-		if (!pBall)
-		{
-			TDE2_UNREACHABLE();
-			return RC_OK;
-		}
-
+		/// \note The ball is already placed outside of the paddle by CBallUpdateSystem, so there is no need to push it away
 		pBall->mIsMoving = false;
 		pBall->mIsStuck = true;
 
-		if (CTransform* pBallTransform = pBallEntity->GetComponent<CTransform>())
-		{
-			/// \todo Fix this magic constant later, used to prevent additional physics event in next frame
-			pBallTransform->SetPosition(pBallTransform->GetPosition() + TVector3(0.0f, 0.0f, 0.05f)); 
-		}
-
-		AddDefferedCommand([this, pPaddleEntity, pBallEntity]
-		{
-			GroupEntities(mpWorld, pPaddleEntity->GetId(), pBallEntity->GetId());
-		});
-
-		return RC_OK;
-	}
-
-	TEventListenerId CStickyBallsProcessSystem::GetListenerId() const
-	{
-		return TEventListenerId(GetTypeId());
+		mpCommandBuffer->Reparent(mCommandStreamId, contactInfo.mSecondEntityId, contactInfo.mFirstEntityId);
 	}
 
 
-	TDE2_API ISystem* CreateStickyBallsProcessSystem(TDEngine2::TPtr<TDEngine2::IEventManager> pEventManager, E_RESULT_CODE& result)
+	TDE2_API ISystem* CreateStickyBallsProcessSystem(TDEngine2::TPtr<CCollisionsRouter> pCollisionsRouter, TDEngine2::TPtr<CEntityCommandBuffer> pCommandBuffer, E_RESULT_CODE& result)
 	{
-		return CREATE_IMPL(ISystem, CStickyBallsProcessSystem, result, pEventManager);
+		return CREATE_IMPL(ISystem, CStickyBallsProcessSystem, result, pCollisionsRouter, pCommandBuffer);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,442 @@
+#include "../../include/systems/CSystemsGroup.h"
+#include "../../include/CEventChannels.h"
+#include <algorithm>
+#include <cmath>
+
+
+using namespace TDEngine2;
+
+
+namespace Game
+{
+	static bool HasIntersection(const std::vector<TypeId>& left, const std::vector<TypeId>& right)
+	{
+		return std::find_first_of(left.cbegin(), left.cend(), right.cbegin(), right.cend()) != left.cend();
+	}
+
+
+	TSystemsGroupUpdateRate TSystemsGroupUpdateRate::EveryFrame()
+	{
+		return TSystemsGroupUpdateRate();
+	}
+
+	TSystemsGroupUpdateRate TSystemsGroupUpdateRate::FixedStep(F32 step, U32 maxStepsPerFrame)
+	{
+		TSystemsGroupUpdateRate updateRate;
+		updateRate.mType = E_SYSTEMS_GROUP_UPDATE_RATE::FIXED_STEP;
+		updateRate.mFixedStep = step;
+		updateRate.mMaxStepsPerFrame = maxStepsPerFrame;
+
+		return updateRate;
+	}
+
+	TSystemsGroupUpdateRate TSystemsGroupUpdateRate::EveryNFrames(U32 framesCount)
+	{
+		TSystemsGroupUpdateRate updateRate;
+		updateRate.mType = E_SYSTEMS_GROUP_UPDATE_RATE::EVERY_N_FRAMES;
+		updateRate.mFramesCount = framesCount;
+
+		return updateRate;
+	}
+
+	TSystemsGroupUpdateRate TSystemsGroupUpdateRate::OnDemand()
+	{
+		TSystemsGroupUpdateRate updateRate;
+		updateRate.mType = E_SYSTEMS_GROUP_UPDATE_RATE::ON_DEMAND;
+
+		return updateRate;
+	}
+
+
+	CSystemsGroup::CSystemsGroup() :
+		CBaseObject()
+	{
+	}
+
+	E_RESULT_CODE CSystemsGroup::Init(const std::string& name, E_SYSTEMS_SCHEDULING_MODE mode)
+	{
+		if (mIsInitialized)
+		{
+			return RC_FAIL;
+		}
+
+		if (name.empty())
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mName = name;
+		mSchedulingMode = mode;
+
+		mIsInitialized = true;
+
+		return RC_OK;
+	}
+
+	E_RESULT_CODE CSystemsGroup::AddSystem(ISystem* pSystem, const TSystemAccessInfo& accessInfo)
+	{
+		return _addSystemEntry(pSystem, accessInfo, false);
+	}
+
+	E_RESULT_CODE CSystemsGroup::AddExclusiveSystem(ISystem* pSystem)
+	{
+		return _addSystemEntry(pSystem, {}, true);
+	}
+
+	void CSystemsGroup::SetSchedulingMode(E_SYSTEMS_SCHEDULING_MODE mode)
+	{
+		mSchedulingMode = mode;
+	}
+
+	E_RESULT_CODE CSystemsGroup::SetUpdateRate(const TSystemsGroupUpdateRate& updateRate)
+	{
+		if (updateRate.mFixedStep <= 0.0f || !updateRate.mMaxStepsPerFrame || !updateRate.mFramesCount)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mUpdateRate = updateRate;
+
+		mAccumulatedTime = 0.0f;
+		mSkippedFramesCount = 0;
+
+		return RC_OK;
+	}
+
+	void CSystemsGroup::SetRunCondition(const TSystemsGroupRunCondition& condition)
+	{
+		mRunCondition = condition;
+	}
+
+	void CSystemsGroup::SetDeltaTimeOverride(F32 dt)
+	{
+		mDeltaTimeOverride = std::max(0.0f, dt);
+
+		mAccumulatedTime = 0.0f;
+		mSkippedFramesCount = 0;
+	}
+
+	void CSystemsGroup::RequestUpdate()
+	{
+		mIsUpdateRequested = true;
+	}
+
+	void CSystemsGroup::InjectBindings(IWorld* pWorld)
+	{
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->InjectBindings(pWorld);
+		}
+	}
+
+	E_RESULT_CODE CSystemsGroup::AddDefferedCommand(const TCommandFunctor& action)
+	{
+		if (!action)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mDefferedCommandsBuffer.push_back(action);
+
+		return RC_OK;
+	}
+
+	void CSystemsGroup::ExecuteDefferedCommands()
+	{
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->ExecuteDefferedCommands();
+		}
+
+		for (const TCommandFunctor& currCommand : mDefferedCommandsBuffer)
+		{
+			currCommand();
+		}
+
+		mDefferedCommandsBuffer.clear();
+	}
+
+	void CSystemsGroup::OnInit(TPtr<IJobManager> pJobManager)
+	{
+		mpJobManager = pJobManager;
+
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->OnInit(pJobManager);
+		}
+	}
+
+	void CSystemsGroup::Update(IWorld* pWorld, F32 dt)
+	{
+		if (mRunCondition && !mRunCondition(pWorld))
+		{
+			return;
+		}
+
+		const bool hasDeltaTimeOverride = mDeltaTimeOverride > 0.0f;
+
+		if (hasDeltaTimeOverride)
+		{
+			dt = mDeltaTimeOverride;
+		}
+
+		switch (mUpdateRate.mType)
+		{
+			case E_SYSTEMS_GROUP_UPDATE_RATE::EVERY_FRAME:
+				_updateSystems(pWorld, dt);
+				break;
+
+			case E_SYSTEMS_GROUP_UPDATE_RATE::FIXED_STEP:
+			{
+				if (hasDeltaTimeOverride)
+				{
+					_updateSystems(pWorld, dt);
+					break;
+				}
+
+				const F32 step = mUpdateRate.mFixedStep;
+
+				mAccumulatedTime += dt;
+
+				U32 stepsCount = 0;
+
+				while (mAccumulatedTime >= step && stepsCount < mUpdateRate.mMaxStepsPerFrame)
+				{
+					_updateSystems(pWorld, step);
+
+					mAccumulatedTime -= step;
+					++stepsCount;
+				}
+
+				/// \note Only a fraction of the step is kept, the rest of the frame was too long to be simulated
+				mAccumulatedTime = std::fmod(mAccumulatedTime, step);
+				break;
+			}
+
+			case E_SYSTEMS_GROUP_UPDATE_RATE::EVERY_N_FRAMES:
+				mAccumulatedTime += dt;
+
+				if (++mSkippedFramesCount < mUpdateRate.mFramesCount)
+				{
+					break;
+				}
+
+				_updateSystems(pWorld, mAccumulatedTime);
+
+				mAccumulatedTime = 0.0f;
+				mSkippedFramesCount = 0;
+				break;
+
+			case E_SYSTEMS_GROUP_UPDATE_RATE::ON_DEMAND:
+				if (!mIsUpdateRequested)
+				{
+					break;
+				}
+
+				mIsUpdateRequested = false;
+
+				_updateSystems(pWorld, dt);
+				break;
+		}
+	}
+
+	void CSystemsGroup::_updateSystems(IWorld* pWorld, F32 dt)
+	{
+		if (E_SYSTEMS_SCHEDULING_MODE::SEQUENTIAL == mSchedulingMode || !mpJobManager)
+		{
+			for (TSystemEntry& currEntry : mSystems)
+			{
+				if (currEntry.mpSystem->IsActive())
+				{
+					currEntry.mpSystem->Update(pWorld, dt);
+					CEventChannels::Get().Flush();
+				}
+			}
+
+			return;
+		}
+
+		for (const TSystemsWave& currWave : mWaves)
+		{
+			_updateWave(currWave, pWorld, dt);
+
+			/// \note Workers are idle here, so handlers of posted events could touch anything
+			CEventChannels::Get().Flush();
+		}
+	}
+
+#if TDE2_EDITORS_ENABLED
+
+	void CSystemsGroup::DebugOutput(IDebugUtility* pDebugUtility, F32 dt) const
+	{
+		for (const TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->DebugOutput(pDebugUtility, dt);
+		}
+	}
+
+#endif
+
+	void CSystemsGroup::OnDestroy()
+	{
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->OnDestroy();
+		}
+	}
+
+	void CSystemsGroup::OnActivated()
+	{
+		mIsActive = true;
+
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->OnActivated();
+		}
+	}
+
+	void CSystemsGroup::OnDeactivated()
+	{
+		mIsActive = false;
+
+		for (TSystemEntry& currEntry : mSystems)
+		{
+			currEntry.mpSystem->OnDeactivated();
+		}
+	}
+
+	bool CSystemsGroup::IsActive() const
+	{
+		return mIsActive;
+	}
+
+	const std::string& CSystemsGroup::GetName() const
+	{
+		return mName;
+	}
+
+	TypeId CSystemsGroup::GetSystemType() const
+	{
+		return CSystemsGroup::GetTypeId();
+	}
+
+	E_RESULT_CODE CSystemsGroup::_addSystemEntry(ISystem* pSystem, const TSystemAccessInfo& accessInfo, bool isExclusive)
+	{
+		if (!pSystem)
+		{
+			return RC_INVALID_ARGS;
+		}
+
+		mSystems.push_back({ TPtr<ISystem>(pSystem), accessInfo, isExclusive });
+
+		_buildWaves();
+
+		return RC_OK;
+	}
+
+	void CSystemsGroup::_buildWaves()
+	{
+		mWaves.clear();
+
+		std::vector<U32> systemsWaves(mSystems.size(), 0);
+
+		for (U32 i = 0; i < static_cast<U32>(mSystems.size()); i++)
+		{
+			U32 waveIndex = 0;
+
+			/// \note The system goes right after the latest earlier one it depends on, so conflicting systems keep their order
+			for (U32 j = 0; j < i; j++)
+			{
+				if (_hasConflict(mSystems[j], mSystems[i]))
+				{
+					waveIndex = std::max(waveIndex, systemsWaves[j] + 1);
+				}
+			}
+
+			systemsWaves[i] = waveIndex;
+
+			if (waveIndex >= mWaves.size())
+			{
+				mWaves.resize(waveIndex + 1);
+			}
+
+			mWaves[waveIndex].push_back(i);
+		}
+	}
+
+	void CSystemsGroup::_updateWave(const TSystemsWave& wave, IWorld* pWorld, F32 dt)
+	{
+		ISystem* pInlineSystem = nullptr;
+
+		TJobCounter counter { TJobCounterId(0) };
+
+		for (const U32 currSystemIndex : wave)
+		{
+			ISystem* pSystem = mSystems[currSystemIndex].mpSystem.Get();
+			if (!pSystem->IsActive())
+			{
+				continue;
+			}
+
+			/// \note The first system of a wave is updated by the calling thread, it would wait for the rest anyway
+			if (!pInlineSystem)
+			{
+				pInlineSystem = pSystem;
+				continue;
+			}
+
+			const E_RESULT_CODE result = mpJobManager->SubmitJob(&counter, [pSystem, pWorld, dt](const TJobArgs&)
+			{
+				pSystem->Update(pWorld, dt);
+			}, { E_JOB_PRIORITY_TYPE::HIGH, false, pSystem->GetName().c_str() });
+
+			if (RC_OK != result)
+			{
+				pSystem->Update(pWorld, dt);
+			}
+		}
+
+		if (!pInlineSystem)
+		{
+			return;
+		}
+
+		pInlineSystem->Update(pWorld, dt);
+
+		mpJobManager->WaitForJobCounter(counter);
+	}
+
+	bool CSystemsGroup::_hasConflict(const TSystemEntry& left, const TSystemEntry& right)
+	{
+		if (left.mIsExclusive || right.mIsExclusive)
+		{
+			return true;
+		}
+
+		const TSystemAccessInfo& leftAccess = left.mAccessInfo;
+		const TSystemAccessInfo& rightAccess = right.mAccessInfo;
+
+		if (HasIntersection(leftAccess.mWrites, rightAccess.mWrites) ||
+			HasIntersection(leftAccess.mWrites, rightAccess.mReads) ||
+			HasIntersection(leftAccess.mReads, rightAccess.mWrites))
+		{
+			return true;
+		}
+
+		/// \note A handler of an event is executed by the thread of its emitter
+		if (HasIntersection(leftAccess.mEmittedEvents, rightAccess.mHandledEvents) ||
+			HasIntersection(leftAccess.mHandledEvents, rightAccess.mEmittedEvents))
+		{
+			return true;
+		}
+
+		/// \note IEventManager doesn't synchronize dispatching, so emitters are never run together
+		return !leftAccess.mEmittedEvents.empty() && !rightAccess.mEmittedEvents.empty();
+	}
+
+
+	TDE2_API CSystemsGroup* CreateSystemsGroup(const std::string& name, E_SYSTEMS_SCHEDULING_MODE mode, E_RESULT_CODE& result)
+	{
+		return CREATE_IMPL(CSystemsGroup, CSystemsGroup, result, name, mode);
+	}
+}
\ No newline at end of file
@@ -36,7 +36,7 @@ namespace Game
 
 	void CCreditsMenuLogicSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<Game::CCreditsMenuPanel>();
+		mpSystemContext = GetComponentsQuery<Game::CCreditsMenuPanel>(pWorld);
 	}
 
 
@@ -55,9 +55,11 @@ namespace Game
 
 	void CCreditsMenuLogicSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& panels = std::get<std::vector<CCreditsMenuPanel*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		auto& panels = std::get<std::vector<CCreditsMenuPanel*>>(systemContext.mComponentsSlice);
+
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
 			ProcessCreditsMenuInput(pWorld, panels[i], mpEventManager, mpGameModesManager);
 		}
@@ -36,7 +36,7 @@ namespace Game
 
 	void CMainMenuLogicSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<Game::CMainMenuPanel>();
+		mpSystemContext = GetComponentsQuery<Game::CMainMenuPanel>(pWorld);
 	}
 
 
@@ -94,9 +94,11 @@ namespace Game
 
 	void CMainMenuLogicSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& panels = std::get<std::vector<CMainMenuPanel*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		auto& panels = std::get<std::vector<CMainMenuPanel*>>(systemContext.mComponentsSlice);
+
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
 			ProcessMainMenuInput(this, pWorld, panels[i], mpEventManager);
 		}
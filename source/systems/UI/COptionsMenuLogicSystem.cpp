@@ -36,7 +36,7 @@ namespace Game
 
 	void COptionsMenuLogicSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<Game::COptionsMenuPanel>();
+		mpSystemContext = GetComponentsQuery<Game::COptionsMenuPanel>(pWorld);
 	}
 
 
@@ -55,9 +55,11 @@ namespace Game
 
 	void COptionsMenuLogicSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& panels = std::get<std::vector<COptionsMenuPanel*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		auto& panels = std::get<std::vector<COptionsMenuPanel*>>(systemContext.mComponentsSlice);
+
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
 			ProcessOptionsMenuInput(pWorld, panels[i], mpEventManager, mpGameModesManager);
 		}
@@ -36,7 +36,7 @@ namespace Game
 
 	void CPauseMenuLogicSystem::InjectBindings(IWorld* pWorld)
 	{
-		mSystemContext = pWorld->CreateLocalComponentsSlice<Game::CPauseMenuPanel>();
+		mpSystemContext = GetComponentsQuery<Game::CPauseMenuPanel>(pWorld);
 	}
 
 
@@ -76,9 +76,11 @@ namespace Game
 
 	void CPauseMenuLogicSystem::Update(IWorld* pWorld, F32 dt)
 	{
-		auto& panels = std::get<std::vector<CPauseMenuPanel*>>(mSystemContext.mComponentsSlice);
+		const auto& systemContext = mpSystemContext->GetSlice();
 
-		for (USIZE i = 0; i < mSystemContext.mComponentsCount; i++)
+		auto& panels = std::get<std::vector<CPauseMenuPanel*>>(systemContext.mComponentsSlice);
+
+		for (USIZE i = 0; i < systemContext.mComponentsCount; i++)
 		{
 			ProcessPauseMenuInput(pWorld, panels[i], mpEventManager);
 		}
@@ -0,0 +1,50 @@
+#include "../../include/CCollisionGrid2D.h"
+#include <TDEngine2.h>
+
+
+#if TDE2_EDITORS_ENABLED
+
+using namespace TDEngine2;
+using namespace Game;
+
+
+TDE2_TEST_FIXTURE("CollisionGrid2DTests")
+{
+	TDE2_TEST_CASE("TestSweepCircle_PaddleMovesIntoBall_ContactAtStartWithLeastPenetrationNormal")
+	{
+		pTestCase->ExecuteAction([]
+		{
+			const TEntityId paddleEntityId = static_cast<TEntityId>(1);
+
+			const TVector2 ballPosition(3.0f, 0.0f);
+			const F32 ballRadius = 0.25f;
+
+			CCollisionGrid2D grid;
+			grid.Reset(1.0f);
+
+			TGridObstacle paddle;
+			paddle.mEntityId = paddleEntityId;
+			paddle.mMin = TVector2(-1.0f, -0.25f);
+			paddle.mMax = TVector2(0.9f, 0.25f);
+
+			const U32 paddleIndex = grid.AddObstacle(paddle);
+			grid.Build();
+
+			/// \note The paddle moves right and overlaps the slow ball by 0.15 along X and by 0.5 along Y
+			grid.UpdateObstacle(paddleIndex, TVector2(1.0f, -0.25f), TVector2(2.9f, 0.25f));
+
+			TSweptCircleHit hit;
+
+			TDE2_TEST_IS_TRUE(grid.SweepCircle(ballPosition, TVector2(-0.01f, 0.0f), ballRadius, hit));
+			TDE2_TEST_IS_TRUE(paddleEntityId == hit.mEntityId);
+			TDE2_TEST_IS_TRUE(0.0f == hit.mTime);
+			TDE2_TEST_IS_TRUE(1.0f == hit.mNormal.x && 0.0f == hit.mNormal.y);
+
+			/// \note The ball which is resting or already moves away is left to leave the paddle
+			TDE2_TEST_IS_TRUE(!grid.SweepCircle(ballPosition, TVector2(0.0f, 0.0f), ballRadius, hit));
+			TDE2_TEST_IS_TRUE(!grid.SweepCircle(ballPosition, TVector2(0.01f, 0.0f), ballRadius, hit));
+		});
+	}
+}
+
+#endif
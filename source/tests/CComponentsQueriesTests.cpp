@@ -0,0 +1,120 @@
+#include "../../include/CComponentsQueries.h"
+#include "../../include/CChunkedSoAStore.h"
+#include "../../include/Components.h"
+#include "../../include/components/CDamageable.h"
+#include <TDEngine2.h>
+
+
+#if TDE2_EDITORS_ENABLED
+
+using namespace TDEngine2;
+using namespace Game;
+
+
+TDE2_TEST_FIXTURE("ComponentsQueriesTests")
+{
+	TDE2_TEST_CASE("TestGetSlice_AppendObstacleAfterFirstRead_ChangesStructureVersion")
+	{
+		pTestCase->ExecuteAction([]
+		{
+			TPtr<IWorld> pWorld = CTestContext::Get()->GetEngineCore()->GetSubsystem<ISceneManager>()->GetWorld();
+
+			auto pQuery = GetComponentsQuery<CDamageable, CTransform>(pWorld.Get());
+
+			CEntity* pFirstEntity = pWorld->CreateEntity();
+			pFirstEntity->AddComponent<CDamageable>();
+
+			const USIZE initialCount = pQuery->GetSlice().mComponentsCount;
+			const U32 lastSeenVersion = AdvanceWorldVersion();
+
+			/// \note The query is already built, so the obstacle is appended incrementally as a spawned brick is
+			CEntity* pSecondEntity = pWorld->CreateEntity();
+			pSecondEntity->AddComponent<CDamageable>();
+
+			const auto& slice = pQuery->GetSlice();
+
+			TDE2_TEST_IS_TRUE(initialCount + 1 == slice.mComponentsCount);
+			TDE2_TEST_IS_TRUE(pQuery->GetStructureVersion() >= lastSeenVersion);
+			TDE2_TEST_IS_TRUE(pQuery->HasChangedSince(slice.mComponentsCount - 1, lastSeenVersion));
+
+			pWorld->Destroy(pFirstEntity->GetId());
+			pWorld->Destroy(pSecondEntity->GetId());
+		});
+	}
+
+	TDE2_TEST_CASE("TestChunkedSoAStore_SwapRemoveFromFirstChunk_MovesLastElementOfSecondChunk")
+	{
+		pTestCase->ExecuteAction([]
+		{
+			typedef TChunkedSoAStore<U32, F32> TStore;
+
+			TStore store;
+
+			for (U32 i = 0; i < static_cast<U32>(TStore::mElementsPerChunk) + 2; i++)
+			{
+				const USIZE index = store.Append();
+
+				store.Get<0>(index) = i;
+				store.Get<1>(index) = static_cast<F32>(i);
+			}
+
+			TDE2_TEST_IS_TRUE(2 == store.GetChunksCount());
+			TDE2_TEST_IS_TRUE(2 == store.GetChunkElementsCount(1));
+
+			const U32 lastValue = store.Get<0>(store.GetSize() - 1);
+
+			store.SwapRemove(0);
+
+			TDE2_TEST_IS_TRUE(TStore::mElementsPerChunk + 1 == store.GetSize());
+			TDE2_TEST_IS_TRUE(lastValue == store.GetColumn<0>(0)[0]);
+			TDE2_TEST_IS_TRUE(static_cast<F32>(lastValue) == store.GetColumn<1>(0)[0]);
+			TDE2_TEST_IS_TRUE(1 == store.GetChunkElementsCount(1));
+		});
+	}
+
+	TDE2_TEST_CASE("TestChunkedQueryMirror_DestroyEntity_StoreFollowsQueryOrder")
+	{
+		pTestCase->ExecuteAction([]
+		{
+			typedef TCachedComponentsQuery<CDamageable, CTransform> TQuery;
+
+			TPtr<IWorld> pWorld = CTestContext::Get()->GetEngineCore()->GetSubsystem<ISceneManager>()->GetWorld();
+
+			TChunkedQueryMirror<TQuery, TEntityId> mirror;
+			mirror.Bind(GetComponentsQuery<CDamageable, CTransform>(pWorld.Get()));
+
+			auto copyEntityId = [&pWorld](USIZE index, TEntityId& entityId)
+			{
+				const auto& slice = GetComponentsQuery<CDamageable, CTransform>(pWorld.Get())->GetSlice();
+				entityId = std::get<std::vector<CTransform*>>(slice.mComponentsSlice)[index]->GetOwnerId();
+			};
+
+			CEntity* pFirstEntity = pWorld->CreateEntity();
+			pFirstEntity->AddComponent<CDamageable>();
+
+			CEntity* pSecondEntity = pWorld->CreateEntity();
+			pSecondEntity->AddComponent<CDamageable>();
+
+			mirror.Sync(copyEntityId);
+
+			/// \note The first entity is swap-removed from the query, the mirror should replay it without copying of all elements
+			pWorld->Destroy(pFirstEntity->GetId());
+
+			TDE2_TEST_IS_TRUE(mirror.Sync(copyEntityId));
+
+			const auto& slice = GetComponentsQuery<CDamageable, CTransform>(pWorld.Get())->GetSlice();
+			const auto& transforms = std::get<std::vector<CTransform*>>(slice.mComponentsSlice);
+
+			TDE2_TEST_IS_TRUE(slice.mComponentsCount == mirror.GetStore().GetSize());
+
+			for (USIZE i = 0; i < slice.mComponentsCount; i++)
+			{
+				TDE2_TEST_IS_TRUE(transforms[i]->GetOwnerId() == mirror.GetStore().Get<0>(i));
+			}
+
+			pWorld->Destroy(pSecondEntity->GetId());
+		});
+	}
+}
+
+#endif